@@ -0,0 +1,119 @@
+/**
+ * @file ldpc_batch.h
+ * @brief Multi-frame LDPC decoder with frames interleaved across SIMD lanes.
+ *
+ * Decodes up to `lanes` frames that share the same parity-check matrix in
+ * one pass over the Tanner graph. Every per-edge and per-variable quantity
+ * is stored lane-interleaved:
+ *
+ *      msg[e * lanes + l]   : message on edge e for frame l
+ *
+ * so each inner loop of the check- and variable-node updates is a
+ * contiguous run of `lanes` floats, which the compiler turns into
+ * SSE/AVX2/AVX-512/NEON vector instructions. All lanes follow the same
+ * edge schedule over the CSR/CSC lists of a shared ldpc_decoder_t.
+ *
+ * Runtime CPU dispatch:
+ *   - On x86-64 (GCC/Clang), AVX-512F, AVX2 and baseline SSE2 versions of
+ *     the iteration kernel are compiled, and the widest one supported by
+ *     the running CPU is selected in ldpc_batch_create().
+ *   - On other targets the baseline build is used (NEON on AArch64).
+ *
+ * Early termination is tracked per lane: a frame whose hard decision
+ * satisfies all parity checks is written out and masked, and the batch
+ * stops as soon as every lane has converged.
+ *
+ * Messages are single-precision floats. For integer (int8/int16) message
+ * storage see ldpc_fixed.h.
+ */
+
+#ifndef LDPC_BATCH_H
+#define LDPC_BATCH_H
+
+#include "ldpc_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LDPC_BATCH_MAX_LANES 32
+
+typedef struct ldpc_batch ldpc_batch_t;
+
+/* Iteration kernel: one CN + VN sweep over all lanes (selected at create) */
+typedef void (*ldpc_batch_iter_fn)(ldpc_batch_t *b);
+
+struct ldpc_batch {
+  const ldpc_decoder_t *graph; /* borrowed: edge lists, M, N, K, E */
+  int lanes;                   /* frames per batch: 8, 16 or 32   */
+
+  ldpc_kernel_t kernel; /* check-node kernel (default: SPA) */
+  float alpha;          /* NMS scaling factor               */
+  float beta;           /* OMS offset                       */
+
+  float *llr;            /* [N][lanes] channel LLRs            */
+  float *v2c;            /* [E][lanes] V→C messages            */
+  float *c2v;            /* [E][lanes] C→V messages            */
+  unsigned char *hard;   /* [N][lanes] tentative hard decision */
+  int unsat[LDPC_BATCH_MAX_LANES]; /* unsatisfied checks per lane */
+
+  ldpc_batch_iter_fn iterate; /* dispatched iteration kernel       */
+  const char *isa;            /* "avx512f", "avx2" or "generic"    */
+};
+
+/**
+ * @brief Create a batch decoder over the Tanner graph of `graph`.
+ *
+ * @param graph  Decoder context whose edge lists are shared (borrowed;
+ *               must outlive the batch decoder). Its kernel setting is
+ *               copied as the initial batch kernel.
+ * @param lanes  Frames per batch: 8, 16 or 32
+ *
+ * @return New batch decoder, or NULL on invalid lanes / allocation failure.
+ */
+ldpc_batch_t *ldpc_batch_create(const ldpc_decoder_t *graph, int lanes);
+
+/**
+ * @brief Release a batch decoder. NULL is a no-op.
+ */
+void ldpc_batch_destroy(ldpc_batch_t *b);
+
+/**
+ * @brief Select the check-node kernel; same semantics as
+ *        ldpc_decoder_set_kernel().
+ *
+ * @return 0 on success, -1 if kernel or param is out of range.
+ */
+int ldpc_batch_set_kernel(ldpc_batch_t *b, ldpc_kernel_t kernel,
+                          double param);
+
+/**
+ * @brief Decode up to b->lanes frames in parallel.
+ *
+ * @param b        Batch decoder
+ * @param LLR      Channel LLRs, frame-major: frame f at LLR[f*N .. f*N+N-1]
+ * @param nframes  Number of frames (1 .. b->lanes)
+ * @param ecc      Output codewords, frame-major (nframes × N)
+ * @param inf      Output information bits, frame-major (nframes × K)
+ * @param status   Optional per-frame status (LDPC_DECODE_OK or
+ *                 LDPC_DECODE_MAX_ITER); may be NULL
+ * @param max_iter Maximum number of iterations
+ *
+ * @return Number of frames whose final hard decision satisfies H·c^T = 0,
+ *         or -1 if nframes is out of range.
+ */
+int ldpc_batch_decode(ldpc_batch_t *b, const double *LLR, int nframes,
+                      int *ecc, int *inf, int *status, int max_iter);
+
+/**
+ * @brief ldpc_batch_decode() for single-precision LLRs (e.g. ldpc_demap()
+ *        output), loaded without conversion.
+ */
+int ldpc_batch_decode_float(ldpc_batch_t *b, const float *LLR, int nframes,
+                            int *ecc, int *inf, int *status, int max_iter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_BATCH_H */
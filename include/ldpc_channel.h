@@ -0,0 +1,105 @@
+/**
+ * @file ldpc_channel.h
+ * @brief Simulation channel: xoshiro256** RNG, Ziggurat Gaussian and
+ *        block BPSK / AWGN / LLR generation.
+ *
+ * RNG: xoshiro256** (Blackman–Vigna), 256-bit state seeded through
+ * SplitMix64. One generator per stream / thread; all functions are
+ * reentrant.
+ *
+ * Gaussian: Ziggurat with 128 layers (Marsaglia–Tsang, in Doornik's
+ * ZIGNOR form). One 64-bit draw per sample in ~99% of the cases: 7 bits
+ * pick the layer, 53 bits the abscissa, and the sample is a table
+ * multiply. Only the wedges and the tail beyond R = 3.4426 evaluate exp /
+ * log. The tables are built once, thread-safely.
+ *
+ * Channel: BPSK with the library's mapping (bit 1 → +1, bit 0 → −1) over
+ * real AWGN of variance σ². The block functions draw a whole frame (or a
+ * batch of frames laid out back to back) of noise and then form the
+ * received samples / LLRs = 2y/σ² in a single vectorisable pass.
+ */
+
+#ifndef LDPC_CHANNEL_H
+#define LDPC_CHANNEL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ *  RNG
+ * ============================================================================
+ */
+typedef struct {
+  uint64_t s[4];
+} ldpc_rng_t;
+
+/**
+ * @brief Seed a generator (any seed; SplitMix64 expansion of the state).
+ */
+void ldpc_rng_seed(ldpc_rng_t *r, uint64_t seed);
+
+/**
+ * @brief Next 64 random bits.
+ */
+uint64_t ldpc_rng_next(ldpc_rng_t *r);
+
+/**
+ * @brief Uniform double in the open interval (0, 1).
+ */
+double ldpc_rng_uniform(ldpc_rng_t *r);
+
+/**
+ * @brief Standard normal sample (Ziggurat).
+ */
+double ldpc_rng_gauss(ldpc_rng_t *r);
+
+/**
+ * @brief Fill out[0 .. n−1] with standard normal samples.
+ */
+void ldpc_rng_gauss_fill(ldpc_rng_t *r, double *out, int n);
+
+/**
+ * @brief Fill bits[0 .. n−1] with uniform 0/1 values (64 bits per draw).
+ */
+void ldpc_rng_bits(ldpc_rng_t *r, int *bits, int n);
+
+/* ============================================================================
+ *  BPSK over AWGN
+ * ============================================================================
+ */
+typedef struct {
+  double sigma2;    /* noise variance σ²       */
+  double sigma;     /* σ                       */
+  double llr_scale; /* 2 / σ²                  */
+} ldpc_awgn_t;
+
+/**
+ * @brief Noise variance for Eb/N0 (dB) and code rate R with unit-energy
+ *        BPSK: σ² = 1 / (2 R Eb/N0).
+ */
+double ldpc_awgn_sigma2(double EbN0_dB, double R);
+
+/**
+ * @brief Set up a channel of noise variance sigma2 (> 0).
+ */
+void ldpc_awgn_init(ldpc_awgn_t *ch, double sigma2);
+
+/**
+ * @brief Transmit n bits: y = (2c − 1) + σ·z, LLR = 2y / σ².
+ *
+ * @param code  Bits to send (0/1), length n (several frames may be
+ *              concatenated)
+ * @param rx    Output received samples, or NULL
+ * @param LLR   Output channel LLRs, or NULL (at least one of rx / LLR)
+ */
+void ldpc_awgn_bpsk(const ldpc_awgn_t *ch, ldpc_rng_t *r, const int *code,
+                    double *rx, double *LLR, int n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_CHANNEL_H */
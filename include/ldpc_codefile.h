@@ -0,0 +1,153 @@
+/**
+ * @file ldpc_codefile.h
+ * @brief Compact binary code file (code.bin): sparse H plus packed G.
+ *
+ * Replaces the one-character-per-bit H.csv / G.csv pair for fast startup.
+ * The file is a fixed 112-byte header followed by 8-byte aligned sections:
+ *
+ *   header   magic "LDPCCODE", version, byte-order tag, N, M, K, wc, wr,
+ *            E (ones in H), G kind / row words, section offsets, file
+ *            size and a 64-bit checksum
+ *   row_ptr  int32 [M+1]   CSR offsets of H
+ *   col_idx  int32 [E]     variable of CSR edge e
+ *   col_ptr  int32 [N+1]   CSC offsets of H
+ *   row_idx  int32 [E]     check of CSC slot s
+ *   col_edge int32 [E]     CSR edge of CSC slot s
+ *   G        uint64 [K][g_row_words]  packed rows in the layout of
+ *            ldpc_packed_encoder_t: P only if G = [P | I_K], full G
+ *            otherwise, absent if the file carries H only
+ *
+ * The edge order is the one built by ldpc_decoder_create(), so the arrays
+ * can be used as a decoder's Tanner graph as they are. Integers are stored
+ * in the writer's byte order; files from a machine of the other byte order
+ * are rejected. The checksum (FNV-1a-style 64-bit word hash over the
+ * whole file with the checksum field zeroed) and the index ranges are
+ * verified on open.
+ *
+ * On POSIX systems ldpc_codefile_open() maps the file read-only, so the
+ * sections are used in place without parsing or copying:
+ * ldpc_codefile_decoder() / ldpc_codefile_encoder() build contexts that
+ * borrow the mapped arrays and only allocate their own message storage.
+ * Processes that map the same file share its pages through the page
+ * cache, so the per-process cost of a code is its decoder messages.
+ */
+
+#ifndef LDPC_CODEFILE_H
+#define LDPC_CODEFILE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ldpc_decoder.h"
+#include "ldpc_encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LDPC_CODEFILE_VERSION 1
+
+/* G section kinds */
+#define LDPC_CODEFILE_G_NONE 0 /* H only                     */
+#define LDPC_CODEFILE_G_P 1    /* P of G = [P | I_K]         */
+#define LDPC_CODEFILE_G_FULL 2 /* full K × N generator rows  */
+
+typedef struct ldpc_codefile {
+  int N, M, K;
+  int wc, wr; /* design degrees (informational) */
+  int E;      /* ones in H                      */
+
+  /* H: CSR / CSC views, read-only (point into the mapping) */
+  const int *row_ptr;  /* [M+1] */
+  const int *col_idx;  /* [E]   */
+  const int *col_ptr;  /* [N+1] */
+  const int *row_idx;  /* [E]   */
+  const int *col_edge; /* [E]   */
+
+  /* G: packed rows, or NULL (g_kind == LDPC_CODEFILE_G_NONE) */
+  int g_kind;
+  int g_row_words;
+  const uint64_t *g_rows; /* [K][g_row_words] */
+
+  void *base;  /* mapping or buffer holding the whole file */
+  size_t size; /* file size in bytes                      */
+  int mapped;  /* 1: base is an mmap, 0: malloc'ed buffer */
+} ldpc_codefile_t;
+
+/**
+ * @brief Write a code file from a dense H and an optional G.
+ *
+ * @param path  Output file
+ * @param H     Parity-check matrix (M × N)
+ * @param G     Generator matrix (K × N, K = N − M), or NULL for H only.
+ *              Stored as P if its last K columns are the identity.
+ * @param wc    Design column weight (recorded only)
+ * @param wr    Design row weight (recorded only)
+ *
+ * @return 0 on success, -1 on invalid size / allocation / I/O failure.
+ */
+int ldpc_codefile_write(const char *path, int **H, int **G, int M, int N,
+                        int wc, int wr);
+
+/**
+ * @brief Convert an H.csv / G.csv pair into a code file.
+ *
+ * @param path_G  G.csv, or a missing file / NULL for an H-only code file
+ *
+ * @return 0 on success, -1 if H.csv cannot be read, -2 if G.csv exists
+ *         but is malformed, -3 on allocation / write failure.
+ */
+int ldpc_codefile_from_csv(const char *path_bin, const char *path_H,
+                           const char *path_G, int M, int N, int wc, int wr);
+
+/**
+ * @brief Open and verify a code file.
+ *
+ * @return New handle, or NULL if the file cannot be read, is truncated,
+ *         has a bad magic / version / byte order / checksum, or holds
+ *         out-of-range indices.
+ */
+ldpc_codefile_t *ldpc_codefile_open(const char *path);
+
+/**
+ * @brief Unmap / free a code file. NULL is a no-op.
+ *
+ * Every pointer taken from the handle becomes invalid.
+ */
+void ldpc_codefile_close(ldpc_codefile_t *cf);
+
+/**
+ * @brief Expand H into a dense M × N matrix (allocated by the caller).
+ */
+void ldpc_codefile_expand_H(const ldpc_codefile_t *cf, int **H);
+
+/**
+ * @brief Decoder context over the mapped H sections (no copy, see
+ *        ldpc_decoder_create_csr()). cf must outlive the context.
+ *
+ * @return New context, or NULL on allocation failure.
+ */
+ldpc_decoder_t *ldpc_codefile_decoder(const ldpc_codefile_t *cf);
+
+/**
+ * @brief Packed encoder over the mapped G section (no copy, see
+ *        ldpc_packed_encoder_borrow_rows()). cf must outlive the encoder.
+ *
+ * @return New encoder, or NULL if the file has no G / allocation failure.
+ */
+ldpc_packed_encoder_t *ldpc_codefile_encoder(const ldpc_codefile_t *cf);
+
+/**
+ * @brief Read a 0/1 matrix from a CSV file in the H.csv / G.csv layout
+ *        (one character per entry, one row per line, any line length).
+ *
+ * @return 0 on success, -1 if the file cannot be opened, -2 if it has too
+ *         few rows or a row is shorter than cols.
+ */
+int ldpc_load_matrix_csv(int **mat, int rows, int cols, const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_CODEFILE_H */
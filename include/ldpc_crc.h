@@ -0,0 +1,108 @@
+/**
+ * @file ldpc_crc.h
+ * @brief Outer CRC over the information bits, with the per-bit syndrome
+ *        table used for incremental checking during decoding.
+ *
+ * The CRC protects the first k information bits of a frame: k − L data
+ * bits followed by the L CRC bits (MSB first), i.e. inf[0 .. k−1] as
+ * passed to ldpc_encode(). Information bits from k to K − 1 (e.g.
+ * shortened bits) are not covered.
+ *
+ *   ldpc_crc_t *crc = ldpc_crc_create_std(24, K);
+ *   ldpc_rng_bits(rng, inf, K - 24);
+ *   ldpc_crc_append(crc, inf);            (inf[K−24 .. K−1] = CRC)
+ *   ldpc_encode(ecc, inf, G, N, K);
+ *   ...
+ *   ldpc_decoder_set_crc(dec, crc);       (ldpc_decoder.h)
+ *
+ * The CRC is linear in the protected bits up to a constant: with
+ * col[j] the register contribution of bit j,
+ *
+ *   ldpc_crc_syndrome(inf) = XOR_{j : inf[j] = 1} col[j]
+ *
+ * equals `target` exactly when the CRC bits match the data. Flipping bit
+ * j therefore updates the syndrome with one XOR, which is how
+ * ldpc_decoder_decode() re-checks the CRC after every iteration at the
+ * cost of the bits that changed.
+ *
+ * A context is read-only after creation and may be shared by any number
+ * of decoders and threads.
+ */
+
+#ifndef LDPC_CRC_H
+#define LDPC_CRC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Generator polynomials (MSB-first, x^L term implied) */
+#define LDPC_CRC8_POLY 0x9Bu        /* 3GPP CRC8                 */
+#define LDPC_CRC16_POLY 0x1021u     /* CCITT / 3GPP CRC16        */
+#define LDPC_CRC24A_POLY 0x864CFBu  /* 3GPP CRC24A               */
+#define LDPC_CRC24B_POLY 0x800063u  /* 3GPP CRC24B (segments)    */
+#define LDPC_CRC32_POLY 0x04C11DB7u /* IEEE 802.3                */
+
+typedef struct ldpc_crc {
+  int width;     /* CRC bits L (1 .. 32)                               */
+  uint32_t poly; /* generator polynomial without the x^L term         */
+  uint32_t init; /* initial register value                            */
+  int k;         /* protected bits: k − L data bits, then L CRC bits  */
+
+  uint32_t *col;   /* [k] syndrome contribution of protected bit j     */
+  uint32_t target; /* syndrome of every valid word (init contribution) */
+} ldpc_crc_t;
+
+/**
+ * @brief Build a CRC over k protected bits.
+ *
+ * @param width  CRC length L (1 .. 32)
+ * @param poly   Generator polynomial (MSB first, x^L term omitted)
+ * @param init   Initial register value (only the low L bits are used)
+ * @param k      Protected bits including the CRC (k > L)
+ *
+ * @return New context, or NULL on invalid arguments / allocation failure.
+ */
+ldpc_crc_t *ldpc_crc_create(int width, uint32_t poly, uint32_t init, int k);
+
+/**
+ * @brief ldpc_crc_create() with the standard polynomial of an 8-, 16-,
+ *        24- (CRC24A) or 32-bit CRC and a zero initial register.
+ *
+ * @return New context, or NULL for any other width / invalid k.
+ */
+ldpc_crc_t *ldpc_crc_create_std(int width, int k);
+
+/**
+ * @brief Release a context. NULL is a no-op.
+ */
+void ldpc_crc_destroy(ldpc_crc_t *crc);
+
+/**
+ * @brief CRC register of n bits (0/1 values, MSB first), starting from
+ *        crc->init.
+ */
+uint32_t ldpc_crc_compute(const ldpc_crc_t *crc, const int *bits, int n);
+
+/**
+ * @brief Write the CRC of inf[0 .. k−L−1] into inf[k−L .. k−1].
+ */
+void ldpc_crc_append(const ldpc_crc_t *crc, int *inf);
+
+/**
+ * @brief Linear syndrome of inf[0 .. k−1] (see file comment).
+ */
+uint32_t ldpc_crc_syndrome(const ldpc_crc_t *crc, const int *inf);
+
+/**
+ * @brief 1 if the CRC bits of inf match its data bits, 0 otherwise.
+ */
+int ldpc_crc_check(const ldpc_crc_t *crc, const int *inf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_CRC_H */
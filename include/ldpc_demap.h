@@ -0,0 +1,123 @@
+/**
+ * @file ldpc_demap.h
+ * @brief Soft demapper: received IQ samples → bit LLRs for BPSK, QPSK and
+ *        Gray-mapped square 16/64/256-QAM.
+ *
+ * Constellations (unit average symbol energy) and their Gray bit labels
+ * are tabulated once per demapper. A square QAM with Gray mapping is the
+ * product of two Gray PAMs, so over AWGN every LLR depends on one real
+ * dimension only: with L = √M levels per axis a symbol costs 2·L distance
+ * evaluations instead of M · log2(M) terms.
+ *
+ * Bit labels (bits[s·m + k] for symbol s, m bits per symbol):
+ *   - k = 0 .. m/2−1 label the I axis, k = m/2 .. m−1 the Q axis (BPSK:
+ *     I only, Q ignored), most significant bit of each axis first
+ *   - level j of an axis (amplitudes in increasing order) carries the Gray
+ *     label j ^ (j >> 1), so the first bit of an axis is its sign and
+ *     BPSK keeps the library mapping bit 1 → +1
+ *
+ * LLRs follow the decoders' convention LLR = log P(b = 1 | y) / P(b = 0 | y):
+ *   - LDPC_DEMAP_EXACT : log-sum-exp over the levels of each label set
+ *   - LDPC_DEMAP_MAXLOG: max-log approximation (max instead of sum)
+ *
+ * Samples are processed in blocks of symbols with the per-symbol work in
+ * contiguous inner loops; on x86-64 AVX2 and AVX-512F builds of the
+ * kernel are compiled and the widest one supported is selected in
+ * ldpc_demapper_create().
+ */
+
+#ifndef LDPC_DEMAP_H
+#define LDPC_DEMAP_H
+
+#include <stdint.h>
+
+#include "ldpc_fixed.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  LDPC_MOD_BPSK = 1, /* value: bits per symbol */
+  LDPC_MOD_QPSK = 2,
+  LDPC_MOD_QAM16 = 4,
+  LDPC_MOD_QAM64 = 6,
+  LDPC_MOD_QAM256 = 8
+} ldpc_modulation_t;
+
+typedef enum {
+  LDPC_DEMAP_EXACT = 0, /* log-sum-exp        */
+  LDPC_DEMAP_MAXLOG = 1 /* max-log (max / min) */
+} ldpc_demap_mode_t;
+
+#define LDPC_DEMAP_MAX_LEVELS 16 /* per axis (256-QAM) */
+
+typedef struct ldpc_demapper ldpc_demapper_t;
+
+typedef void (*ldpc_demap_fn)(const ldpc_demapper_t *d, const float *iq,
+                              int nsym, float sigma2, int maxlog, float *LLR);
+
+struct ldpc_demapper {
+  ldpc_modulation_t mod;
+  int bits;      /* m: bits per symbol                   */
+  int dims;      /* 1 (BPSK) or 2 (I and Q)              */
+  int dim_bits;  /* bits per axis                        */
+  int levels;    /* L: PAM levels per axis               */
+  float amp[LDPC_DEMAP_MAX_LEVELS];           /* level j amplitude */
+  unsigned char label[LDPC_DEMAP_MAX_LEVELS]; /* level j Gray label */
+  unsigned char level[LDPC_DEMAP_MAX_LEVELS]; /* label → level      */
+  float *points; /* [2^m][2] constellation (I, Q) by symbol label */
+
+  ldpc_demap_fn kernel; /* selected at create time        */
+  const char *isa;      /* "avx512f", "avx2" or "generic" */
+};
+
+/**
+ * @brief Create a demapper (constellation and label tables).
+ *
+ * @return New demapper, or NULL on an unknown modulation / allocation
+ *         failure.
+ */
+ldpc_demapper_t *ldpc_demapper_create(ldpc_modulation_t mod);
+
+/**
+ * @brief Release a demapper. NULL is a no-op.
+ */
+void ldpc_demapper_destroy(ldpc_demapper_t *d);
+
+/**
+ * @brief Map bits to symbols.
+ *
+ * @param bits  Input bits (0/1), length nsym · m
+ * @param iq    Output samples [nsym][2] (I, Q; Q = 0 for BPSK)
+ */
+void ldpc_demap_modulate(const ldpc_demapper_t *d, const int *bits,
+                         float *iq, int nsym);
+
+/**
+ * @brief Bit LLRs from received samples.
+ *
+ * @param iq      Received samples [nsym][2] (I, Q)
+ * @param nsym    Number of symbols
+ * @param sigma2  Noise variance per real dimension (σ² = N0 / 2)
+ * @param mode    LDPC_DEMAP_EXACT or LDPC_DEMAP_MAXLOG
+ * @param LLR     Output LLRs, length nsym · m
+ */
+void ldpc_demap(const ldpc_demapper_t *d, const float *iq, int nsym,
+                double sigma2, ldpc_demap_mode_t mode, float *LLR);
+
+/**
+ * @brief ldpc_demap() into fixed-point channel LLRs (ldpc_fixed.h format,
+ *        same rounding and clipping as ldpc_fixed_quantize()).
+ *
+ * @return Number of values clipped to ±(2^(llr_bits−1) − 1).
+ */
+int ldpc_demap_quantized(const ldpc_demapper_t *d, const float *iq, int nsym,
+                         double sigma2, ldpc_demap_mode_t mode,
+                         const ldpc_qformat_t *q, int16_t *Lq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_DEMAP_H */
@@ -19,6 +19,8 @@
 #ifndef LDPC_ENCODER_H
 #define LDPC_ENCODER_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -45,6 +47,106 @@ extern "C" {
  */
 void ldpc_encode(int *ecc, const int *inf, int **G, int N, int K);
 
+/* ============================================================================
+ *  Bit-packed encoder
+ *  --------------------------------------------------------------------------
+ *  G is stored as rows of uint64_t words (bit i of a vector lives in word
+ *  i / 64, bit position i % 64). If G is systematic, G = [P | I_K] with the
+ *  identity on the last K columns, only the K × M parity part P is kept and
+ *  the information bits are copied into the codeword tail:
+ *
+ *      c[0 .. M-1]   = XOR of the P rows selected by the set bits of u
+ *      c[M .. N-1]   = u
+ *
+ *  Otherwise the full K × N rows are kept. Encoding is word-parallel
+ *  (64 columns per XOR), and the row-XOR kernel is compiled for baseline,
+ *  AVX2 and AVX-512F on x86-64 with the best one chosen at create time.
+ * ============================================================================
+ */
+#define LDPC_WORDS(n) (((n) + 63) / 64) /* uint64_t words for n bits */
+
+typedef void (*ldpc_xor_rows_fn)(uint64_t *acc, const uint64_t *rows,
+                                 int stride, int nw, uint64_t sel);
+
+typedef struct ldpc_packed_encoder {
+  int N, K, M;
+  int systematic;       /* 1: rows hold P only (G = [P | I_K])  */
+  int row_bits;         /* M if systematic, N otherwise         */
+  int row_words;        /* LDPC_WORDS(row_bits)                 */
+  const uint64_t *rows; /* [K][row_words] packed generator rows */
+  int owns_rows;        /* 1: rows are freed with the encoder   */
+
+  ldpc_xor_rows_fn xor_rows; /* dispatched row-XOR kernel           */
+  const char *isa;           /* "avx512f", "avx2" or "generic"      */
+} ldpc_packed_encoder_t;
+
+/**
+ * @brief Build a packed encoder from a K × N generator matrix.
+ *
+ * The encoder is read-only after creation and may be shared by threads.
+ *
+ * @return New encoder, or NULL on invalid size / allocation failure.
+ */
+ldpc_packed_encoder_t *ldpc_packed_encoder_create(int **G, int N, int K);
+
+/**
+ * @brief Build a packed encoder from already packed generator rows, e.g.
+ *        the G section of a binary code file (ldpc_codefile.h).
+ *
+ * @param rows        [K][LDPC_WORDS(M or N)] packed rows (copied)
+ * @param systematic  1: rows hold P only (G = [P | I_K]), 0: full G rows
+ *
+ * @return New encoder, or NULL on invalid size / allocation failure.
+ */
+ldpc_packed_encoder_t *ldpc_packed_encoder_create_rows(const uint64_t *rows,
+                                                       int N, int K,
+                                                       int systematic);
+
+/**
+ * @brief ldpc_packed_encoder_create_rows() without the copy: the encoder
+ *        reads the caller's rows, which must outlive it (zero-copy use of
+ *        a mapped code file).
+ */
+ldpc_packed_encoder_t *ldpc_packed_encoder_borrow_rows(const uint64_t *rows,
+                                                       int N, int K,
+                                                       int systematic);
+
+/**
+ * @brief Release a packed encoder. NULL is a no-op.
+ */
+void ldpc_packed_encoder_destroy(ldpc_packed_encoder_t *enc);
+
+/**
+ * @brief Encode packed information bits into a packed codeword.
+ *
+ * @param enc  Packed encoder
+ * @param ecc  Output codeword, LDPC_WORDS(N) words (unused high bits of the
+ *             last word are cleared)
+ * @param inf  Input information bits, LDPC_WORDS(K) words (bits beyond K
+ *             are ignored)
+ */
+void ldpc_encode_packed(const ldpc_packed_encoder_t *enc, uint64_t *ecc,
+                        const uint64_t *inf);
+
+/**
+ * @brief Encode int-per-bit vectors with the packed encoder.
+ *
+ * Drop-in replacement for ldpc_encode() (same ecc/inf layout, identical
+ * output); G is taken from the encoder.
+ */
+void ldpc_encode_bits(const ldpc_packed_encoder_t *enc, int *ecc,
+                      const int *inf);
+
+/**
+ * @brief Pack n 0/1 ints into LDPC_WORDS(n) words (high bits cleared).
+ */
+void ldpc_pack_bits(uint64_t *words, const int *bits, int n);
+
+/**
+ * @brief Unpack n bits from packed words into 0/1 ints.
+ */
+void ldpc_unpack_bits(int *bits, const uint64_t *words, int n);
+
 #ifdef __cplusplus
 }
 #endif
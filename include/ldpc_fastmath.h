@@ -0,0 +1,90 @@
+/**
+ * @file ldpc_fastmath.h
+ * @brief Vectorisable single-precision exp / log for the lane loops of the
+ *        demapper and the batch decoder (Cephes polynomials).
+ *
+ * libm's expf / logf are opaque calls that keep the symbol and lane loops
+ * scalar. These versions are accurate to a few ulp over the ranges used
+ * here (exp of x ≤ 0, log of normal positive values) and inline into the
+ * calling loop. Selects are done on the integer bit patterns: under the
+ * default -ftrapping-math GCC does not if-convert floating-point
+ * conditionals, which would stop vectorisation.
+ *
+ * Internal helpers: every function is static inline, nothing is exported.
+ */
+
+#ifndef LDPC_FASTMATH_H
+#define LDPC_FASTMATH_H
+
+#include <stdint.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LDPC_FASTMATH_INLINE static inline __attribute__((always_inline))
+#else
+#define LDPC_FASTMATH_INLINE static inline
+#endif
+
+typedef union {
+  float f;
+  int32_t i;
+} ldpc_fbits_t;
+
+/* e^x for x ≤ 0; flushes to 0 below about −88 */
+LDPC_FASTMATH_INLINE float ldpc_fast_exp(float x) {
+  /* clamp to ≥ −88: for negative floats, a larger int pattern means a
+   * larger magnitude (+0 has a non-negative pattern and is kept) */
+  ldpc_fbits_t u, lim;
+  u.f = x;
+  lim.f = -88.0f;
+  u.i ^= (u.i ^ lim.i) & -((u.i > lim.i) & (u.i < 0));
+  x = u.f;
+
+  const float t = x * 1.44269504088896341f;
+  const int n = (int)(t - 0.5f); /* round to nearest; n ≥ −127 */
+  const float fn = (float)n;
+  const float g = (x - fn * 0.693359375f) + fn * 2.12194440e-4f;
+  const float z = g * g;
+  float p = 1.9875691500e-4f;
+  p = p * g + 1.3981999507e-3f;
+  p = p * g + 8.3334519073e-3f;
+  p = p * g + 4.1665795894e-2f;
+  p = p * g + 1.6666665459e-1f;
+  p = p * g + 5.0000001201e-1f;
+  p = p * z + g + 1.0f;
+
+  ldpc_fbits_t sc;
+  sc.i = (n + 127) << 23; /* n = −127: scale 0 */
+  return p * sc.f;
+}
+
+/* ln x for normal x > 0 */
+LDPC_FASTMATH_INLINE float ldpc_fast_log(float x) {
+  ldpc_fbits_t u;
+  u.f = x;
+  int e = ((u.i >> 23) & 0xff) - 126; /* x = m · 2^e, m in [0.5, 1) */
+  u.i = (u.i & 0x007fffff) | 0x3f000000;
+  const int lo = u.f < 0.707106781186547524f;
+  e -= lo;
+  ldpc_fbits_t add = u;
+  add.i &= -lo; /* m < √½: m → 2m */
+  const float m = u.f - 1.0f + add.f;
+
+  const float z = m * m;
+  float y = 7.0376836292e-2f;
+  y = y * m - 1.1514610310e-1f;
+  y = y * m + 1.1676998740e-1f;
+  y = y * m - 1.2420140846e-1f;
+  y = y * m + 1.4249322787e-1f;
+  y = y * m - 1.6668057665e-1f;
+  y = y * m + 2.0000714765e-1f;
+  y = y * m - 2.4999993993e-1f;
+  y = y * m + 3.3333331174e-1f;
+  y = y * m * z;
+
+  const float fe = (float)e;
+  y += fe * -2.12194440e-4f;
+  y -= 0.5f * z;
+  return m + y + fe * 0.693359375f;
+}
+
+#endif /* LDPC_FASTMATH_H */
@@ -0,0 +1,153 @@
+/**
+ * @file ldpc_fixed.h
+ * @brief Fixed-point (quantized) LDPC Min-Sum decoder.
+ *
+ * Integer-only decoder intended as a bit-exact reference for hardware
+ * (FPGA/ASIC) and embedded implementations:
+ *
+ *   - Channel LLRs are quantized to llr_bits two's-complement integers
+ *     with frac_bits fractional bits and symmetric saturation:
+ *
+ *         q = clamp( round(LLR · 2^frac_bits), −Qmax, +Qmax ),
+ *         Qmax = 2^(llr_bits−1) − 1       (round = half away from zero)
+ *
+ *   - Messages are stored as int8_t (msg_bits ≤ 8) or int16_t
+ *     (msg_bits ≤ 16) and saturated to ±(2^(msg_bits−1) − 1).
+ *
+ *   - Posterior LLRs are accumulated in int32 and saturated to post_bits.
+ *
+ *   - Check-node kernels: Min-Sum, Normalized Min-Sum (α quantized to
+ *     1/16 steps, applied as (|m|·α16) >> 4) and Offset Min-Sum (β in
+ *     LLR units, quantized to the frac_bits grid). SPA is not available
+ *     in fixed point.
+ *
+ * Every saturation event is counted so that word lengths can be tuned
+ * against the floating-point decoders.
+ *
+ * Schedule and stopping rule are the same as ldpc_decoder_decode():
+ * flooding, early stop on H·c^T = 0.
+ */
+
+#ifndef LDPC_FIXED_H
+#define LDPC_FIXED_H
+
+#include <stdint.h>
+
+#include "ldpc_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ *  Quantization format
+ * ============================================================================
+ */
+typedef struct {
+  int llr_bits;  /* channel LLR width          (2..16) */
+  int msg_bits;  /* C→V / V→C message width    (2..16) */
+  int post_bits; /* posterior LLR width        (msg_bits..24) */
+  int frac_bits; /* fractional bits of all quantities (0..llr_bits-1) */
+} ldpc_qformat_t;
+
+/* ============================================================================
+ *  Saturation counters (accumulated until ldpc_fixed_reset_counters())
+ * ============================================================================
+ */
+typedef struct {
+  unsigned long long llr_sat;  /* channel LLRs clipped by quantization */
+  unsigned long long v2c_sat;  /* V→C messages clipped to msg_bits     */
+  unsigned long long post_sat; /* posterior LLRs clipped to post_bits  */
+} ldpc_fixed_counters_t;
+
+typedef struct ldpc_fixed {
+  const ldpc_decoder_t *graph; /* borrowed: edge lists, M, N, K, E */
+  ldpc_qformat_t q;
+
+  int llr_max;  /* 2^(llr_bits-1) - 1  */
+  int msg_max;  /* 2^(msg_bits-1) - 1  */
+  int post_max; /* 2^(post_bits-1) - 1 */
+
+  ldpc_kernel_t kernel; /* MIN_SUM, NMS or OMS (default: MIN_SUM) */
+  int alpha16;          /* NMS factor in 1/16 units (16 = 1.0)    */
+  int beta_q;           /* OMS offset in quantized LLR units       */
+
+  int wide;     /* 0: int8_t messages, 1: int16_t messages */
+  void *v2c;    /* [E] V→C messages (int8_t or int16_t)    */
+  void *c2v;    /* [E] C→V messages (int8_t or int16_t)    */
+  int32_t *post; /* [N] posterior LLRs                     */
+
+  ldpc_fixed_counters_t counters;
+} ldpc_fixed_t;
+
+/**
+ * @brief Create a fixed-point decoder over the Tanner graph of `graph`.
+ *
+ * @param graph  Decoder context whose edge lists are shared (borrowed;
+ *               must outlive the fixed-point decoder)
+ * @param q      Quantization format (copied)
+ *
+ * @return New decoder, or NULL if the format is invalid or allocation fails.
+ */
+ldpc_fixed_t *ldpc_fixed_create(const ldpc_decoder_t *graph,
+                                const ldpc_qformat_t *q);
+
+/**
+ * @brief Release a fixed-point decoder. NULL is a no-op.
+ */
+void ldpc_fixed_destroy(ldpc_fixed_t *fx);
+
+/**
+ * @brief Select the check-node kernel.
+ *
+ * @param kernel  LDPC_KERNEL_MIN_SUM, LDPC_KERNEL_NMS or LDPC_KERNEL_OMS
+ * @param param   α for NMS (0 < α ≤ 1, rounded to 1/16), β for OMS in LLR
+ *                units (β ≥ 0, rounded to 2^-frac_bits)
+ *
+ * @return 0 on success, -1 if the kernel is unsupported or param invalid.
+ */
+int ldpc_fixed_set_kernel(ldpc_fixed_t *fx, ldpc_kernel_t kernel,
+                          double param);
+
+/**
+ * @brief Quantize floating-point channel LLRs into the decoder's format.
+ *
+ * @param fx   Fixed-point decoder (provides the format; its llr_sat
+ *             counter is updated)
+ * @param LLR  Input LLRs (length n)
+ * @param Lq   Output quantized LLRs (length n)
+ * @param n    Number of values
+ *
+ * @return Number of values clipped in this call.
+ */
+int ldpc_fixed_quantize(ldpc_fixed_t *fx, const double *LLR, int16_t *Lq,
+                        int n);
+
+/**
+ * @brief Decode one frame from quantized channel LLRs.
+ *
+ * @param fx       Fixed-point decoder
+ * @param Lq       Quantized channel LLRs (length N, within ±llr_max)
+ * @param ecc      Output decoded codeword bits (length N, 0/1)
+ * @param inf      Output decoded information bits (length K, 0/1)
+ * @param max_iter Maximum number of iterations (≤ 0: the channel hard
+ *                 decision is returned)
+ *
+ * The hard decision of Lq is checked first; a valid word is returned
+ * without iterating.
+ *
+ * @return LDPC_DECODE_OK or LDPC_DECODE_MAX_ITER.
+ */
+int ldpc_fixed_decode(ldpc_fixed_t *fx, const int16_t *Lq, int *ecc,
+                      int *inf, int max_iter);
+
+/**
+ * @brief Clear the saturation counters.
+ */
+void ldpc_fixed_reset_counters(ldpc_fixed_t *fx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_FIXED_H */
@@ -0,0 +1,134 @@
+/**
+ * @file ldpc_gpu.h
+ * @brief CUDA batch decoder: many frames per kernel launch.
+ *
+ * The flooding decoder of ldpc_batch.h mapped onto a GPU:
+ *
+ *   - messages live in device memory, frame-interleaved like the SIMD
+ *     batch (msg[e * F + f]), so the threads of a warp, which handle
+ *     consecutive frames of one check / variable node, access memory
+ *     coalesced
+ *   - one thread per (check node, frame) and per (variable node, frame)
+ *   - a per-frame convergence flag retires frames whose hard decision
+ *     satisfies all checks; retired frames are skipped and once every
+ *     frame has converged the remaining launches return immediately, so
+ *     the host queues all iterations without synchronising
+ *   - two buffer sets in pinned host memory, each with its own stream:
+ *     while one batch is decoded the next one is filled and copied
+ *     (double buffering, see ldpc_gpu_submit())
+ *
+ * Kernels follow ldpc_batch.c (single precision, (−1)^d check sign, SPA
+ * and the min-sum family). Schedules and stopping rules of the template
+ * context are not used: decoding is flooding and frames stop on a zero
+ * syndrome or at max_iter.
+ *
+ * Build: the backend is compiled with `make CUDA=1` (nvcc, CUDA runtime).
+ * Otherwise ldpc_gpu_device_count() returns 0 and ldpc_gpu_create()
+ * returns NULL, so callers can fall back to the CPU decoders.
+ *
+ * A GPU context must not be shared between threads; create one per
+ * thread (several may use the same device).
+ */
+
+#ifndef LDPC_GPU_H
+#define LDPC_GPU_H
+
+#include "ldpc_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ldpc_gpu ldpc_gpu_t;
+
+/**
+ * @brief Number of usable CUDA devices (0 without CUDA support).
+ */
+int ldpc_gpu_device_count(void);
+
+/**
+ * @brief Create a GPU decoder over the Tanner graph of `graph`.
+ *
+ * @param graph       Decoder context whose edge lists are copied to the
+ *                    device; its kernel setting is the initial GPU kernel
+ * @param max_frames  Frames per submission (≥ 1; thousands keep a GPU busy)
+ * @param device      CUDA device index
+ *
+ * @return New GPU decoder, or NULL on invalid arguments, device or
+ *         allocation failure, or when built without CUDA.
+ */
+ldpc_gpu_t *ldpc_gpu_create(const ldpc_decoder_t *graph, int max_frames,
+                            int device);
+
+/**
+ * @brief Release a GPU decoder (waits for batches in flight). NULL is a
+ *        no-op.
+ */
+void ldpc_gpu_destroy(ldpc_gpu_t *g);
+
+/**
+ * @brief Select the check-node kernel; same semantics as
+ *        ldpc_decoder_set_kernel().
+ *
+ * @return 0 on success, -1 if kernel or param is out of range.
+ */
+int ldpc_gpu_set_kernel(ldpc_gpu_t *g, ldpc_kernel_t kernel, double param);
+
+/**
+ * @brief Device name (e.g. for log output).
+ */
+const char *ldpc_gpu_name(const ldpc_gpu_t *g);
+
+/**
+ * @brief Frames per submission (max_frames of ldpc_gpu_create()).
+ */
+int ldpc_gpu_max_frames(const ldpc_gpu_t *g);
+
+/**
+ * @brief Pinned input buffer of the next ldpc_gpu_submit() (max_frames × N
+ *        floats, frame-major). Filling it in place avoids one host copy.
+ *
+ * @return The buffer, or NULL while both buffer sets are in flight.
+ */
+float *ldpc_gpu_input(ldpc_gpu_t *g);
+
+/**
+ * @brief Start decoding a batch asynchronously.
+ *
+ * @param LLR      Channel LLRs, frame-major (nframes × N), or NULL if they
+ *                 were written to ldpc_gpu_input()
+ * @param nframes  Number of frames (1 .. max_frames)
+ * @param max_iter Maximum number of iterations
+ *
+ * @return 0 on success, -1 on invalid arguments, a CUDA error or when two
+ *         batches are already in flight (collect one first).
+ */
+int ldpc_gpu_submit(ldpc_gpu_t *g, const float *LLR, int nframes,
+                    int max_iter);
+
+/**
+ * @brief Wait for the oldest submitted batch and fetch its results.
+ *
+ * @param ecc     Output codewords, frame-major (nframes × N), or NULL
+ * @param inf     Output information bits, frame-major (nframes × K), or NULL
+ * @param status  Per-frame LDPC_DECODE_OK / LDPC_DECODE_MAX_ITER, or NULL
+ *
+ * @return Number of converged frames, or -1 if no batch is in flight or
+ *         on a CUDA error.
+ */
+int ldpc_gpu_collect(ldpc_gpu_t *g, int *ecc, int *inf, int *status);
+
+/**
+ * @brief Synchronous ldpc_gpu_submit() + ldpc_gpu_collect().
+ *
+ * @return Number of converged frames, or -1 on failure or while
+ *         asynchronous batches are in flight.
+ */
+int ldpc_gpu_decode(ldpc_gpu_t *g, const float *LLR, int nframes, int *ecc,
+                    int *inf, int *status, int max_iter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_GPU_H */
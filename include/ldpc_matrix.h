@@ -15,6 +15,8 @@
 #ifndef LDPC_MATRIX_H
 #define LDPC_MATRIX_H
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -46,6 +48,28 @@ extern "C" {
  */
 void generate_Hmatrix(int **H, int N, int wc, int wr);
 
+/**
+ * @brief Reentrant generate_Hmatrix() drawing from a caller-owned RNG.
+ *
+ * Same construction, but the column permutations come from the SplitMix64
+ * state *rng_state (advanced in place) instead of rand(), so independent
+ * threads can build candidates concurrently and a given seed always
+ * yields the same H.
+ *
+ * @param rng_state  RNG state (any value is a valid seed)
+ */
+void generate_Hmatrix_seeded(int **H, int N, int wc, int wr,
+                             uint64_t *rng_state);
+
+/**
+ * @brief RNG state of candidate idx in a seeded H search.
+ *
+ * SplitMix64 finalizer of (seed, idx): independent streams per candidate,
+ * so candidate idx of gene_hg --seed S can be rebuilt anywhere (e.g. by
+ * the code registry, ldpc_registry.h) without replaying the search.
+ */
+uint64_t ldpc_candidate_seed(uint64_t seed, long long idx);
+
 /* ========================================================================== */
 /* 2. Systematic Generator Matrix Construction                                */
 /* ========================================================================== */
@@ -102,18 +126,30 @@ void generate_Gmatrix(int **H, int **G, int N, int wc, int wr);
  *   - If two columns share `shared >= 2` check nodes, they contribute
  *     nC2 = shared! / (2!(shared − 2)!) distinct 4-cycles
  *
+ * The count is computed by ldpc_count_cycles4() (ldpc_analysis.h) from
+ * the equivalent check-pair overlaps, in about O(N · w_c² · w_r); wc and
+ * wr are only used to derive M, the column/row degrees may be irregular.
+ *
  * This function is intended for structural analysis only; it does not
  * modify H.
  *
  * @param H   Parity-check matrix, size M × N (M = N * w_c / w_r)
  * @param N   Codeword length
- * @param wc  Column weight
- * @param wr  Row weight
+ * @param wc  Column weight (design value, for M)
+ * @param wr  Row weight (design value, for M)
  *
  * @return    Total number of 4-cycles detected in H.
  */
 int count_floop(int **H, int N, int wc, int wr);
 
+/**
+ * @brief count_floop() with early abort for candidate searches.
+ *
+ * Stops as soon as the running count exceeds `limit` and returns that
+ * partial count (> limit). With limit < 0 the full count is returned.
+ */
+int count_floop_limit(int **H, int N, int wc, int wr, int limit);
+
 #ifdef __cplusplus
 }
 #endif
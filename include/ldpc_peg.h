@@ -0,0 +1,89 @@
+/**
+ * @file ldpc_peg.h
+ * @brief Progressive Edge-Growth (PEG) parity-check matrix construction.
+ *
+ * PEG (Hu, Eleftheriou, Arnold) places the edges of every variable node
+ * one at a time. For each new edge of variable v, a breadth-first search
+ * from v over the partial Tanner graph finds the checks farthest from v:
+ *
+ *   - if some checks cannot be reached at all, the new edge closes no
+ *     cycle and one of them is chosen;
+ *   - otherwise the checks first reached at the deepest BFS level are the
+ *     candidates, so the new cycle is as long as possible.
+ *
+ * Among the candidates the check with the lowest current degree wins
+ * (rows stay balanced / hit their target degrees). Optional refinements:
+ *
+ *   - ACE tie-break (PEG-ACE, Tian et al. / Xiao–Banihashemi): among
+ *     equally distant candidates, prefer the one whose new cycle has the
+ *     largest approximate cycle extrinsic message degree
+ *     ACE = Σ_{variables on the cycle} (d_v − 2). Matters for irregular
+ *     codes with degree-2 variables.
+ *   - target girth: the BFS stops after the levels that would close a
+ *     cycle shorter than target_girth, and any check beyond them is
+ *     accepted. This truncates the search for large N. With check caps,
+ *     the checks beyond the horizon can all be full late in the
+ *     construction; an edge of such a check is then moved to an open
+ *     check where it closes no short cycle either, so its slot goes to
+ *     the new edge and every cap holds. Only when no move is found (the
+ *     target is too large for N) is a shorter cycle accepted, the
+ *     longest one a move or the BFS allows; ldpc_girth() reports the
+ *     result.
+ *
+ * Remaining ties are broken by a seeded SplitMix64 RNG, so a seed fixes
+ * the construction. Variables are processed in order of increasing
+ * degree, as in the original algorithm.
+ */
+
+#ifndef LDPC_PEG_H
+#define LDPC_PEG_H
+
+#include <stdint.h>
+
+#include "ldpc_analysis.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+  int M, N;
+  const int *var_deg; /* [N] variable-node degrees, or NULL: all wc   */
+  int wc;             /* regular column degree if var_deg is NULL     */
+  const int *chk_deg; /* [M] target check degrees (caps), or NULL     */
+  int ace;            /* 1: ACE tie-break among equally far checks    */
+  int target_girth;   /* 0: full BFS; g > 0: stop the BFS at cycles
+                         of length g, keep the girth >= g if possible */
+  uint64_t seed;      /* tie-break RNG seed                           */
+} ldpc_peg_params_t;
+
+/**
+ * @brief Build a Tanner graph with PEG.
+ *
+ * @return New graph (see ldpc_analysis.h), or NULL on invalid parameters
+ *         (a variable degree > M or < 1) / allocation failure.
+ */
+ldpc_graph_t *ldpc_peg_construct(const ldpc_peg_params_t *p);
+
+/**
+ * @brief Regular (wc, wr) PEG matrix in the dense layout of
+ *        generate_Hmatrix().
+ *
+ * M = N · wc / wr checks, every check capped at wr edges.
+ *
+ * @param H     Output parity-check matrix (M × N, allocated externally)
+ * @param degs  Optional [N] irregular variable degrees (NULL: all wc);
+ *              check caps are then left open
+ * @param ace   ACE tie-break
+ * @param seed  Tie-break seed
+ *
+ * @return 0 on success, -1 on invalid parameters / allocation failure.
+ */
+int generate_Hmatrix_peg(int **H, int N, int wc, int wr, const int *degs,
+                         int ace, uint64_t seed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_PEG_H */
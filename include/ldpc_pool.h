@@ -0,0 +1,114 @@
+/**
+ * @file ldpc_pool.h
+ * @brief Asynchronous decoder service: a worker pool with lock-free queues,
+ *        work stealing and optional in-order delivery.
+ *
+ * Frames are submitted without blocking and decoded by a fixed set of
+ * threads, each owning a decoder context over a shared Tanner graph:
+ *
+ *   submit → frame slot (LLRs copied) → queue of worker (seq mod W)
+ *          → any idle worker (own queue first, then stealing from the
+ *            others) → ldpc_decoder_decode() → completion
+ *
+ * Queues are bounded lock-free MPMC rings (sequence-numbered cells), so
+ * submission, stealing and completion never take a lock. The pool mutex
+ * is only used to let idle threads sleep and to wake them.
+ *
+ * Delivery order:
+ *   - in order (in_order = 1): results come out in submission order; a
+ *     slow frame delays delivery of later ones but not their decoding
+ *   - completion order (in_order = 0): results come out as soon as a
+ *     worker finishes, so fast-converging frames overtake slow ones
+ *
+ * Backpressure: at most `depth` frames are in flight; ldpc_pool_submit()
+ * returns -1 while the pool is full (collect results, then retry).
+ *
+ * Threading: one thread may submit and one thread (the same or another)
+ * may collect results at a time.
+ */
+
+#ifndef LDPC_POOL_H
+#define LDPC_POOL_H
+
+#include "ldpc_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ldpc_pool ldpc_pool_t;
+
+typedef struct {
+  long long seq; /* submission number (0, 1, ...)             */
+  void *user;    /* value passed to ldpc_pool_submit()        */
+  int status;    /* ldpc_decoder_decode() result              */
+} ldpc_pool_result_t;
+
+/**
+ * @brief Start a decoder pool.
+ *
+ * @param graph      Template context: its Tanner graph is shared by the
+ *                   workers (borrowed, must outlive the pool); its
+ *                   configuration is copied with
+ *                   ldpc_decoder_copy_config() (the hook context is
+ *                   shared by all workers)
+ * @param n_workers  Worker threads (≥ 1)
+ * @param depth      Frames in flight (rounded up to a power of two)
+ * @param in_order   1: deliver in submission order, 0: completion order
+ * @param max_iter   Maximum iterations per frame
+ *
+ * @return New pool, or NULL on invalid arguments / allocation or thread
+ *         creation failure.
+ */
+ldpc_pool_t *ldpc_pool_create(const ldpc_decoder_t *graph, int n_workers,
+                              int depth, int in_order, int max_iter);
+
+/**
+ * @brief Stop the workers and release the pool. Frames still in flight
+ *        are discarded. NULL is a no-op.
+ */
+void ldpc_pool_destroy(ldpc_pool_t *pool);
+
+/**
+ * @brief Queue one frame (N channel LLRs, copied).
+ *
+ * @return Its sequence number, or -1 if the pool is full.
+ */
+long long ldpc_pool_submit(ldpc_pool_t *pool, const double *LLR, void *user);
+
+/**
+ * @brief Fetch the next result without blocking.
+ *
+ * @param res  Output result
+ * @param ecc  Output codeword (N), or NULL
+ * @param inf  Output information bits (K), or NULL
+ *
+ * @return 1 if a result was delivered, 0 if none is ready.
+ */
+int ldpc_pool_poll(ldpc_pool_t *pool, ldpc_pool_result_t *res, int *ecc,
+                   int *inf);
+
+/**
+ * @brief ldpc_pool_poll() that sleeps until a result is ready.
+ *
+ * @return 1 if a result was delivered, 0 if no frame is in flight.
+ */
+int ldpc_pool_wait(ldpc_pool_t *pool, ldpc_pool_result_t *res, int *ecc,
+                   int *inf);
+
+/**
+ * @brief Frames submitted but not yet delivered.
+ */
+long long ldpc_pool_pending(const ldpc_pool_t *pool);
+
+/**
+ * @brief Frames decoded by a worker other than the one they were queued
+ *        to (work-stealing counter).
+ */
+unsigned long long ldpc_pool_steals(const ldpc_pool_t *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_POOL_H */
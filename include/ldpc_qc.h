@@ -0,0 +1,214 @@
+/**
+ * @file ldpc_qc.h
+ * @brief Quasi-cyclic (QC) LDPC codes: circulant-compressed storage,
+ *        structured encoder and Z-block layered decoder.
+ *
+ * A QC-LDPC parity-check matrix is described by an mb × nb base matrix of
+ * circulant shifts and a lifting size Z:
+ *
+ *     H = [ P^{s(i,j)} ]   (M = mb·Z rows, N = nb·Z columns)
+ *
+ * where P^s is the Z × Z identity cyclically shifted right by s (row r has
+ * its one in column (r + s) mod Z) and s = −1 denotes the all-zero block.
+ * This is the convention of the IEEE 802.11n/ac and 5G NR base graphs.
+ * Storage is O(mb · nb), independent of Z.
+ *
+ * Codeword layout follows the rest of the library: [parity (M) | info (K)],
+ * i.e. base columns 0 .. mb−1 are parity, mb .. nb−1 information.
+ *
+ * Structured encoding (ldpc_qc_encode) requires the dual-diagonal parity
+ * part used by 802.11n-style base matrices:
+ *
+ *   - column 0 : circulants whose sum is a single circulant P^y (e.g. three
+ *                entries with shifts x, y, x)
+ *   - column j ≥ 1 : identities in rows j−1 and j, zero elsewhere
+ *
+ * Then Σ_i λ_i = P^y p_0 with λ_i = Σ_{info j} P^{s(i,j)} u_j, and the
+ * remaining parity blocks follow row by row by back substitution at
+ * O(E) cost. Other base matrices can still be expanded and used with the
+ * dense / sparse encoders.
+ *
+ * The decoder is row-layered: one layer is a base row, i.e. Z independent
+ * checks processed together. Every nonzero block is handled as a Z-wide
+ * vector that is loaded from and stored to the posteriors with a circular
+ * rotation (two contiguous runs), so the check-node update runs over
+ * contiguous arrays of Z lanes.
+ */
+
+#ifndef LDPC_QC_H
+#define LDPC_QC_H
+
+#include <stdint.h>
+
+#include "ldpc_analysis.h"
+#include "ldpc_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ============================================================================
+ *  QC code (base matrix + lifting size)
+ * ============================================================================
+ */
+typedef struct ldpc_qc_code {
+  int mb, nb, Z;
+  int M, N, K; /* mb·Z, nb·Z, N − M */
+
+  int *shift; /* [mb*nb] base matrix, row-major, −1 = zero block */
+
+  /* nonzero blocks in row-major (CSR) order */
+  int n_blocks;
+  int *row_ptr;   /* [mb+1] */
+  int *blk_col;   /* [n_blocks] base column */
+  int *blk_shift; /* [n_blocks] circulant shift */
+  int max_row_deg;
+
+  int encodable; /* dual-diagonal parity part detected */
+  int p0_shift;  /* y with Σ_i P^{s(i,0)} = P^y        */
+} ldpc_qc_code_t;
+
+/**
+ * @brief Create a QC code from a base matrix.
+ *
+ * @param mb, nb  Base matrix dimensions (mb < nb)
+ * @param Z       Lifting size (Z ≥ 1)
+ * @param shift   [mb*nb] row-major shifts in [0, Z), −1 for zero blocks
+ *                (copied)
+ *
+ * @return New code, or NULL on invalid input / allocation failure.
+ */
+ldpc_qc_code_t *ldpc_qc_create(int mb, int nb, int Z, const int *shift);
+
+/**
+ * @brief Release a QC code. NULL is a no-op.
+ */
+void ldpc_qc_destroy(ldpc_qc_code_t *qc);
+
+/**
+ * @brief Random dual-diagonal QC code.
+ *
+ * Parity part as described above (column 0: shifts 1, 0, 1 in rows 0,
+ * mb/2, mb−1). Every information column gets wc circulants placed in the
+ * least-loaded base rows, with shifts drawn from a SplitMix64 stream and
+ * re-drawn to avoid 4-cycles (s(a,c) − s(b,c) + s(b,d) − s(a,d) ≢ 0 mod Z)
+ * where possible.
+ *
+ * @return New code, or NULL on invalid parameters (mb < 3, nb ≤ mb,
+ *         Z < 2, wc outside 1..mb) / allocation failure.
+ */
+ldpc_qc_code_t *ldpc_qc_generate(int mb, int nb, int Z, int wc,
+                                 uint64_t seed);
+
+/**
+ * @brief Load a base matrix file.
+ *
+ * Text format: '#' comment lines, then "mb nb Z", then mb rows of nb
+ * shifts (−1 = zero block).
+ *
+ * @return New code, or NULL on open / parse / validation failure.
+ */
+ldpc_qc_code_t *ldpc_qc_load(const char *path);
+
+/**
+ * @brief Save the base matrix in the format read by ldpc_qc_load().
+ *
+ * @return 0 on success, -1 on I/O failure.
+ */
+int ldpc_qc_save(const ldpc_qc_code_t *qc, const char *path);
+
+/**
+ * @brief Expand into a dense M × N parity-check matrix (allocated by the
+ *        caller), e.g. for generate_Gmatrix() or ldpc_decoder_create().
+ */
+void ldpc_qc_expand(const ldpc_qc_code_t *qc, int **H);
+
+/**
+ * @brief Expand into a sparse Tanner graph (O(E) memory) for
+ *        ldpc_analysis.h.
+ *
+ * @return New graph, or NULL on allocation failure.
+ */
+ldpc_graph_t *ldpc_qc_graph(const ldpc_qc_code_t *qc);
+
+/* ============================================================================
+ *  Structured encoder
+ * ============================================================================
+ */
+/**
+ * @brief Encode K information bits into an N-bit codeword
+ *        [parity (M) | info (K)].
+ *
+ * Stateless and allocation-free; may be called concurrently.
+ *
+ * @return 0 on success, -1 if the base matrix is not dual-diagonal
+ *         (qc->encodable == 0).
+ */
+int ldpc_qc_encode(const ldpc_qc_code_t *qc, int *ecc, const int *inf);
+
+/* ============================================================================
+ *  Z-block layered decoder
+ * ============================================================================
+ *
+ *  Messages are single-precision floats: C→V storage holds one Z-vector per
+ *  nonzero block (padded to a multiple of 16 lanes). One context per
+ *  thread.
+ */
+typedef struct ldpc_qc_decoder {
+  const ldpc_qc_code_t *code; /* borrowed; must outlive the decoder */
+  int Zp;                     /* Z padded to the vector chunk size  */
+
+  ldpc_kernel_t kernel; /* check-node kernel (default: SPA) */
+  float alpha;          /* NMS scaling factor               */
+  float beta;           /* OMS offset                       */
+
+  float *c2v;  /* [n_blocks][Zp] C→V messages                */
+  float *post; /* [N] posterior LLRs                         */
+  float *t;    /* [max_row_deg][Zp] rotated V→C of one layer */
+  float *f;    /* [max_row_deg][Zp] SPA φ values / MS mags   */
+  float *acc1; /* [Zp] min1 / φ-sum                          */
+  float *acc2; /* [Zp] min2                                  */
+  float *sgn;  /* [Zp] sign product                          */
+  unsigned char *syn;  /* [Zp] syndrome of one layer         */
+  unsigned char *hard; /* [N] hard decisions                 */
+} ldpc_qc_decoder_t;
+
+/**
+ * @brief Create a decoder for a QC code.
+ *
+ * @return New decoder, or NULL on allocation failure.
+ */
+ldpc_qc_decoder_t *ldpc_qc_decoder_create(const ldpc_qc_code_t *qc);
+
+/**
+ * @brief Release a decoder. NULL is a no-op.
+ */
+void ldpc_qc_decoder_destroy(ldpc_qc_decoder_t *dec);
+
+/**
+ * @brief Select the check-node kernel (same semantics as
+ *        ldpc_decoder_set_kernel()).
+ *
+ * @return 0 on success, -1 on an invalid kernel or parameter.
+ */
+int ldpc_qc_decoder_set_kernel(ldpc_qc_decoder_t *dec, ldpc_kernel_t kernel,
+                               double param);
+
+/**
+ * @brief Decode one frame (layered schedule, early stop on H·c^T = 0).
+ *
+ * @param LLR      Channel LLRs (length N, LLR > 0 favours bit 1)
+ * @param ecc      Output codeword bits (length N)
+ * @param inf      Output information bits (length K)
+ * @param max_iter Maximum number of iterations
+ *
+ * @return LDPC_DECODE_OK or LDPC_DECODE_MAX_ITER.
+ */
+int ldpc_qc_decode(ldpc_qc_decoder_t *dec, const double *LLR, int *ecc,
+                   int *inf, int max_iter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_QC_H */
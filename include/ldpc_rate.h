@@ -0,0 +1,126 @@
+/**
+ * @file ldpc_rate.h
+ * @brief Rate matching of a mother code by puncturing and shortening.
+ *
+ * One (N, K) mother code serves any rate k / n with
+ *
+ *   - shortening : S = K − k information bits are fixed to 0 and not sent;
+ *                  the receiver knows them (LLR = −LDPC_RATE_LLR_KNOWN,
+ *                  since bit 0 ↔ negative LLR in this library)
+ *   - puncturing : P = N − S − n parity bits are not sent; the receiver
+ *                  erases them (LLR = 0)
+ *
+ * Masks: the rate object precomputes, once per mother code, a priority
+ * order of the parity bits. Selecting a rate only stores (P, S):
+ *
+ *   - parity bit j is punctured  iff  rank[j] < P
+ *   - codeword bit j is shortened iff j ≥ N − S   (the information tail,
+ *     so the k user bits are inf[0 .. k−1] of the mother code)
+ *
+ * Switching rates therefore allocates nothing and touches no matrix: the
+ * encoder and decoder keep working on the mother code.
+ *
+ * Puncturing order: parity bits are visited in a spread order; first every
+ * bit whose checks have no punctured neighbour yet is taken (each of these
+ * is recovered from one check in the first iteration, "1-step
+ * recoverable"), then the remaining parity bits in the same order.
+ * n_safe counts the bits of the first class.
+ *
+ * Codeword layout (ldpc_encoder.h): [parity (N−K) | information (K)].
+ * Transmitted bits keep their codeword order with punctured and shortened
+ * positions removed.
+ */
+
+#ifndef LDPC_RATE_H
+#define LDPC_RATE_H
+
+#include "ldpc_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* LLR magnitude of a known (shortened) bit */
+#define LDPC_RATE_LLR_KNOWN 1000.0
+
+typedef struct ldpc_rate {
+  int N, K;  /* mother code                                   */
+  int *rank; /* [N] puncturing rank of parity bits (info: N)  */
+  int n_safe; /* parity bits punctured 1-step recoverable       */
+
+  /* current rate (ldpc_rate_set) */
+  int n_punct; /* P: punctured parity bits   */
+  int n_short; /* S: shortened info bits     */
+} ldpc_rate_t;
+
+/**
+ * @brief Precompute the puncturing order of a mother code.
+ *
+ * @param graph  Decoder context of the mother code (only read during the
+ *               call)
+ *
+ * @return New rate object at the mother rate (P = S = 0), or NULL on
+ *         allocation failure.
+ */
+ldpc_rate_t *ldpc_rate_create(const ldpc_decoder_t *graph);
+
+/**
+ * @brief Release a rate object. NULL is a no-op.
+ */
+void ldpc_rate_destroy(ldpc_rate_t *r);
+
+/**
+ * @brief Select P punctured parity bits and S shortened info bits. O(1).
+ *
+ * @return 0 on success, -1 if P ∉ [0, N−K] or S ∉ [0, K−1].
+ */
+int ldpc_rate_set(ldpc_rate_t *r, int n_punct, int n_short);
+
+/**
+ * @brief Select the rate k / n: k information bits in n transmitted bits.
+ *
+ * @return 0 on success, -1 if no (P, S) gives it (k ∉ [1, K] or
+ *         n ∉ [k, N − K + k]).
+ */
+int ldpc_rate_select(ldpc_rate_t *r, int k, int n);
+
+/**
+ * @brief Information bits per frame at the current rate (K − S).
+ */
+int ldpc_rate_info_length(const ldpc_rate_t *r);
+
+/**
+ * @brief Transmitted bits per frame at the current rate (N − P − S).
+ */
+int ldpc_rate_tx_length(const ldpc_rate_t *r);
+
+/**
+ * @brief Mother-code information word from k user bits: info[0..k−1]
+ *        followed by S zeros.
+ */
+void ldpc_rate_expand_info(const ldpc_rate_t *r, const int *info, int *inf);
+
+/**
+ * @brief Drop punctured and shortened bits: code (N) → tx (tx_length).
+ */
+void ldpc_rate_puncture(const ldpc_rate_t *r, const int *code, int *tx);
+
+/**
+ * @brief Rebuild N decoder LLRs from tx_length received LLRs: punctured
+ *        bits get 0, shortened bits −LDPC_RATE_LLR_KNOWN.
+ */
+void ldpc_rate_depuncture(const ldpc_rate_t *r, const double *rx,
+                          double *LLR);
+
+/**
+ * @brief ldpc_rate_depuncture() for single-precision LLRs (batch / GPU
+ *        decoders).
+ */
+void ldpc_rate_depuncture_float(const ldpc_rate_t *r, const float *rx,
+                                float *LLR);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_RATE_H */
@@ -0,0 +1,133 @@
+/**
+ * @file ldpc_registry.h
+ * @brief Code registry: look up LDPC codes by parameters or ID, build them
+ *        on a miss, cache them in memory and on disk.
+ *
+ * A code is identified by its key (N, wc, wr, seed, construction), written
+ * as an ID that is also its folder name under the registry root:
+ *
+ *     N{N}_wc{wc}_wr{wr}[_s{seed}][_peg | _ace | _qc{Z}]
+ *
+ * e.g. "N1024_wc3_wr6" (the unseeded gene_hg folder), "N4096_wc3_wr6_s7_peg"
+ * or "N1024_wc3_wr6_s1_qc32". gene_hg writes every matrix it builds into
+ * the folder of its ID. Lookup order for ldpc_registry_get():
+ *
+ *   1. memory: codes already opened by this registry (hash table)
+ *   2. disk:   <root>/<ID>/code.bin, converted from H.csv / G.csv first if
+ *              only the CSV pair exists
+ *   3. build:  the candidate gene_hg --seed S --candidates 1 would pick
+ *              (Gallager, PEG, PEG-ACE or QC H, ldpc_candidate_seed(S, 0);
+ *              seed 0 for the unseeded ID), G by generate_Gmatrix(),
+ *              written to <root>/<ID>/code.bin (QC: also base.txt)
+ *
+ * A cached code holds the mapped code file (ldpc_codefile.h): the Tanner
+ * graph and the packed G shared read-only by every context built from it.
+ * ldpc_code_decoder() / ldpc_code_encoder() then only allocate per-thread
+ * message storage. All functions are thread-safe; codes stay valid until
+ * the registry is destroyed.
+ */
+
+#ifndef LDPC_REGISTRY_H
+#define LDPC_REGISTRY_H
+
+#include <stdint.h>
+
+#include "ldpc_codefile.h"
+#include "ldpc_decoder.h"
+#include "ldpc_encoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  LDPC_CONSTRUCT_GALLAGER = 0, /* generate_Hmatrix_seeded()        */
+  LDPC_CONSTRUCT_PEG = 1,      /* generate_Hmatrix_peg()           */
+  LDPC_CONSTRUCT_PEG_ACE = 2,  /* generate_Hmatrix_peg(), ACE      */
+  LDPC_CONSTRUCT_QC = 3        /* ldpc_qc_generate(), lifting Z    */
+} ldpc_construct_t;
+
+typedef struct {
+  int N, wc, wr;
+  uint64_t seed; /* 0: unseeded ID (built from seed 0 on a miss) */
+  ldpc_construct_t construction;
+  int Z; /* QC lifting size (LDPC_CONSTRUCT_QC only, else 0) */
+} ldpc_code_key_t;
+
+typedef struct ldpc_code {
+  ldpc_code_key_t key;
+  char id[64];               /* folder name / ID string       */
+  int N, M, K;
+  const ldpc_codefile_t *cf; /* mapped graph and G (shared)   */
+} ldpc_code_t;
+
+typedef struct ldpc_registry ldpc_registry_t;
+
+/**
+ * @brief Format the ID of a key into buf.
+ *
+ * @return 0 on success, -1 on an invalid key (N ≤ 0, wc ≤ 0, wr ≤ wc; QC:
+ *         Z ≥ 2 dividing N and M, M / Z ≥ 3, wc ≤ M / Z) or if buf is
+ *         too small.
+ */
+int ldpc_code_id(const ldpc_code_key_t *key, char *buf, int size);
+
+/**
+ * @brief Parse an ID ("N1024_wc3_wr6_s7_peg", or a path ending in one).
+ *
+ * @return 0 on success, -1 on a malformed ID.
+ */
+int ldpc_code_parse_id(const char *id, ldpc_code_key_t *key);
+
+/**
+ * @brief Create a registry over a matrices directory.
+ *
+ * @param root   Folder holding the code folders (e.g. "matrices"); created
+ *               on the first build
+ * @param build  1: build missing codes, 0: fail lookups that miss on disk
+ *
+ * @return New registry, or NULL on allocation failure.
+ */
+ldpc_registry_t *ldpc_registry_create(const char *root, int build);
+
+/**
+ * @brief Close every cached code and free the registry. NULL is a no-op.
+ */
+void ldpc_registry_destroy(ldpc_registry_t *reg);
+
+/**
+ * @brief Look up a code by key (memory, then disk, then build).
+ *
+ * @return Cached code, or NULL on an invalid key, a miss with building
+ *         disabled, a corrupt / mismatching code file or build failure.
+ */
+const ldpc_code_t *ldpc_registry_get(ldpc_registry_t *reg,
+                                     const ldpc_code_key_t *key);
+
+/**
+ * @brief ldpc_registry_get() for an ID string.
+ */
+const ldpc_code_t *ldpc_registry_get_id(ldpc_registry_t *reg, const char *id);
+
+/**
+ * @brief Decoder context over the cached graph (no copy). One per thread.
+ *
+ * @return New context (release with ldpc_decoder_destroy()), or NULL on
+ *         allocation failure.
+ */
+ldpc_decoder_t *ldpc_code_decoder(const ldpc_code_t *code);
+
+/**
+ * @brief Packed encoder over the cached G (no copy; read-only, may be
+ *        shared by threads).
+ *
+ * @return New encoder (release with ldpc_packed_encoder_destroy()), or
+ *         NULL if the code file has no G / allocation failure.
+ */
+ldpc_packed_encoder_t *ldpc_code_encoder(const ldpc_code_t *code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_REGISTRY_H */
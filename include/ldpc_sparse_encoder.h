@@ -0,0 +1,102 @@
+/**
+ * @file ldpc_sparse_encoder.h
+ * @brief Linear-time LDPC encoder working directly on the sparse H.
+ *
+ * The codeword layout is the same as for the generator-matrix encoders:
+ *
+ *      c = [ p (M parity bits) | u (K information bits) ],   H·c^T = 0
+ *
+ * so the parity bits solve  H_p·p^T = H_u·u^T  with H = [H_p | H_u].
+ *
+ * Preprocessing (once, after Richardson–Urbanke):
+ *   - H_p is brought into approximate lower-triangular form by a greedy
+ *     search: whenever some check row has exactly one unresolved parity
+ *     bit, that bit becomes a pivot solved from the row; otherwise one
+ *     parity bit is declared a "gap" variable and treated as known.
+ *   - The g gap variables are fixed by the r check rows left without a
+ *     pivot. Their r × g system Φ is formed by back-substitution with a
+ *     unit gap vector and reduced to row echelon form over GF(2).
+ *
+ * Encoding (per frame, "solve twice"):
+ *   1) back-substitute with gap = 0 and evaluate the residual checks
+ *   2) solve Φ·x = residual (dense, g × r bits)
+ *   3) back-substitute again with gap = x
+ *
+ * Cost is two passes over the edges plus O(g·r) bit operations; G is
+ * never needed. Rank-deficient H (e.g. Gallager codes) is supported as
+ * long as the first M columns form a check set, which holds for H after
+ * generate_Gmatrix() (that routine mirrors its column swaps into H).
+ */
+
+#ifndef LDPC_SPARSE_ENCODER_H
+#define LDPC_SPARSE_ENCODER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ldpc_sparse_encoder {
+  int M, N, K;
+
+  /* H in CSR form */
+  int *row_ptr; /* [M+1] */
+  int *col_idx; /* [E]   */
+
+  /* back-substitution schedule: pivot k solves bit piv_col[k] from row
+   * piv_row[k]; all other bits of that row are known at that point */
+  int n_piv;
+  int *piv_row; /* [n_piv] */
+  int *piv_col; /* [n_piv] */
+
+  /* dense gap: g gap bits fixed by r residual rows */
+  int n_gap;
+  int *gap_col; /* [g] parity positions of the gap variables  */
+  int n_res;
+  int *res_row; /* [r] check rows without a pivot              */
+  int rank;     /* rank of Φ                                   */
+  int res_words;
+  uint64_t *solve;  /* [r][res_words] row operations T with T·Φ = RREF */
+  int *solve_col;   /* [rank] gap variable set by solve row i          */
+
+  /* per-frame workspace (an encoder is used by one thread at a time) */
+  uint64_t *syn;  /* [res_words] residual syndrome */
+  int *x;         /* [g] gap solution              */
+} ldpc_sparse_encoder_t;
+
+/**
+ * @brief Preprocess H for sparse encoding.
+ *
+ * @param H  Parity-check matrix (M × N), only read
+ * @param M  Number of checks
+ * @param N  Codeword length
+ * @param K  Information length (N − M)
+ *
+ * @return New encoder, or NULL on invalid sizes / allocation failure.
+ */
+ldpc_sparse_encoder_t *ldpc_sparse_encoder_create(int **H, int M, int N,
+                                                  int K);
+
+/**
+ * @brief Release a sparse encoder. NULL is a no-op.
+ */
+void ldpc_sparse_encoder_destroy(ldpc_sparse_encoder_t *enc);
+
+/**
+ * @brief Encode K information bits into an N-bit codeword.
+ *
+ * @param enc  Sparse encoder
+ * @param ecc  Output codeword (length N, 0/1), ecc[M..N-1] = inf
+ * @param inf  Information bits (length K, 0/1)
+ *
+ * @return 0 on success, -1 if H·c^T = 0 has no solution with this
+ *         information word (the first M columns of H are not a check set).
+ */
+int ldpc_sparse_encode(ldpc_sparse_encoder_t *enc, int *ecc, const int *inf);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_SPARSE_ENCODER_H */
@@ -0,0 +1,121 @@
+/**
+ * @file ldpc_stats.h
+ * @brief Decoder statistics: iteration histograms, syndrome trajectories
+ *        and phase timers aggregated over frames.
+ *
+ * The decoder fills one ldpc_frame_stats_t per frame while a record is
+ * attached (ldpc_decoder_set_stats(), ldpc_decoder.h); an ldpc_stats_t
+ * accumulates those records, e.g. per SNR point:
+ *
+ *   - iteration histogram: frames by the number of iterations they ran,
+ *     plus converged / stalled counts (tuning max_iter, stall detection)
+ *   - mean unsatisfied-check count after each iteration t, where frames
+ *     that stopped earlier keep contributing their final value, so the
+ *     curve is the average syndrome weight of the population at t
+ *   - check-node, variable-node and syndrome phase ticks
+ *
+ * Ticks come from the CPU time-stamp counter where available (x86-64
+ * RDTSC, AArch64 CNTVCT_EL0), else from a monotonic clock in ns;
+ * ldpc_ticks_per_sec() converts them.
+ *
+ * Aggregates are not thread-safe: keep one per thread and combine them
+ * with ldpc_stats_merge().
+ */
+
+#ifndef LDPC_STATS_H
+#define LDPC_STATS_H
+
+#include "ldpc_decoder.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ldpc_stats {
+  int max_iter; /* histogram / trajectory length − 1 */
+
+  unsigned long long frames;    /* frames added                      */
+  unsigned long long converged; /* frames with a zero final syndrome */
+  unsigned long long stalled;   /* frames aborted by a stopping rule */
+  unsigned long long iter_sum;  /* Σ iterations                      */
+
+  unsigned long long *iter_hist; /* [max_iter+1] frames by iterations run  */
+  unsigned long long *unsat_sum; /* [max_iter+1] Σ unsatisfied checks after
+                                    t iterations (frames with trajectory) */
+  unsigned long long traj_frames; /* frames that carried a trajectory     */
+
+  unsigned long long ticks_check; /* Σ check-node phase ticks   */
+  unsigned long long ticks_var;   /* Σ variable-node phase ticks */
+  unsigned long long ticks_syn;   /* Σ syndrome phase ticks     */
+} ldpc_stats_t;
+
+/**
+ * @brief Current time-stamp counter value (see file comment for units).
+ */
+unsigned long long ldpc_ticks(void);
+
+/**
+ * @brief Ticks per second (calibrated once against the monotonic clock).
+ */
+double ldpc_ticks_per_sec(void);
+
+/**
+ * @brief Create an empty aggregate for frames of at most max_iter
+ *        iterations (≥ 0).
+ *
+ * @return New aggregate, or NULL on invalid max_iter / allocation failure.
+ */
+ldpc_stats_t *ldpc_stats_create(int max_iter);
+
+/**
+ * @brief Release an aggregate. NULL is a no-op.
+ */
+void ldpc_stats_destroy(ldpc_stats_t *st);
+
+/**
+ * @brief Clear all counters.
+ */
+void ldpc_stats_reset(ldpc_stats_t *st);
+
+/**
+ * @brief Add one decoded frame. Iteration counts above max_iter are
+ *        counted in the last bin; a trajectory shorter than the frame's
+ *        iterations + 1 is ignored for the unsatisfied-check sums.
+ */
+void ldpc_stats_add(ldpc_stats_t *st, const ldpc_frame_stats_t *fs);
+
+/**
+ * @brief dst += src.
+ *
+ * @return 0 on success, -1 if the max_iter values differ.
+ */
+int ldpc_stats_merge(ldpc_stats_t *dst, const ldpc_stats_t *src);
+
+/**
+ * @brief Mean iterations per frame (0 without frames).
+ */
+double ldpc_stats_mean_iterations(const ldpc_stats_t *st);
+
+/**
+ * @brief Smallest iteration count t such that a fraction ≥ q of the frames
+ *        ran at most t iterations (q in [0, 1]; 0 without frames).
+ */
+int ldpc_stats_iteration_quantile(const ldpc_stats_t *st, double q);
+
+/**
+ * @brief Mean unsatisfied checks after t iterations (t = 0: channel hard
+ *        decision), over the frames that carried a trajectory.
+ */
+double ldpc_stats_mean_unsat(const ldpc_stats_t *st, int t);
+
+/**
+ * @brief Mean nanoseconds per frame of the three phases.
+ */
+void ldpc_stats_phase_ns(const ldpc_stats_t *st, double *check_ns,
+                         double *var_ns, double *syn_ns);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_STATS_H */
@@ -0,0 +1,192 @@
+/**
+ * @file ldpc_stream.h
+ * @brief Streaming encode / decode of continuous byte streams.
+ *
+ * Transmit side (ldpc_stream_tx_t):
+ *
+ *     bytes → input ring → K-bit frames → packed encoder → BPSK / QAM
+ *           → sample ring → ldpc_stream_tx_pull()
+ *
+ * Receive side (ldpc_stream_rx_t):
+ *
+ *     LLR chunks → batch of frame slots → ldpc_batch_decode_float()
+ *                → information bits → byte ring → ldpc_stream_rx_pull()
+ *
+ * ldpc_stream_rx_create_gpu() decodes the slots with the GPU backend
+ * (ldpc_gpu.h) instead, one submission per max_frames frames.
+ *
+ * Bit order: bit i of byte b is stream bit 8b + i (LSB first), and
+ * frame f carries stream bits f·K .. f·K + K − 1 as its information bits
+ * (the codeword tail, ldpc_encoder.h). Frames need not be byte aligned.
+ *
+ * Chunk sizes are arbitrary on both sides; frames are cut internally, so
+ * callers never handle per-frame calls or unpacked bits.
+ *
+ * Backpressure: push calls accept only what fits and return the amount
+ * taken. The transmitter stops encoding while its sample ring has no room
+ * for another frame. The receiver stops taking LLRs while its byte ring
+ * cannot hold another decoded batch. Pull from the far end and push the
+ * remainder again. All calls are non-blocking. A stream object is not
+ * thread-safe; use one per thread.
+ */
+
+#ifndef LDPC_STREAM_H
+#define LDPC_STREAM_H
+
+#include <stddef.h>
+
+#include "ldpc_batch.h"
+#include "ldpc_decoder.h"
+#include "ldpc_demap.h"
+#include "ldpc_encoder.h"
+#include "ldpc_gpu.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ldpc_stream_tx ldpc_stream_tx_t;
+typedef struct ldpc_stream_rx ldpc_stream_rx_t;
+
+typedef struct {
+  unsigned long long frames; /* frames encoded / decoded        */
+  unsigned long long failed; /* rx: frames not converged        */
+  unsigned long long bytes;  /* bytes accepted (tx) / produced (rx) */
+} ldpc_stream_stats_t;
+
+/* ============================================================================
+ *  Transmitter
+ * ============================================================================
+ */
+/**
+ * @brief Create a transmitter.
+ *
+ * @param enc    Packed encoder (borrowed, must outlive the stream)
+ * @param mod    Modulator for the samples (borrowed), or NULL for BPSK
+ *               with one float per coded bit (bit 1 → +1, bit 0 → −1).
+ *               With a demapper, samples are (I, Q) float pairs and N must
+ *               be a multiple of its bits per symbol.
+ * @param depth  Frames buffered on each side of the encoder (≥ 1)
+ *
+ * @return New transmitter, or NULL on invalid arguments / allocation
+ *         failure.
+ */
+ldpc_stream_tx_t *ldpc_stream_tx_create(const ldpc_packed_encoder_t *enc,
+                                        const ldpc_demapper_t *mod,
+                                        int depth);
+
+/**
+ * @brief Release a transmitter. NULL is a no-op.
+ */
+void ldpc_stream_tx_destroy(ldpc_stream_tx_t *tx);
+
+/**
+ * @brief Push bytes; encodes every frame that completes while the sample
+ *        ring has room.
+ *
+ * @return Number of bytes accepted (< n when the input ring is full).
+ */
+size_t ldpc_stream_tx_push(ldpc_stream_tx_t *tx, const void *data, size_t n);
+
+/**
+ * @brief Pull up to n output floats (samples).
+ *
+ * @return Number of floats written.
+ */
+size_t ldpc_stream_tx_pull(ldpc_stream_tx_t *tx, float *samples, size_t n);
+
+/**
+ * @brief End of stream: encode buffered bytes, zero-padding the last frame.
+ *
+ * @return Number of padding bits appended (0 if the stream ended on a frame
+ *         boundary), or -1 if the sample ring is full (pull and retry).
+ */
+int ldpc_stream_tx_flush(ldpc_stream_tx_t *tx);
+
+/**
+ * @brief Counters since creation.
+ */
+ldpc_stream_stats_t ldpc_stream_tx_stats(const ldpc_stream_tx_t *tx);
+
+/* ============================================================================
+ *  Receiver
+ * ============================================================================
+ */
+/**
+ * @brief Create a receiver.
+ *
+ * @param graph     Decoder context providing the Tanner graph and initial
+ *                  kernel (borrowed, must outlive the stream)
+ * @param batch     Frames per decoder call: 8, 16 or 32 (SIMD lanes)
+ * @param depth     Decoded batches the byte ring can hold (≥ 1)
+ * @param max_iter  Maximum iterations per batch
+ *
+ * @return New receiver, or NULL on invalid arguments / allocation failure.
+ */
+ldpc_stream_rx_t *ldpc_stream_rx_create(const ldpc_decoder_t *graph,
+                                        int batch, int depth, int max_iter);
+
+/**
+ * @brief Create a receiver that decodes on the GPU.
+ *
+ * @param graph     Decoder context (borrowed, must outlive the stream)
+ * @param gpu       GPU decoder over the same graph (borrowed); its
+ *                  max_frames is the batch size
+ * @param depth     Decoded batches the byte ring can hold (≥ 1)
+ * @param max_iter  Maximum iterations per batch
+ *
+ * A failed GPU submission counts the batch as failed frames and emits the
+ * channel hard decisions, so the byte stream keeps its length.
+ *
+ * @return New receiver, or NULL on invalid arguments / allocation failure.
+ */
+ldpc_stream_rx_t *ldpc_stream_rx_create_gpu(const ldpc_decoder_t *graph,
+                                            ldpc_gpu_t *gpu, int depth,
+                                            int max_iter);
+
+/**
+ * @brief Release a receiver. NULL is a no-op.
+ */
+void ldpc_stream_rx_destroy(ldpc_stream_rx_t *rx);
+
+/**
+ * @brief The receiver's batch decoder (e.g. for ldpc_batch_set_kernel()),
+ *        or NULL for a GPU receiver.
+ */
+ldpc_batch_t *ldpc_stream_rx_batch(ldpc_stream_rx_t *rx);
+
+/**
+ * @brief Push channel LLRs (one per coded bit, frame after frame); decodes
+ *        every batch that fills while the byte ring has room.
+ *
+ * @return Number of LLRs accepted (< n under backpressure).
+ */
+size_t ldpc_stream_rx_push(ldpc_stream_rx_t *rx, const float *LLR, size_t n);
+
+/**
+ * @brief Pull up to n decoded bytes.
+ *
+ * @return Number of bytes written.
+ */
+size_t ldpc_stream_rx_pull(ldpc_stream_rx_t *rx, void *data, size_t n);
+
+/**
+ * @brief End of stream: decode the complete frames of a partial batch and
+ *        emit a trailing partial byte (zero-padded). LLRs of an incomplete
+ *        frame are discarded.
+ *
+ * @return Number of frames decoded, or -1 if the byte ring is full (pull
+ *         and retry).
+ */
+int ldpc_stream_rx_flush(ldpc_stream_rx_t *rx);
+
+/**
+ * @brief Counters since creation.
+ */
+ldpc_stream_stats_t ldpc_stream_rx_stats(const ldpc_stream_rx_t *rx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LDPC_STREAM_H */
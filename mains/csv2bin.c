@@ -0,0 +1,101 @@
+/**
+ * @file csv2bin.c
+ * @brief Convert matrices/N{N}_wc{wc}_wr{wr}/H.csv (+ G.csv) into code.bin.
+ *
+ * Reads the CSV pair of every given folder (default: every folder under
+ * matrices/), writes the binary code file described in ldpc_codefile.h
+ * next to it and reopens it to verify the result. Folders without G.csv
+ * get an H-only file (usable with ldpc_ber --sparse-encoder).
+ *
+ * Usage:
+ *   csv2bin [FOLDER ...]
+ */
+
+#define _POSIX_C_SOURCE 200809L /* opendir() under -std=c99 */
+
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ldpc_codefile.h"
+
+/* convert one folder; returns 0 on success */
+static int convert_folder(const char *folder) {
+  const char *name = strrchr(folder, '/');
+  name = name ? name + 1 : folder;
+
+  int N = 0, wc = 0, wr = 0;
+  if (sscanf(name, "N%d_wc%d_wr%d", &N, &wc, &wr) != 3 || N <= 0 ||
+      wc <= 0 || wr <= wc) {
+    fprintf(stderr, "%s: expected a N{N}_wc{wc}_wr{wr} folder\n", folder);
+    return -1;
+  }
+  const int M = (N * wc) / wr;
+
+  char path_H[512], path_G[512], path_bin[512];
+  snprintf(path_H, sizeof(path_H), "%s/H.csv", folder);
+  snprintf(path_G, sizeof(path_G), "%s/G.csv", folder);
+  snprintf(path_bin, sizeof(path_bin), "%s/code.bin", folder);
+
+  switch (ldpc_codefile_from_csv(path_bin, path_H, path_G, M, N, wc, wr)) {
+  case 0:
+    break;
+  case -1:
+    fprintf(stderr, "%s: cannot read %d x %d H\n", path_H, M, N);
+    return -1;
+  case -2:
+    fprintf(stderr, "%s: cannot read %d x %d G\n", path_G, N - M, N);
+    return -1;
+  default:
+    fprintf(stderr, "%s: write failed\n", path_bin);
+    return -1;
+  }
+
+  ldpc_codefile_t *cf = ldpc_codefile_open(path_bin);
+  if (!cf) {
+    fprintf(stderr, "%s: verification failed\n", path_bin);
+    return -1;
+  }
+  printf("%s: N = %d, M = %d, E = %d, G = %s, %zu bytes\n", path_bin, cf->N,
+         cf->M, cf->E,
+         cf->g_kind == LDPC_CODEFILE_G_P      ? "P"
+         : cf->g_kind == LDPC_CODEFILE_G_FULL ? "full"
+                                              : "none",
+         cf->size);
+  ldpc_codefile_close(cf);
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  int failed = 0;
+
+  if (argc > 1) {
+    for (int a = 1; a < argc; a++)
+      failed |= convert_folder(argv[a]) != 0;
+    return failed;
+  }
+
+  const char *root = "matrices";
+  DIR *dir = opendir(root);
+  if (!dir) {
+    fprintf(stderr, "Cannot open directory: %s\n", root);
+    return 1;
+  }
+
+  int count = 0;
+  struct dirent *entry;
+  while ((entry = readdir(dir)) != NULL) {
+    if (strncmp(entry->d_name, "N", 1) != 0)
+      continue;
+    char folder[512];
+    snprintf(folder, sizeof(folder), "%s/%s", root, entry->d_name);
+    failed |= convert_folder(folder) != 0;
+    count++;
+  }
+  closedir(dir);
+
+  if (count == 0)
+    fprintf(stderr, "No LDPC folders under %s\n", root);
+  return failed || count == 0;
+}
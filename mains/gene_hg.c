@@ -1,34 +1,68 @@
 /**
  * @file gene_hg.c
- * @brief LDPC H/G matrix generator (Gallager construction + G from H).
+ * @brief LDPC H/G matrix generator (Gallager or PEG construction + G from H).
  *
  * This tool:
  *   1. Generates an LDPC parity-check matrix H via Gallager's regular
- * construction
+ * construction, Progressive Edge-Growth (--peg) or as a quasi-cyclic code
+ * (--qc Z)
  *   2. Constructs a systematic generator matrix G from H (GF(2) Gaussian
  * elimination)
  *   3. Counts 4-cycles in H (short cycles in the Tanner graph)
  *   4. Searches for the H/G pair with the smallest number of 4-cycles
  *   5. Periodically saves the best matrices and statistics into files
+ * (H.csv, G.csv and the binary code.bin of ldpc_codefile.h)
  *
  * Notes:
- *   - The search is performed by repeated random Gallager constructions.
- *   - For large N, the exhaustive search with a huge loop_count_max is
- *     computationally very expensive. Adjust loop_count_max as needed
- *     for practical use.
+ *   - The search is performed by repeated random Gallager constructions,
+ *     evaluated concurrently by a pool of worker threads with independent
+ *     per-candidate RNG streams (reproducible with --seed).
+ *   - Candidates are scored by their 4-cycle count first; counting stops
+ *     early once a candidate is worse than the current best, and the
+ *     O(N^3) derivation of G only runs for saved new bests.
+ *   - --candidates bounds the number of candidates, --time-budget the
+ *     search time.
+ *   - --peg builds 4-cycle-free candidates directly (see ldpc_peg.h); the
+ *     candidates then only differ in PEG tie-breaks, so a single one is
+ *     built unless --candidates is given.
+ *   - --qc Z draws dual-diagonal QC base matrices with lifting size Z
+ *     (see ldpc_qc.h; wc is the information column weight, M = N * wc / wr
+ *     must be a multiple of Z). The base matrix of the best candidate is
+ *     saved as base.txt for ldpc_ber --qc; a single candidate is built
+ *     unless --candidates is given.
+ *   - The matrices are saved in matrices/<ID>, the registry ID of the code
+ *     (see ldpc_registry.h): the seed is part of the ID when a single
+ *     candidate is built (the code the registry builds for that ID), a
+ *     search writes the unseeded ID. Irregular PEG degree distributions
+ *     have no ID and are only available through generate_Hmatrix_peg().
+ *
+ * Usage:
+ *   gene_hg [--threads T] [--seed S] [--candidates C] [--time-budget SEC]
+ *           [--exact-stats] [--peg] [--ace] [--qc Z] [--n N --wc WC --wr WR]
  */
 
+#define _POSIX_C_SOURCE 200809L /* clock_gettime(), nanosleep() */
+
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/stat.h> /* mkdir() for POSIX */
 #include <sys/types.h>
 #include <time.h>
+#include <unistd.h>
 
 #ifdef _WIN32
 #include <direct.h> /* _mkdir() on Windows */
 #endif
 
+#include "ldpc_analysis.h"
+#include "ldpc_codefile.h"
 #include "ldpc_matrix.h"
+#include "ldpc_peg.h"
+#include "ldpc_qc.h"
+#include "ldpc_registry.h"
 
 /* ------------------------------------------------------------------------- */
 /* Portable mkdir wrapper                                                    */
@@ -43,29 +77,294 @@ static void make_dir(const char *d) {
 #endif
 }
 
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static int **alloc_matrix_int(int rows, int cols) {
+  int **m = (int **)malloc(rows * sizeof(int *));
+  if (!m)
+    return NULL;
+  for (int i = 0; i < rows; i++) {
+    m[i] = (int *)malloc(cols * sizeof(int));
+    if (!m[i]) {
+      while (i--)
+        free(m[i]);
+      free(m);
+      return NULL;
+    }
+  }
+  return m;
+}
+
+static void free_matrix_int(int **m, int rows) {
+  if (!m)
+    return;
+  for (int i = 0; i < rows; i++)
+    free(m[i]);
+  free(m);
+}
+
+static void copy_matrix_int(int **dst, int **src, int rows, int cols) {
+  for (int i = 0; i < rows; i++)
+    memcpy(dst[i], src[i], cols * sizeof(int));
+}
+
+/* Save a 0/1 matrix as CSV (no separators); 0 on success */
+static int save_matrix_csv(const char *path, int **A, int rows, int cols) {
+  FILE *fp = fopen(path, "w");
+  if (!fp)
+    return -1;
+
+  char *line = (char *)malloc(cols + 2);
+  if (!line) {
+    fclose(fp);
+    return -1;
+  }
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++)
+      line[j] = A[i][j] ? '1' : '0';
+    line[cols] = '\n';
+    line[cols + 1] = '\0';
+    fputs(line, fp);
+  }
+  free(line);
+  return fclose(fp) ? -1 : 0;
+}
+
+/*
+ * Saved files are written to "<path>.<pid>.tmp" and renamed into place
+ * (as the registry does), so ldpc_ber, csv2bin or a registry lookup in
+ * another process never read a half-written matrix. The same directory
+ * keeps rename() atomic; only the main thread saves.
+ */
+static void temp_path(char *buf, size_t size, const char *path) {
+  snprintf(buf, size, "%s.%ld.tmp", path, (long)getpid());
+}
+
+static int commit_temp(const char *tmp, const char *path) {
+  if (rename(tmp, path) == 0)
+    return 0;
+  remove(path); /* Windows: rename() does not replace */
+  if (rename(tmp, path) == 0)
+    return 0;
+  remove(tmp);
+  return -1;
+}
+
+/* ========================================================================== */
+/* Parallel Candidate Search                                                  */
+/* -------------------------------------------------------------------------- */
+/*
+ * Candidate c is the Gallager (or PEG) H drawn from the RNG stream
+ * seeded by (seed, c). Workers claim candidate indices from a shared counter and
+ * score them with count_floop_limit(), which aborts as soon as a
+ * candidate has more 4-cycles than the current best. Only H is kept for
+ * the best candidate (ties → lowest index); G is derived by the main
+ * thread when a new best is saved. With a fixed candidate count the
+ * winner is therefore independent of the thread count.
+ */
+/* ========================================================================== */
+typedef struct {
+  int N, wc, wr, M;
+  uint64_t seed;
+  long long max_candidates;
+  double time_budget; /* seconds, 0 = unlimited */
+  double t_start;
+  int early_abort;
+  int peg;         /* PEG construction instead of Gallager   */
+  int ace;         /* PEG ACE tie-break                      */
+  int qc_Z;        /* > 0: QC construction, lifting size      */
+
+  pthread_mutex_t lock;
+  long long next;      /* next candidate index            */
+  long long evaluated; /* candidates scored               */
+  long long floop_sum; /* sum of (possibly partial) counts */
+  int best_floop;      /* -1 until the first candidate    */
+  long long best_idx;
+  int best_version; /* bumped on every new best        */
+  int **H_best;
+  int running; /* workers still active            */
+  int failed;
+} search_t;
+
+static void *search_worker(void *arg) {
+  search_t *S = (search_t *)arg;
+  int **H = alloc_matrix_int(S->M, S->N);
+
+  pthread_mutex_lock(&S->lock);
+  if (!H)
+    S->failed = 1;
+  pthread_mutex_unlock(&S->lock);
+
+  while (H) {
+    long long idx = -1;
+    int limit = -1;
+
+    pthread_mutex_lock(&S->lock);
+    if (S->next < S->max_candidates &&
+        !(S->time_budget > 0.0 && now_sec() - S->t_start > S->time_budget))
+      idx = S->next++;
+    if (S->early_abort)
+      limit = S->best_floop;
+    pthread_mutex_unlock(&S->lock);
+
+    if (idx < 0)
+      break;
+
+    /* 1) Generate candidate H, 2) count its 4-cycles */
+    uint64_t rng = ldpc_candidate_seed(S->seed, idx);
+    if (S->qc_Z) {
+      ldpc_qc_code_t *qc = ldpc_qc_generate(S->M / S->qc_Z, S->N / S->qc_Z,
+                                            S->qc_Z, S->wc, rng);
+      if (!qc) {
+        pthread_mutex_lock(&S->lock);
+        S->failed = 1;
+        pthread_mutex_unlock(&S->lock);
+        break;
+      }
+      ldpc_qc_expand(qc, H);
+      ldpc_qc_destroy(qc);
+    } else if (S->peg) {
+      if (generate_Hmatrix_peg(H, S->N, S->wc, S->wr, NULL, S->ace, rng)) {
+        pthread_mutex_lock(&S->lock);
+        S->failed = 1;
+        pthread_mutex_unlock(&S->lock);
+        break;
+      }
+    } else {
+      generate_Hmatrix_seeded(H, S->N, S->wc, S->wr, &rng);
+    }
+    int floop = count_floop_limit(H, S->N, S->wc, S->wr, limit);
+
+    /* 3) Keep it if it beats the best so far */
+    pthread_mutex_lock(&S->lock);
+    S->evaluated++;
+    S->floop_sum += floop;
+    if (S->best_floop == -1 || floop < S->best_floop ||
+        (floop == S->best_floop && idx < S->best_idx)) {
+      S->best_floop = floop;
+      S->best_idx = idx;
+      S->best_version++;
+      copy_matrix_int(S->H_best, H, S->M, S->N);
+    }
+    pthread_mutex_unlock(&S->lock);
+  }
+
+  pthread_mutex_lock(&S->lock);
+  S->running--;
+  pthread_mutex_unlock(&S->lock);
+
+  free_matrix_int(H, S->M);
+  return NULL;
+}
+
+static int default_thread_count(void) {
+#if defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n > 0)
+    return (int)n;
+#endif
+  return 1;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [--threads T] [--seed S] [--candidates C]\n"
+          "          [--time-budget SEC] [--exact-stats] [--peg] [--ace]\n"
+          "          [--qc Z] [--n N --wc WC --wr WR]\n"
+          "\n"
+          "  --candidates C     number of random H candidates\n"
+          "                     (default 1 with --peg / --qc)\n"
+          "  --time-budget SEC  stop the search after SEC seconds\n"
+          "  --exact-stats      score every candidate fully (exact average;\n"
+          "                     disables the early abort of losers)\n"
+          "  --peg              Progressive Edge-Growth construction\n"
+          "  --ace              PEG with ACE tie-break (implies --peg)\n"
+          "  --qc Z             dual-diagonal quasi-cyclic code with\n"
+          "                     lifting size Z (also saves base.txt)\n"
+          "  --n/--wc/--wr      code parameters (prompted if omitted)\n",
+          prog);
+}
+
 /* ========================================================================== */
 /* MAIN                                                                       */
 /* ========================================================================== */
-int main(void) {
-  srand((unsigned int)time(NULL));
+int main(int argc, char **argv) {
+  int n_threads = default_thread_count();
+  uint64_t seed = (uint64_t)time(NULL);
+  long long loop_count_max = -1; /* default: 10000000, 1 with --peg/--qc */
+  double time_budget = 0.0;
+  int early_abort = 1;
+  int peg = 0, ace = 0;
+  int qc_Z = 0;
+  int N = 0, wc = 0, wr = 0;
+
+  for (int a = 1; a < argc; a++) {
+    if (!strcmp(argv[a], "--threads") && a + 1 < argc) {
+      n_threads = atoi(argv[++a]);
+    } else if (!strcmp(argv[a], "--seed") && a + 1 < argc) {
+      seed = strtoull(argv[++a], NULL, 10);
+    } else if (!strcmp(argv[a], "--candidates") && a + 1 < argc) {
+      loop_count_max = atoll(argv[++a]);
+    } else if (!strcmp(argv[a], "--time-budget") && a + 1 < argc) {
+      time_budget = atof(argv[++a]);
+    } else if (!strcmp(argv[a], "--exact-stats")) {
+      early_abort = 0;
+    } else if (!strcmp(argv[a], "--peg")) {
+      peg = 1;
+    } else if (!strcmp(argv[a], "--ace")) {
+      peg = ace = 1;
+    } else if (!strcmp(argv[a], "--qc") && a + 1 < argc) {
+      qc_Z = atoi(argv[++a]);
+      if (qc_Z < 2) {
+        usage(argv[0]);
+        return 1;
+      }
+    } else if (!strcmp(argv[a], "--n") && a + 1 < argc) {
+      N = atoi(argv[++a]);
+    } else if (!strcmp(argv[a], "--wc") && a + 1 < argc) {
+      wc = atoi(argv[++a]);
+    } else if (!strcmp(argv[a], "--wr") && a + 1 < argc) {
+      wr = atoi(argv[++a]);
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (loop_count_max == -1)
+    loop_count_max = (peg || qc_Z) ? 1 : 10000000;
+  if (n_threads < 1 || loop_count_max < 1 || time_budget < 0.0 ||
+      (peg && qc_Z)) {
+    usage(argv[0]);
+    return 1;
+  }
 
   printf("==============================================\n");
-  printf("       LDPC Matrix Generator (Gallager)       \n");
+  printf(qc_Z  ? "      LDPC Matrix Generator (QC-LDPC)         \n"
+         : peg ? "         LDPC Matrix Generator (PEG)          \n"
+               : "       LDPC Matrix Generator (Gallager)       \n");
   printf("==============================================\n\n");
 
   /* ------------------------------------------------------------------ */
   /* User input: (N, wc, wr)                                            */
   /* ------------------------------------------------------------------ */
-  int N, wc, wr;
+  if (N <= 0 || wc <= 0 || wr <= 0) {
+    printf("Codeword length N: ");
+    scanf("%d", &N);
 
-  printf("Codeword length N: ");
-  scanf("%d", &N);
+    printf("Column weight wc (small: 2 or 3): ");
+    scanf("%d", &wc);
 
-  printf("Column weight wc (small: 2 or 3): ");
-  scanf("%d", &wc);
-
-  printf("Row weight wr (larger than wc): ");
-  scanf("%d", &wr);
+    printf("Row weight wr (larger than wc): ");
+    scanf("%d", &wr);
+  }
+  if (N <= 0 || wc <= 0 || wr <= wc) {
+    fprintf(stderr, "Invalid parameters (need N > 0, 0 < wc < wr).\n");
+    return 1;
+  }
 
   int M = (N * wc) / wr; /* number of parity-check equations */
   int K = N - M;         /* number of information bits       */
@@ -73,157 +372,238 @@ int main(void) {
 
   printf("\nRate R = %.5f (K = %d, M = %d)\n\n", R, K, M);
 
+  if (qc_Z && (N % qc_Z || M % qc_Z || M / qc_Z < 3 || wc > M / qc_Z)) {
+    fprintf(stderr, "Invalid QC lifting size %d (need Z | N, Z | M, "
+                    "M / Z >= 3, wc <= M / Z).\n",
+            qc_Z);
+    return 1;
+  }
+
   /* ------------------------------------------------------------------ */
   /* Prepare output directory                                           */
-  /*   matrices/Nxxx_wcX_wrY/                                          */
+  /*   matrices/<ID>/ (N{N}_wc{wc}_wr{wr}[_s{seed}][_peg|_ace|_qc{Z}])  */
   /* ------------------------------------------------------------------ */
-  char dirpath[128];
-  sprintf(dirpath, "matrices/N%d_wc%d_wr%d", N, wc, wr);
+  ldpc_code_key_t key;
+  memset(&key, 0, sizeof(key));
+  key.N = N;
+  key.wc = wc;
+  key.wr = wr;
+  key.seed = (loop_count_max == 1) ? seed : 0; /* search: unseeded ID */
+  key.construction = qc_Z  ? LDPC_CONSTRUCT_QC
+                     : ace ? LDPC_CONSTRUCT_PEG_ACE
+                     : peg ? LDPC_CONSTRUCT_PEG
+                           : LDPC_CONSTRUCT_GALLAGER;
+  key.Z = qc_Z;
+
+  char id[64], dirpath[128];
+  if (ldpc_code_id(&key, id, sizeof(id))) {
+    fprintf(stderr, "No registry ID for these parameters.\n");
+    return 1;
+  }
+  sprintf(dirpath, "matrices/%s", id);
+  printf("Output folder: %s\n\n", dirpath);
 
   make_dir("matrices");
   make_dir(dirpath);
 
   /* Output file paths */
   char path_H[256], path_G[256], path_info[256];
+  char path_base[256], path_bin[256];
   sprintf(path_H, "%s/H.csv", dirpath);
   sprintf(path_G, "%s/G.csv", dirpath);
   sprintf(path_info, "%s/info.txt", dirpath);
+  sprintf(path_base, "%s/base.txt", dirpath);
+  sprintf(path_bin, "%s/code.bin", dirpath);
 
   /* ------------------------------------------------------------------ */
-  /* Allocate matrices H, G and their "best" copies                     */
+  /* Allocate best H, and H/G for saving (G only ever for the best H)   */
   /* ------------------------------------------------------------------ */
-  int **H = (int **)malloc(M * sizeof(int *));
-  int **H_best = (int **)malloc(M * sizeof(int *));
-  for (int i = 0; i < M; i++) {
-    H[i] = (int *)malloc(N * sizeof(int));
-    H_best[i] = (int *)malloc(N * sizeof(int));
-  }
-
-  int **G = (int **)malloc(K * sizeof(int *));
-  int **G_best = (int **)malloc(K * sizeof(int *));
-  for (int i = 0; i < K; i++) {
-    G[i] = (int *)malloc(N * sizeof(int));
-    G_best[i] = (int *)malloc(N * sizeof(int));
+  int **H_best = alloc_matrix_int(M, N);
+  int **H_save = alloc_matrix_int(M, N);
+  int **G_save = alloc_matrix_int(K, N);
+  if (!H_best || !H_save || !G_save) {
+    fprintf(stderr, "Allocation failed.\n");
+    return 1;
   }
 
   /* ------------------------------------------------------------------ */
-  /* Search H/G matrices with minimum number of 4-cycles                */
+  /* Search H matrices with minimum number of 4-cycles                  */
   /* ------------------------------------------------------------------ */
-  const int loop_count_max = 10000000;
-  const double print_interval_sec = 1.0; /* periodic save interval   */
-
-  int loop;
-  int best_floop = -1;     /* best (minimum) number of 4-cycles */
-  long long floop_sum = 0; /* average tracking */
-
-  clock_t t_start = clock();
-  clock_t t_last_print = clock();
+  const double print_interval_sec = 1.0; /* periodic save interval */
+
+  search_t S;
+  memset(&S, 0, sizeof(S));
+  S.N = N;
+  S.wc = wc;
+  S.wr = wr;
+  S.M = M;
+  S.seed = seed;
+  S.max_candidates = loop_count_max;
+  S.time_budget = time_budget;
+  S.early_abort = early_abort;
+  S.peg = peg;
+  S.ace = ace;
+  S.qc_Z = qc_Z;
+  S.best_floop = -1;
+  S.H_best = H_best;
+  S.t_start = now_sec();
+  pthread_mutex_init(&S.lock, NULL);
 
   printf("Searching for best H/G matrices (min 4-cycles)...\n");
+  printf("Threads = %d, seed = %llu, candidates = %lld", n_threads,
+         (unsigned long long)seed, loop_count_max);
+  if (time_budget > 0.0)
+    printf(", time budget = %.1f s", time_budget);
+  printf("\n");
+
+  pthread_t *tid = (pthread_t *)malloc(n_threads * sizeof(pthread_t));
+  if (!tid) {
+    fprintf(stderr, "Allocation failed.\n");
+    return 1;
+  }
+  int started = 0;
+  S.running = n_threads;
+  for (int t = 0; t < n_threads; t++) {
+    if (pthread_create(&tid[t], NULL, search_worker, &S))
+      break;
+    started++;
+  }
+  pthread_mutex_lock(&S.lock);
+  S.running -= n_threads - started;
+  pthread_mutex_unlock(&S.lock);
+  if (started == 0) {
+    fprintf(stderr, "Cannot start worker threads.\n");
+    return 1;
+  }
 
-  for (loop = 1; loop <= loop_count_max; loop++) {
-
-    /* -------------------------------------------------------------- */
-    /* 1) Generate new H and G                                        */
-    /* -------------------------------------------------------------- */
-    generate_Hmatrix(H, N, wc, wr);
-    generate_Gmatrix(H, G, N, wc, wr);
-
-    /* -------------------------------------------------------------- */
-    /* 2) Count 4-cycles in H                                         */
-    /* -------------------------------------------------------------- */
-    int floop = count_floop(H, N, wc, wr);
-    floop_sum += floop;
-
-    /* -------------------------------------------------------------- */
-    /* 3) Update best H/G if this one has fewer 4-cycles              */
-    /* -------------------------------------------------------------- */
-    if (best_floop == -1 || floop < best_floop) {
-      best_floop = floop;
-
-      /* copy best H */
-      for (int i = 0; i < M; i++)
-        for (int j = 0; j < N; j++)
-          H_best[i][j] = H[i][j];
-
-      /* copy best G */
-      for (int i = 0; i < K; i++)
-        for (int j = 0; j < N; j++)
-          G_best[i][j] = G[i][j];
-    }
-
-    /* -------------------------------------------------------------- */
-    /* 4) Periodically save current best matrices and statistics       */
-    /* -------------------------------------------------------------- */
-    clock_t t_now = clock();
-    double elapsed = (double)(t_now - t_last_print) / CLOCKS_PER_SEC;
-
-    if (loop == 1 || elapsed > print_interval_sec) {
-
-      t_last_print = t_now;
-
-      /* Save best H as CSV (no separators, 0/1 matrix) */
-      FILE *fp = fopen(path_H, "w");
-      if (fp) {
-        for (int i = 0; i < M; i++) {
-          for (int j = 0; j < N; j++)
-            fprintf(fp, "%d", H_best[i][j]);
-          fprintf(fp, "\n");
+  /* ------------------------------------------------------------------ */
+  /* Monitor: periodically derive G for a new best and save everything  */
+  /* ------------------------------------------------------------------ */
+  int saved_version = 0;
+  double t_last_print = 0.0;
+
+  for (;;) {
+    const struct timespec nap = {0, 50 * 1000 * 1000};
+    nanosleep(&nap, NULL);
+
+    pthread_mutex_lock(&S.lock);
+    int running = S.running;
+    int version = S.best_version;
+    long long loop = S.evaluated;
+    int best_floop = S.best_floop;
+    long long best_idx = S.best_idx;
+    double avg = loop ? (double)S.floop_sum / loop : 0.0;
+    int save = version != saved_version &&
+               (running == 0 || now_sec() - t_last_print > print_interval_sec);
+    if (save)
+      copy_matrix_int(H_save, H_best, M, N);
+    pthread_mutex_unlock(&S.lock);
+
+    if (save) {
+      saved_version = version;
+      char tmp[288];
+
+      /* QC: rebuild the best base matrix from its candidate seed (H.csv
+       * below is column-permuted by generate_Gmatrix, base.txt is not) */
+      if (qc_Z) {
+        ldpc_qc_code_t *qc =
+            ldpc_qc_generate(M / qc_Z, N / qc_Z, qc_Z, wc,
+                             ldpc_candidate_seed(seed, best_idx));
+        temp_path(tmp, sizeof(tmp), path_base);
+        if (!qc || ldpc_qc_save(qc, tmp) || commit_temp(tmp, path_base)) {
+          remove(tmp);
+          fprintf(stderr, "Cannot save %s\n", path_base);
         }
-        fclose(fp);
+        ldpc_qc_destroy(qc);
       }
 
-      /* Save best G as CSV (no separators, 0/1 matrix) */
-      fp = fopen(path_G, "w");
-      if (fp) {
-        for (int i = 0; i < K; i++) {
-          for (int j = 0; j < N; j++)
-            fprintf(fp, "%d", G_best[i][j]);
-          fprintf(fp, "\n");
-        }
-        fclose(fp);
+      /* G from the best H; its column swaps are mirrored into H_save */
+      generate_Gmatrix(H_save, G_save, N, wc, wr);
+      temp_path(tmp, sizeof(tmp), path_H);
+      if (save_matrix_csv(tmp, H_save, M, N) || commit_temp(tmp, path_H)) {
+        remove(tmp);
+        fprintf(stderr, "Cannot save %s\n", path_H);
+      }
+      temp_path(tmp, sizeof(tmp), path_G);
+      if (save_matrix_csv(tmp, G_save, K, N) || commit_temp(tmp, path_G)) {
+        remove(tmp);
+        fprintf(stderr, "Cannot save %s\n", path_G);
+      }
+      temp_path(tmp, sizeof(tmp), path_bin);
+      if (ldpc_codefile_write(tmp, H_save, G_save, M, N, wc, wr) ||
+          commit_temp(tmp, path_bin)) {
+        remove(tmp);
+        fprintf(stderr, "Cannot save %s\n", path_bin);
+      }
+
+      /* girth and 6-cycles of the saved H (not part of the score) */
+      int girth = -1;
+      long long c6 = -1;
+      ldpc_graph_t *gr = ldpc_graph_create(H_save, M, N);
+      if (gr) {
+        girth = ldpc_girth(gr, NULL);
+        c6 = ldpc_count_cycles(gr, 6, NULL);
+        ldpc_graph_destroy(gr);
       }
 
       /* Save status information */
-      fp = fopen(path_info, "w");
+      temp_path(tmp, sizeof(tmp), path_info);
+      FILE *fp = fopen(tmp, "w");
       if (fp) {
         fprintf(fp, "LDPC Matrix Generation Status\n");
         fprintf(fp, "Code rate R = %.5f\n", R);
         fprintf(fp, "N = %d\n", N);
         fprintf(fp, "wc = %d\n", wc);
         fprintf(fp, "wr = %d\n", wr);
-        fprintf(fp, "Loop count = %d\n", loop);
+        fprintf(fp, "Construction = %s\n",
+                qc_Z ? "QC" : peg ? (ace ? "PEG-ACE" : "PEG") : "Gallager");
+        if (qc_Z)
+          fprintf(fp, "Lifting size Z = %d (base matrix %d x %d)\n", qc_Z,
+                  M / qc_Z, N / qc_Z);
+        fprintf(fp, "Loop count = %lld\n", loop);
         fprintf(fp, "Best 4-cycles = %d\n", best_floop);
-        fprintf(fp, "Average 4-cycles = %.3f\n", (double)floop_sum / loop);
-        fclose(fp);
+        fprintf(fp, "Average 4-cycles %s %.3f\n", early_abort ? ">=" : "=",
+                avg);
+        fprintf(fp, "Seed = %llu\n", (unsigned long long)seed);
+        fprintf(fp, "Best candidate = %lld\n", best_idx);
+        fprintf(fp, "Girth = %d\n", girth);
+        fprintf(fp, "6-cycles = %lld\n", c6);
+        if (fclose(fp) || commit_temp(tmp, path_info)) {
+          remove(tmp);
+          fprintf(stderr, "Cannot save %s\n", path_info);
+        }
       }
+    }
 
-      printf("[Loop %d] Best 4-cycles = %d, Avg = %.3f\n", loop, best_floop,
-             (double)floop_sum / loop);
+    if (save || running == 0 || now_sec() - t_last_print > print_interval_sec) {
+      t_last_print = now_sec();
+      printf("[Loop %lld] Best 4-cycles = %d, Avg %s %.3f\n", loop,
+             best_floop, early_abort ? ">=" : "=", avg);
     }
+
+    if (running == 0 && saved_version == version)
+      break;
   }
 
+  for (int t = 0; t < started; t++)
+    pthread_join(tid[t], NULL);
+  free(tid);
+  pthread_mutex_destroy(&S.lock);
+
   /* ------------------------------------------------------------------ */
   /* Cleanup                                                            */
   /* ------------------------------------------------------------------ */
-  for (int i = 0; i < M; i++) {
-    free(H[i]);
-    free(H_best[i]);
-  }
-  free(H);
-  free(H_best);
+  free_matrix_int(H_best, M);
+  free_matrix_int(H_save, M);
+  free_matrix_int(G_save, K);
 
-  for (int i = 0; i < K; i++) {
-    free(G[i]);
-    free(G_best[i]);
+  if (S.failed) {
+    fprintf(stderr, "Worker allocation failed.\n");
+    return 1;
   }
-  free(G);
-  free(G_best);
 
   printf("\nGeneration completed.\n");
   printf("Files saved under directory: %s\n", dirpath);
 
-  (void)t_start; /* currently unused; kept for potential profiling */
-
   return 0;
 }
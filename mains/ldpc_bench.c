@@ -0,0 +1,1132 @@
+/**
+ * @file ldpc_bench.c
+ * @brief Throughput benchmarks of the encoders, decoders and code setup.
+ *
+ * For every code (resolved through the registry, ldpc_registry.h) the
+ * program measures
+ *
+ *   - setup  : code.bin open + decoder context, H.csv parse (if present),
+ *              generate_Gmatrix() and count_floop() on the expanded H
+ *   - encode : packed, int-per-bit and sparse encoder, information Mbit/s
+ *   - decode : frames/s and information Mbit/s at an operating point
+ *              (--ebno, early termination on a zero syndrome) for the
+ *              scalar decoder (every kernel × flooding / layered), the
+ *              SIMD batch decoder (every kernel × --batch lanes), the
+ *              fixed-point decoder (int8 / int16 messages), the worker
+ *              pool and the GPU backend when a device is present; every
+ *              CPU variant runs with each --threads count, one decoder
+ *              context per thread over the shared graph
+ *   - kernel : the same decoders on pure-noise frames that never converge,
+ *              so every frame runs exactly --iter iterations; reported as
+ *              ns per edge per iteration (one thread). The scalar decoder
+ *              also runs with its degree-specialized sweeps disabled
+ *              (variant scalar_generic) to show their gain
+ *   Both decoder groups end with a "batch/scalar spa" line: batch SPA
+ *   frames/s over scalar flooding SPA, per lane count and thread count
+ *
+ * Every measurement repeats its unit of work for at least --time seconds.
+ * Frames are generated once per code (random information words, BPSK /
+ * AWGN from a fixed seed) and reused, so decoders see identical inputs.
+ *
+ * Results go to stdout as a table and, machine-readable, to --csv / --json
+ * (one record per measurement). --label tags the records (e.g. a commit
+ * hash). --baseline reads a CSV of an earlier run, prints the relative
+ * change of every matching measurement and exits with status 2 if one
+ * got slower by more than --tolerance percent.
+ *
+ * Usage:
+ *   ldpc_bench [--codes ID,ID,...] [--root DIR] [--threads T,T,...]
+ *              [--batch L,L,...] [--gpu-batch F,F,...] [--ebno DB]
+ *              [--iter N] [--time SEC] [--frames F] [--label STR]
+ *              [--csv FILE] [--json FILE] [--baseline FILE]
+ *              [--tolerance PCT] [--only GROUP,...]
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime() under -std=c99 */
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include "ldpc_batch.h"
+#include "ldpc_channel.h"
+#include "ldpc_codefile.h"
+#include "ldpc_decoder.h"
+#include "ldpc_encoder.h"
+#include "ldpc_fixed.h"
+#include "ldpc_gpu.h"
+#include "ldpc_matrix.h"
+#include "ldpc_pool.h"
+#include "ldpc_registry.h"
+#include "ldpc_sparse_encoder.h"
+
+/* ============================================================
+ * Defaults
+ * ============================================================ */
+#define BENCH_CODES "N1024_wc3_wr6,N2048_wc3_wr6,N4096_wc3_wr6_peg"
+#define BENCH_FRAMES 256 /* generated frames per code (multiple of 32) */
+#define BENCH_MAX_LIST 16
+#define BENCH_SEED 1
+
+static const double nms_alpha = 0.75;
+static const double oms_beta = 0.5;
+static const ldpc_qformat_t q_fixed8 = {6, 8, 12, 2};
+static const ldpc_qformat_t q_fixed16 = {8, 12, 16, 3};
+
+/* ============================================================
+ * Utilities
+ * ============================================================ */
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static int **alloc_matrix_int(int rows, int cols) {
+  int **m = (int **)malloc(rows * sizeof(int *));
+  for (int i = 0; i < rows; i++)
+    m[i] = (int *)malloc(cols * sizeof(int));
+  return m;
+}
+
+static void free_matrix_int(int **m, int rows) {
+  for (int i = 0; i < rows; i++)
+    free(m[i]);
+  free(m);
+}
+
+static int default_thread_count(void) {
+#if defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n > 0)
+    return (int)n;
+#endif
+  return 1;
+}
+
+/* "1,2,4" -> {1, 2, 4}; returns the count, 0 on a malformed list */
+static int parse_int_list(const char *s, int *out, int max) {
+  int n = 0;
+  while (*s && n < max) {
+    char *end;
+    long v = strtol(s, &end, 10);
+    if (end == s || v < 1)
+      return 0;
+    out[n++] = (int)v;
+    s = (*end == ',') ? end + 1 : end;
+    if (*end && *end != ',')
+      return 0;
+  }
+  return n;
+}
+
+/* comma-separated list membership ("decode,kernel" contains "kernel") */
+static int list_has(const char *list, const char *item) {
+  if (!list)
+    return 1;
+  const size_t n = strlen(item);
+  for (const char *p = list; *p;) {
+    const char *end = strchr(p, ',');
+    const size_t len = end ? (size_t)(end - p) : strlen(p);
+    if (len == n && !strncmp(p, item, n))
+      return 1;
+    p += len + (end != NULL);
+  }
+  return 0;
+}
+
+static const char *kernel_name(ldpc_kernel_t k) {
+  switch (k) {
+  case LDPC_KERNEL_SPA:
+    return "spa";
+  case LDPC_KERNEL_MIN_SUM:
+    return "ms";
+  case LDPC_KERNEL_NMS:
+    return "nms";
+  default:
+    return "oms";
+  }
+}
+
+static double kernel_param(ldpc_kernel_t k) {
+  return k == LDPC_KERNEL_NMS ? nms_alpha
+                              : (k == LDPC_KERNEL_OMS ? oms_beta : 0.0);
+}
+
+/* ============================================================
+ * Records
+ * ============================================================ */
+typedef struct {
+  char code[64];
+  int N, K, E;
+  char bench[16];   /* setup, encode, decode, kernel            */
+  char variant[16]; /* codefile, scalar, batch, fixed8, pool, ... */
+  char kernel[8];   /* spa, ms, nms, oms or "-"                 */
+  char schedule[12];
+  int threads, batch;
+  long long frames; /* units of work (frames or operations)     */
+  double seconds;   /* wall time of the measurement             */
+  double fps;       /* frames (operations) per second           */
+  double mbps;      /* information Mbit/s, < 0: n/a             */
+  double ns_edge;   /* ns per edge per iteration, < 0: n/a      */
+} record_t;
+
+typedef struct {
+  record_t *r;
+  int n, cap;
+} record_list_t;
+
+typedef struct {
+  char id[64];
+  int N, K, E;
+} code_info_t;
+
+static record_t *record_add(record_list_t *list, const code_info_t *c,
+                            const char *bench, const char *variant,
+                            const char *kernel, const char *schedule,
+                            int threads, int batch) {
+  if (list->n == list->cap) {
+    const int cap = list->cap ? 2 * list->cap : 64;
+    record_t *r = (record_t *)realloc(list->r, cap * sizeof(record_t));
+    if (!r)
+      return NULL;
+    list->r = r;
+    list->cap = cap;
+  }
+  record_t *r = &list->r[list->n++];
+  memset(r, 0, sizeof(*r));
+  snprintf(r->code, sizeof(r->code), "%s", c->id);
+  r->N = c->N;
+  r->K = c->K;
+  r->E = c->E;
+  snprintf(r->bench, sizeof(r->bench), "%s", bench);
+  snprintf(r->variant, sizeof(r->variant), "%s", variant);
+  snprintf(r->kernel, sizeof(r->kernel), "%s", kernel);
+  snprintf(r->schedule, sizeof(r->schedule), "%s", schedule);
+  r->threads = threads;
+  r->batch = batch;
+  r->mbps = -1.0;
+  r->ns_edge = -1.0;
+  return r;
+}
+
+/* fill the rates of a measurement; iters > 0: fixed iteration count */
+static void record_finish(record_t *r, long long frames, double seconds,
+                          int info_bits, int iters) {
+  r->frames = frames;
+  r->seconds = seconds;
+  r->fps = seconds > 0.0 ? (double)frames / seconds : 0.0;
+  if (info_bits > 0)
+    r->mbps = r->fps * info_bits * 1e-6;
+  if (iters > 0 && frames > 0)
+    r->ns_edge = seconds * 1e9 / ((double)frames * iters * r->E);
+
+  printf("  %-6s %-11s %-4s %-8s T=%-2d B=%-5d %10.1f /s", r->bench,
+         r->variant, r->kernel, r->schedule, r->threads, r->batch, r->fps);
+  if (r->mbps >= 0.0)
+    printf("  %9.2f Mbit/s", r->mbps);
+  if (r->ns_edge >= 0.0)
+    printf("  %7.3f ns/edge/iter", r->ns_edge);
+  if (info_bits <= 0)
+    printf("  %9.3f ms", 1e3 * seconds / (frames > 0 ? frames : 1));
+  printf("\n");
+  fflush(stdout);
+}
+
+/* ============================================================
+ * Frames
+ * ============================================================ */
+typedef struct {
+  int n;       /* frames                */
+  int *inf;    /* [n][K] info bits      */
+  double *llr; /* [n][N] channel LLRs   */
+  float *llrf; /* [n][N] same, float    */
+} frames_t;
+
+static void frames_free(frames_t *fr) {
+  free(fr->inf);
+  free(fr->llr);
+  free(fr->llrf);
+  memset(fr, 0, sizeof(*fr));
+}
+
+/* n frames at EbN0_dB; enc == NULL: all-zero codewords */
+static int frames_make(frames_t *fr, const ldpc_packed_encoder_t *enc, int N,
+                       int K, int n, double EbN0_dB, uint64_t seed) {
+  int *code = (int *)malloc(N * sizeof(int));
+  fr->n = n;
+  fr->inf = (int *)calloc((size_t)n * K, sizeof(int));
+  fr->llr = (double *)malloc((size_t)n * N * sizeof(double));
+  fr->llrf = (float *)malloc((size_t)n * N * sizeof(float));
+  if (!code || !fr->inf || !fr->llr || !fr->llrf) {
+    free(code);
+    frames_free(fr);
+    return -1;
+  }
+
+  ldpc_rng_t rng;
+  ldpc_awgn_t ch;
+  ldpc_rng_seed(&rng, seed);
+  ldpc_awgn_init(&ch, ldpc_awgn_sigma2(EbN0_dB, (double)K / N));
+  for (int f = 0; f < n; f++) {
+    int *inf = fr->inf + (size_t)f * K;
+    if (enc) {
+      ldpc_rng_bits(&rng, inf, K);
+      ldpc_encode_bits(enc, code, inf);
+    } else {
+      memset(code, 0, N * sizeof(int));
+    }
+    ldpc_awgn_bpsk(&ch, &rng, code, NULL, fr->llr + (size_t)f * N, N);
+  }
+  for (size_t i = 0; i < (size_t)n * N; i++)
+    fr->llrf[i] = (float)fr->llr[i];
+  free(code);
+  return 0;
+}
+
+/* ============================================================
+ * Multi-threaded decoder runs
+ * ============================================================ */
+typedef enum {
+  DEC_SCALAR = 0, /* ldpc_decoder_decode()      */
+  DEC_BATCH,      /* ldpc_batch_decode_float()  */
+  DEC_FIXED8,     /* ldpc_fixed_decode(), int8  */
+  DEC_FIXED16     /* ldpc_fixed_decode(), int16 */
+} dec_type_t;
+
+typedef struct {
+  const ldpc_code_t *code;
+  const frames_t *fr;
+  dec_type_t type;
+  ldpc_kernel_t kernel;
+  ldpc_schedule_t schedule;
+  int generic; /* scalar: force the generic (non-specialized) sweeps */
+  int lanes;
+  int max_iter;
+  double min_time;
+
+  /* start gate: workers set up their contexts, then run together */
+  pthread_mutex_t lock;
+  pthread_cond_t cv;
+  int ready, total, failed;
+  double t0, deadline;
+} run_t;
+
+typedef struct {
+  run_t *run;
+  int tid;
+  long long frames;
+  double t_end;
+  pthread_t th;
+} worker_t;
+
+static void gate_wait(run_t *run, int ok) {
+  pthread_mutex_lock(&run->lock);
+  run->failed |= !ok;
+  if (++run->ready == run->total) {
+    run->t0 = now_sec();
+    run->deadline = run->t0 + run->min_time;
+    pthread_cond_broadcast(&run->cv);
+  } else {
+    while (run->ready < run->total)
+      pthread_cond_wait(&run->cv, &run->lock);
+  }
+  pthread_mutex_unlock(&run->lock);
+}
+
+static void *worker_main(void *arg) {
+  worker_t *w = (worker_t *)arg;
+  run_t *run = w->run;
+  const frames_t *fr = run->fr;
+  const int N = run->code->N, K = run->code->K;
+  const double param = kernel_param(run->kernel);
+
+  ldpc_decoder_t *dec = ldpc_code_decoder(run->code);
+  ldpc_batch_t *batch = NULL;
+  ldpc_fixed_t *fx = NULL;
+  int16_t *Lq = NULL;
+  int *ecc = (int *)malloc((size_t)LDPC_BATCH_MAX_LANES * N * sizeof(int));
+  int *inf = (int *)malloc((size_t)LDPC_BATCH_MAX_LANES * K * sizeof(int));
+  int ok = dec && ecc && inf;
+
+  if (ok && run->type == DEC_SCALAR) {
+    ok = !ldpc_decoder_set_kernel(dec, run->kernel, param) &&
+         !ldpc_decoder_set_schedule(dec, run->schedule);
+    if (run->generic)
+      ldpc_decoder_set_specialized(dec, 0);
+  } else if (ok && run->type == DEC_BATCH) {
+    batch = ldpc_batch_create(dec, run->lanes);
+    ok = batch && !ldpc_batch_set_kernel(batch, run->kernel, param);
+  } else if (ok) {
+    fx = ldpc_fixed_create(dec, run->type == DEC_FIXED8 ? &q_fixed8
+                                                        : &q_fixed16);
+    Lq = (int16_t *)malloc((size_t)fr->n * N * sizeof(int16_t));
+    ok = fx && Lq && !ldpc_fixed_set_kernel(fx, run->kernel, param);
+    if (ok)
+      ldpc_fixed_quantize(fx, fr->llr, Lq, fr->n * N);
+  }
+
+  gate_wait(run, ok);
+
+  /* threads start at different frames so they do not decode in lockstep */
+  int f = (w->tid * 37) % fr->n;
+  long long frames = 0;
+  if (!run->failed) {
+    do {
+      switch (run->type) {
+      case DEC_SCALAR:
+        ldpc_decoder_decode(dec, fr->llr + (size_t)f * N, ecc, inf,
+                            run->max_iter);
+        f = (f + 1) % fr->n;
+        frames++;
+        break;
+      case DEC_BATCH:
+        f -= f % run->lanes;
+        ldpc_batch_decode_float(batch, fr->llrf + (size_t)f * N, run->lanes,
+                                ecc, inf, NULL, run->max_iter);
+        f = (f + run->lanes) % fr->n;
+        frames += run->lanes;
+        break;
+      default:
+        ldpc_fixed_decode(fx, Lq + (size_t)f * N, ecc, inf, run->max_iter);
+        f = (f + 1) % fr->n;
+        frames++;
+        break;
+      }
+    } while (now_sec() < run->deadline);
+  }
+  w->frames = frames;
+  w->t_end = now_sec();
+
+  free(Lq);
+  ldpc_fixed_destroy(fx);
+  ldpc_batch_destroy(batch);
+  ldpc_decoder_destroy(dec);
+  free(ecc);
+  free(inf);
+  return NULL;
+}
+
+/* run one variant on n_threads threads; returns -1 if a context failed */
+static int run_decoders(run_t *run, int n_threads, long long *frames,
+                        double *seconds) {
+  worker_t *w = (worker_t *)calloc(n_threads, sizeof(worker_t));
+  if (!w)
+    return -1;
+  pthread_mutex_init(&run->lock, NULL);
+  pthread_cond_init(&run->cv, NULL);
+  run->ready = 0;
+  run->total = n_threads;
+  run->failed = 0;
+
+  int started = 0;
+  for (; started < n_threads; started++) {
+    w[started].run = run;
+    w[started].tid = started;
+    if (pthread_create(&w[started].th, NULL, worker_main, &w[started]))
+      break;
+  }
+  if (started < n_threads) {
+    /* release the started workers without running */
+    pthread_mutex_lock(&run->lock);
+    run->failed = 1;
+    run->total = run->ready = started;
+    pthread_cond_broadcast(&run->cv);
+    pthread_mutex_unlock(&run->lock);
+  }
+
+  double t_end = 0.0;
+  *frames = 0;
+  for (int t = 0; t < started; t++) {
+    pthread_join(w[t].th, NULL);
+    *frames += w[t].frames;
+    if (w[t].t_end > t_end)
+      t_end = w[t].t_end;
+  }
+  *seconds = t_end - run->t0;
+
+  pthread_cond_destroy(&run->cv);
+  pthread_mutex_destroy(&run->lock);
+  free(w);
+  return run->failed ? -1 : 0;
+}
+
+/* ============================================================
+ * Benchmark groups
+ * ============================================================ */
+typedef struct {
+  const char *root;
+  int threads[BENCH_MAX_LIST], n_threads;
+  int lanes[BENCH_MAX_LIST], n_lanes;
+  int gpu_frames[BENCH_MAX_LIST], n_gpu_frames;
+  double EbN0_dB;
+  int max_iter;
+  double min_time;
+  int n_frames;
+  const char *only; /* groups to run, NULL: all */
+} bench_opts_t;
+
+static void bench_setup(record_list_t *out, const bench_opts_t *o,
+                        const code_info_t *ci, const ldpc_code_t *code) {
+  const ldpc_codefile_t *cf = code->cf;
+  const int M = code->M, N = code->N, K = code->K;
+  char path[512];
+  record_t *r;
+  double t0, t;
+  long long n;
+
+  /* code.bin: map + verify + decoder context over the mapping */
+  snprintf(path, sizeof(path), "%s/%s/code.bin", o->root, code->id);
+  n = 0;
+  t0 = now_sec();
+  do {
+    ldpc_codefile_t *f = ldpc_codefile_open(path);
+    ldpc_decoder_t *dec = f ? ldpc_codefile_decoder(f) : NULL;
+    ldpc_decoder_destroy(dec);
+    ldpc_codefile_close(f);
+    if (!f)
+      break;
+    n++;
+  } while ((t = now_sec() - t0) < o->min_time);
+  if (n && (r = record_add(out, ci, "setup", "codefile", "-", "-", 1, 1)))
+    record_finish(r, n, t, 0, 0);
+
+  int **H = alloc_matrix_int(M, N);
+  int **G = alloc_matrix_int(K, N);
+
+  /* H.csv parse (CSV-only folders) */
+  snprintf(path, sizeof(path), "%s/%s/H.csv", o->root, code->id);
+  n = 0;
+  t0 = now_sec();
+  do {
+    if (ldpc_load_matrix_csv(H, M, N, path) != 0)
+      break;
+    n++;
+  } while ((t = now_sec() - t0) < o->min_time);
+  if (n && (r = record_add(out, ci, "setup", "csv", "-", "-", 1, 1)))
+    record_finish(r, n, t, 0, 0);
+
+  ldpc_codefile_expand_H(cf, H);
+  n = 0;
+  t0 = now_sec();
+  do {
+    (void)count_floop(H, N, cf->wc, cf->wr);
+    n++;
+  } while ((t = now_sec() - t0) < o->min_time);
+  if ((r = record_add(out, ci, "setup", "count_floop", "-", "-", 1, 1)))
+    record_finish(r, n, t, 0, 0);
+
+  /* generate_Gmatrix() permutes H: fresh expanded copy per run (untimed) */
+  n = 0;
+  t = 0.0;
+  do {
+    ldpc_codefile_expand_H(cf, H);
+    t0 = now_sec();
+    generate_Gmatrix(H, G, N, cf->wc, cf->wr);
+    t += now_sec() - t0;
+    n++;
+  } while (t < o->min_time);
+  if ((r = record_add(out, ci, "setup", "gmatrix", "-", "-", 1, 1)))
+    record_finish(r, n, t, 0, 0);
+
+  free_matrix_int(G, K);
+  free_matrix_int(H, M);
+}
+
+static void bench_encode(record_list_t *out, const bench_opts_t *o,
+                         const code_info_t *ci, const ldpc_code_t *code,
+                         const ldpc_packed_encoder_t *enc,
+                         const frames_t *fr) {
+  const int M = code->M, N = code->N, K = code->K;
+  const int nf = fr->n;
+  uint64_t *pinf = (uint64_t *)calloc((size_t)nf * LDPC_WORDS(K), 8);
+  uint64_t *pecc = (uint64_t *)malloc(LDPC_WORDS(N) * sizeof(uint64_t));
+  int *ecc = (int *)malloc(N * sizeof(int));
+  record_t *r;
+  long long n;
+  double t0;
+
+  if (!pinf || !pecc || !ecc)
+    goto done;
+  for (int f = 0; f < nf; f++)
+    ldpc_pack_bits(pinf + (size_t)f * LDPC_WORDS(K), fr->inf + (size_t)f * K,
+                   K);
+
+  if (enc) {
+    n = 0;
+    t0 = now_sec();
+    do {
+      ldpc_encode_packed(enc, pecc, pinf + (size_t)(n % nf) * LDPC_WORDS(K));
+      n++;
+    } while (now_sec() - t0 < o->min_time);
+    if ((r = record_add(out, ci, "encode", "packed", "-", "-", 1, 1)))
+      record_finish(r, n, now_sec() - t0, K, 0);
+
+    n = 0;
+    t0 = now_sec();
+    do {
+      ldpc_encode_bits(enc, ecc, fr->inf + (size_t)(n % nf) * K);
+      n++;
+    } while (now_sec() - t0 < o->min_time);
+    if ((r = record_add(out, ci, "encode", "bits", "-", "-", 1, 1)))
+      record_finish(r, n, now_sec() - t0, K, 0);
+  }
+
+  int **H = alloc_matrix_int(M, N);
+  ldpc_codefile_expand_H(code->cf, H);
+  ldpc_sparse_encoder_t *senc = ldpc_sparse_encoder_create(H, M, N, K);
+  free_matrix_int(H, M);
+  if (senc && !ldpc_sparse_encode(senc, ecc, fr->inf)) {
+    n = 0;
+    t0 = now_sec();
+    do {
+      ldpc_sparse_encode(senc, ecc, fr->inf + (size_t)(n % nf) * K);
+      n++;
+    } while (now_sec() - t0 < o->min_time);
+    if ((r = record_add(out, ci, "encode", "sparse", "-", "-", 1, 1)))
+      record_finish(r, n, now_sec() - t0, K, 0);
+  }
+  ldpc_sparse_encoder_destroy(senc);
+
+done:
+  free(pinf);
+  free(pecc);
+  free(ecc);
+}
+
+static void run_variant(record_list_t *out, const code_info_t *ci,
+                        run_t *run, const char *bench, const char *variant,
+                        int n_threads, int iters) {
+  const int layered =
+      run->type == DEC_SCALAR && run->schedule == LDPC_SCHEDULE_LAYERED;
+  long long frames;
+  double seconds;
+  if (run_decoders(run, n_threads, &frames, &seconds) < 0) {
+    fprintf(stderr, "%s %s %s: decoder setup failed\n", ci->id, variant,
+            kernel_name(run->kernel));
+    return;
+  }
+  record_t *r = record_add(out, ci, bench, variant, kernel_name(run->kernel),
+                           layered ? "layered" : "flooding", n_threads,
+                           run->type == DEC_BATCH ? run->lanes : 1);
+  if (r)
+    record_finish(r, frames, seconds, ci->K, iters);
+}
+
+/*
+ * Batch SPA throughput relative to scalar flooding SPA at the same thread
+ * count, from the records list->r[first ..] (the batch decoder has a
+ * flooding schedule only).
+ */
+static void print_batch_gain(const record_list_t *list, int first) {
+  for (int i = first; i < list->n; i++) {
+    const record_t *s = &list->r[i];
+    if (strcmp(s->variant, "scalar") || strcmp(s->kernel, "spa") ||
+        strcmp(s->schedule, "flooding") || s->fps <= 0.0)
+      continue;
+    printf("  %-6s batch/scalar spa   T=%-2d", s->bench, s->threads);
+    for (int j = first; j < list->n; j++) {
+      const record_t *b = &list->r[j];
+      if (!strcmp(b->variant, "batch") && !strcmp(b->kernel, "spa") &&
+          b->threads == s->threads)
+        printf("  B=%d %.2fx", b->batch, b->fps / s->fps);
+    }
+    printf("\n");
+  }
+}
+
+/*
+ * Every CPU decoder variant on `fr`. kernel == 1: one thread, fixed
+ * iteration count (ns/edge/iter); else every thread count.
+ */
+static void bench_decoders(record_list_t *out, const bench_opts_t *o,
+                           const code_info_t *ci, const ldpc_code_t *code,
+                           const frames_t *fr, int kernel) {
+  static const ldpc_kernel_t kernels[] = {LDPC_KERNEL_SPA,
+                                          LDPC_KERNEL_MIN_SUM, LDPC_KERNEL_NMS,
+                                          LDPC_KERNEL_OMS};
+  const char *bench = kernel ? "kernel" : "decode";
+  const int n_t = kernel ? 1 : o->n_threads;
+  const int iters = kernel ? o->max_iter : 0;
+  run_t run;
+  memset(&run, 0, sizeof(run));
+  run.code = code;
+  run.fr = fr;
+  run.max_iter = o->max_iter;
+  run.min_time = o->min_time;
+  const int first = out->n;
+
+  for (int ti = 0; ti < n_t; ti++) {
+    const int T = kernel ? 1 : o->threads[ti];
+    for (int k = 0; k < 4; k++) {
+      run.kernel = kernels[k];
+      run.type = DEC_SCALAR;
+      run.schedule = LDPC_SCHEDULE_FLOODING;
+      run_variant(out, ci, &run, bench, "scalar", T, iters);
+      run.schedule = LDPC_SCHEDULE_LAYERED;
+      run_variant(out, ci, &run, bench, "scalar", T, iters);
+      if (kernel) {
+        /* same decoder with the degree-specialized sweeps disabled */
+        run.generic = 1;
+        run.schedule = LDPC_SCHEDULE_FLOODING;
+        run_variant(out, ci, &run, bench, "scalar_generic", T, iters);
+        run.schedule = LDPC_SCHEDULE_LAYERED;
+        run_variant(out, ci, &run, bench, "scalar_generic", T, iters);
+        run.generic = 0;
+      }
+
+      run.type = DEC_BATCH;
+      for (int li = 0; li < o->n_lanes; li++) {
+        run.lanes = o->lanes[li];
+        run_variant(out, ci, &run, bench, "batch", T, iters);
+      }
+
+      if (kernels[k] == LDPC_KERNEL_SPA)
+        continue; /* fixed point: min-sum family only */
+      run.type = DEC_FIXED8;
+      run_variant(out, ci, &run, bench, "fixed8", T, iters);
+      run.type = DEC_FIXED16;
+      run_variant(out, ci, &run, bench, "fixed16", T, iters);
+    }
+  }
+  print_batch_gain(out, first);
+}
+
+/* worker pool: one producer (this thread), n_workers decoding threads */
+static void bench_pool(record_list_t *out, const bench_opts_t *o,
+                       const code_info_t *ci, const ldpc_code_t *code,
+                       const frames_t *fr) {
+  ldpc_decoder_t *tmpl = ldpc_code_decoder(code);
+  if (!tmpl)
+    return;
+  for (int ti = 0; ti < o->n_threads; ti++) {
+    const int T = o->threads[ti];
+    ldpc_pool_t *pool = ldpc_pool_create(tmpl, T, 16 * T, 0, o->max_iter);
+    if (!pool) {
+      fprintf(stderr, "%s pool: create failed\n", ci->id);
+      continue;
+    }
+    ldpc_pool_result_t res;
+    long long done = 0;
+    int f = 0;
+    const double t0 = now_sec();
+    double t;
+    do {
+      while (ldpc_pool_submit(pool, fr->llr + (size_t)f * code->N, NULL) >= 0)
+        f = (f + 1) % fr->n;
+      if (ldpc_pool_wait(pool, &res, NULL, NULL))
+        done++;
+      while (ldpc_pool_poll(pool, &res, NULL, NULL))
+        done++;
+    } while ((t = now_sec() - t0) < o->min_time);
+    ldpc_pool_destroy(pool);
+
+    record_t *r = record_add(out, ci, "decode", "pool", "spa", "flooding", T,
+                             1);
+    if (r)
+      record_finish(r, done, t, code->K, 0);
+  }
+  ldpc_decoder_destroy(tmpl);
+}
+
+/* GPU backend, double-buffered submissions of F frames */
+static void bench_gpu(record_list_t *out, const bench_opts_t *o,
+                      const code_info_t *ci, const ldpc_code_t *code,
+                      const frames_t *fr) {
+  static const ldpc_kernel_t kernels[] = {LDPC_KERNEL_SPA,
+                                          LDPC_KERNEL_MIN_SUM, LDPC_KERNEL_NMS,
+                                          LDPC_KERNEL_OMS};
+  const int N = code->N;
+  ldpc_decoder_t *tmpl = ldpc_code_decoder(code);
+  if (!tmpl)
+    return;
+  for (int bi = 0; bi < o->n_gpu_frames; bi++) {
+    const int F = o->gpu_frames[bi];
+    ldpc_gpu_t *g = ldpc_gpu_create(tmpl, F, 0);
+    if (!g) {
+      fprintf(stderr, "%s gpu: create failed (F = %d)\n", ci->id, F);
+      continue;
+    }
+    for (int k = 0; k < 4; k++) {
+      if (ldpc_gpu_set_kernel(g, kernels[k], kernel_param(kernels[k])) < 0)
+        continue;
+      long long frames = 0;
+      int ok = 1, inflight = 0;
+      const double t0 = now_sec();
+      double t;
+      do {
+        float *in;
+        while (inflight < 2 && (in = ldpc_gpu_input(g))) {
+          for (int i = 0; i < F; i++)
+            memcpy(in + (size_t)i * N, fr->llrf + (size_t)(i % fr->n) * N,
+                   N * sizeof(float));
+          if (ldpc_gpu_submit(g, NULL, F, o->max_iter) < 0) {
+            ok = 0;
+            break;
+          }
+          inflight++;
+        }
+        if (!ok || ldpc_gpu_collect(g, NULL, NULL, NULL) < 0) {
+          ok = 0;
+          break;
+        }
+        inflight--;
+        frames += F;
+      } while ((t = now_sec() - t0) < o->min_time);
+      while (inflight-- > 0)
+        ldpc_gpu_collect(g, NULL, NULL, NULL);
+      t = now_sec() - t0;
+
+      record_t *r;
+      if (ok && (r = record_add(out, ci, "decode", "gpu",
+                                kernel_name(kernels[k]), "flooding", 1, F)))
+        record_finish(r, frames, t, code->K, 0);
+    }
+    ldpc_gpu_destroy(g);
+  }
+  ldpc_decoder_destroy(tmpl);
+}
+
+/**
+ * @brief Print which degree-specialized sweeps the scalar decoder picked.
+ */
+static void print_sweeps(const ldpc_code_t *code) {
+  ldpc_decoder_t *dec = ldpc_code_decoder(code);
+  if (!dec)
+    return;
+  printf("  sweeps: check ");
+  if (dec->spec_c)
+    printf("d=%d (%d/%d rows)", dec->spec_c, dec->ndeg_c, dec->M);
+  else
+    printf("generic");
+  printf(", variable ");
+  if (dec->spec_v)
+    printf("d=%d (%d/%d columns)", dec->spec_v, dec->ndeg_v, dec->N);
+  else
+    printf("generic");
+  printf("\n");
+  ldpc_decoder_destroy(dec);
+}
+
+static int bench_code(record_list_t *out, const bench_opts_t *o,
+                      ldpc_registry_t *reg, const char *id) {
+  const double t0 = now_sec();
+  const ldpc_code_t *code = ldpc_registry_get_id(reg, id);
+  if (!code) {
+    fprintf(stderr, "%s: code not found / build failed\n", id);
+    return -1;
+  }
+  code_info_t ci;
+  snprintf(ci.id, sizeof(ci.id), "%s", code->id);
+  ci.N = code->N;
+  ci.K = code->K;
+  ci.E = code->cf->E;
+  printf("%s: N = %d, K = %d, E = %d (lookup %.3f s)\n", ci.id, ci.N, ci.K,
+         ci.E, now_sec() - t0);
+  print_sweeps(code);
+
+  ldpc_packed_encoder_t *enc = ldpc_code_encoder(code);
+  frames_t fr, noise;
+  memset(&noise, 0, sizeof(noise));
+  if (frames_make(&fr, enc, ci.N, ci.K, o->n_frames, o->EbN0_dB,
+                  BENCH_SEED) < 0 ||
+      frames_make(&noise, NULL, ci.N, ci.K, o->n_frames, -5.0,
+                  BENCH_SEED + 1) < 0) {
+    fprintf(stderr, "%s: out of memory\n", ci.id);
+    frames_free(&fr);
+    ldpc_packed_encoder_destroy(enc);
+    return -1;
+  }
+
+  if (list_has(o->only, "setup"))
+    bench_setup(out, o, &ci, code);
+  if (list_has(o->only, "encode"))
+    bench_encode(out, o, &ci, code, enc, &fr);
+  if (list_has(o->only, "decode")) {
+    bench_decoders(out, o, &ci, code, &fr, 0);
+    bench_pool(out, o, &ci, code, &fr);
+    if (ldpc_gpu_device_count() > 0)
+      bench_gpu(out, o, &ci, code, &fr);
+  }
+  if (list_has(o->only, "kernel"))
+    bench_decoders(out, o, &ci, code, &noise, 1);
+
+  frames_free(&noise);
+  frames_free(&fr);
+  ldpc_packed_encoder_destroy(enc);
+  return 0;
+}
+
+/* ============================================================
+ * Output
+ * ============================================================ */
+static const char csv_header[] =
+    "label,code,N,K,E,bench,variant,kernel,schedule,threads,batch,frames,"
+    "seconds,frames_per_s,mbit_per_s,ns_per_edge_iter";
+
+static int write_csv(const char *path, const record_list_t *list,
+                     const char *label) {
+  FILE *fp = fopen(path, "w");
+  if (!fp)
+    return -1;
+  fprintf(fp, "%s\n", csv_header);
+  for (int i = 0; i < list->n; i++) {
+    const record_t *r = &list->r[i];
+    fprintf(fp, "%s,%s,%d,%d,%d,%s,%s,%s,%s,%d,%d,%lld,%.6f,%.3f,", label,
+            r->code, r->N, r->K, r->E, r->bench, r->variant, r->kernel,
+            r->schedule, r->threads, r->batch, r->frames, r->seconds, r->fps);
+    if (r->mbps >= 0.0)
+      fprintf(fp, "%.4f", r->mbps);
+    fprintf(fp, ",");
+    if (r->ns_edge >= 0.0)
+      fprintf(fp, "%.4f", r->ns_edge);
+    fprintf(fp, "\n");
+  }
+  return fclose(fp) ? -1 : 0;
+}
+
+static int write_json(const char *path, const record_list_t *list,
+                      const char *label, const bench_opts_t *o) {
+  FILE *fp = fopen(path, "w");
+  if (!fp)
+    return -1;
+  fprintf(fp, "{\n  \"label\": \"%s\",\n  \"ebno_db\": %.2f,\n", label,
+          o->EbN0_dB);
+  fprintf(fp, "  \"max_iter\": %d,\n  \"min_time\": %.3f,\n", o->max_iter,
+          o->min_time);
+  fprintf(fp, "  \"results\": [");
+  for (int i = 0; i < list->n; i++) {
+    const record_t *r = &list->r[i];
+    fprintf(fp, "%s\n    {\"code\": \"%s\", \"N\": %d, \"K\": %d, ",
+            i ? "," : "", r->code, r->N, r->K);
+    fprintf(fp, "\"E\": %d, \"bench\": \"%s\", \"variant\": \"%s\", ", r->E,
+            r->bench, r->variant);
+    fprintf(fp, "\"kernel\": \"%s\", \"schedule\": \"%s\", ", r->kernel,
+            r->schedule);
+    fprintf(fp, "\"threads\": %d, \"batch\": %d, \"frames\": %lld, ",
+            r->threads, r->batch, r->frames);
+    fprintf(fp, "\"seconds\": %.6f, \"frames_per_s\": %.3f, ", r->seconds,
+            r->fps);
+    if (r->mbps >= 0.0)
+      fprintf(fp, "\"mbit_per_s\": %.4f, ", r->mbps);
+    else
+      fprintf(fp, "\"mbit_per_s\": null, ");
+    if (r->ns_edge >= 0.0)
+      fprintf(fp, "\"ns_per_edge_iter\": %.4f}", r->ns_edge);
+    else
+      fprintf(fp, "\"ns_per_edge_iter\": null}");
+  }
+  fprintf(fp, "\n  ]\n}\n");
+  return fclose(fp) ? -1 : 0;
+}
+
+/* ============================================================
+ * Baseline comparison
+ * ============================================================ */
+/* split a CSV line in place; empty fields are kept */
+static int split_csv(char *line, char **field, int max) {
+  int n = 0;
+  line[strcspn(line, "\r\n")] = '\0';
+  for (char *p = line; n < max;) {
+    field[n++] = p;
+    p = strchr(p, ',');
+    if (!p)
+      break;
+    *p++ = '\0';
+  }
+  return n;
+}
+
+/*
+ * Compare frames_per_s (operations per second for setup records) with a
+ * baseline CSV. Returns the number of regressions, -1 if unreadable.
+ */
+static int compare_baseline(const char *path, const record_list_t *list,
+                            double tolerance) {
+  FILE *fp = fopen(path, "r");
+  if (!fp)
+    return -1;
+  char line[1024];
+  char *f[16];
+  int matched = 0, regressions = 0;
+
+  printf("\nBaseline %s:\n", path);
+  if (!fgets(line, sizeof(line), fp)) {
+    fclose(fp);
+    return -1;
+  }
+  while (fgets(line, sizeof(line), fp)) {
+    if (split_csv(line, f, 16) < 14)
+      continue;
+    const double old_fps = atof(f[13]);
+    for (int i = 0; i < list->n; i++) {
+      const record_t *r = &list->r[i];
+      if (strcmp(r->code, f[1]) || strcmp(r->bench, f[5]) ||
+          strcmp(r->variant, f[6]) || strcmp(r->kernel, f[7]) ||
+          strcmp(r->schedule, f[8]) || r->threads != atoi(f[9]) ||
+          r->batch != atoi(f[10]))
+        continue;
+      if (old_fps <= 0.0)
+        break;
+      const double change = 100.0 * (r->fps / old_fps - 1.0);
+      const int slow = change < -tolerance;
+      matched++;
+      regressions += slow;
+      printf("  %-22s %-6s %-11s %-4s %-8s T=%-2d B=%-5d %+7.1f %%%s\n",
+             r->code, r->bench, r->variant, r->kernel, r->schedule,
+             r->threads, r->batch, change, slow ? "  REGRESSION" : "");
+      break;
+    }
+  }
+  fclose(fp);
+  printf("%d measurements compared, %d slower than -%.1f %%\n", matched,
+         regressions, tolerance);
+  return regressions;
+}
+
+/* ============================================================
+ * MAIN
+ * ============================================================ */
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [--codes ID,ID,...] [--root DIR] [--threads T,T,...]\n"
+          "          [--batch L,L,...] [--gpu-batch F,F,...] [--ebno DB]\n"
+          "          [--iter N] [--time SEC] [--frames F] [--label STR]\n"
+          "          [--csv FILE] [--json FILE] [--baseline FILE]\n"
+          "          [--tolerance PCT] [--only GROUP,...]\n"
+          "\n"
+          "  --codes ID,...     registry IDs (default %s)\n"
+          "  --root DIR         matrices directory (default matrices)\n"
+          "  --threads T,...    decoder thread counts (default 1,<cores>)\n"
+          "  --batch L,...      SIMD batch lanes (default 8,16,32)\n"
+          "  --gpu-batch F,...  GPU frames per submission (default 4096)\n"
+          "  --ebno DB          Eb/N0 of the decode frames (default 3.0)\n"
+          "  --iter N           maximum iterations (default 20)\n"
+          "  --time SEC         minimum time per measurement (default 0.5)\n"
+          "  --frames F         generated frames per code (default %d)\n"
+          "  --label STR        tag of the records (e.g. commit hash)\n"
+          "  --csv / --json     write the records to FILE\n"
+          "  --baseline FILE    compare with an earlier --csv file; exit 2\n"
+          "                     if a measurement is slower than --tolerance\n"
+          "  --tolerance PCT    allowed slowdown in percent (default 10)\n"
+          "  --only GROUP,...   setup, encode, decode, kernel (default all)\n",
+          prog, BENCH_CODES, BENCH_FRAMES);
+}
+
+int main(int argc, char **argv) {
+  bench_opts_t o;
+  memset(&o, 0, sizeof(o));
+  o.root = "matrices";
+  o.threads[o.n_threads++] = 1;
+  if (default_thread_count() > 1)
+    o.threads[o.n_threads++] = default_thread_count();
+  o.n_lanes = 3;
+  o.lanes[0] = 8;
+  o.lanes[1] = 16;
+  o.lanes[2] = 32;
+  o.n_gpu_frames = 1;
+  o.gpu_frames[0] = 4096;
+  o.EbN0_dB = 3.0;
+  o.max_iter = 20;
+  o.min_time = 0.5;
+  o.n_frames = BENCH_FRAMES;
+
+  const char *codes = BENCH_CODES;
+  const char *label = "";
+  const char *csv_path = NULL, *json_path = NULL, *baseline = NULL;
+  double tolerance = 10.0;
+
+  for (int a = 1; a < argc; a++) {
+    int ok = 1;
+    if (a + 1 >= argc) {
+      ok = 0;
+    } else if (!strcmp(argv[a], "--codes")) {
+      codes = argv[++a];
+    } else if (!strcmp(argv[a], "--root")) {
+      o.root = argv[++a];
+    } else if (!strcmp(argv[a], "--threads")) {
+      ok = (o.n_threads = parse_int_list(argv[++a], o.threads,
+                                         BENCH_MAX_LIST)) > 0;
+    } else if (!strcmp(argv[a], "--batch")) {
+      ok = (o.n_lanes = parse_int_list(argv[++a], o.lanes,
+                                       BENCH_MAX_LIST)) > 0;
+    } else if (!strcmp(argv[a], "--gpu-batch")) {
+      ok = (o.n_gpu_frames = parse_int_list(argv[++a], o.gpu_frames,
+                                            BENCH_MAX_LIST)) > 0;
+    } else if (!strcmp(argv[a], "--ebno")) {
+      o.EbN0_dB = atof(argv[++a]);
+    } else if (!strcmp(argv[a], "--iter")) {
+      ok = (o.max_iter = atoi(argv[++a])) > 0;
+    } else if (!strcmp(argv[a], "--time")) {
+      ok = (o.min_time = atof(argv[++a])) > 0.0;
+    } else if (!strcmp(argv[a], "--frames")) {
+      o.n_frames = atoi(argv[++a]);
+      o.n_frames -= o.n_frames % LDPC_BATCH_MAX_LANES;
+      ok = o.n_frames > 0;
+    } else if (!strcmp(argv[a], "--label")) {
+      label = argv[++a];
+    } else if (!strcmp(argv[a], "--csv")) {
+      csv_path = argv[++a];
+    } else if (!strcmp(argv[a], "--json")) {
+      json_path = argv[++a];
+    } else if (!strcmp(argv[a], "--baseline")) {
+      baseline = argv[++a];
+    } else if (!strcmp(argv[a], "--tolerance")) {
+      ok = (tolerance = atof(argv[++a])) >= 0.0;
+    } else if (!strcmp(argv[a], "--only")) {
+      o.only = argv[++a];
+    } else {
+      ok = 0;
+    }
+    if (!ok) {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+
+  ldpc_registry_t *reg = ldpc_registry_create(o.root, 1);
+  if (!reg) {
+    fprintf(stderr, "Cannot create the code registry\n");
+    return 1;
+  }
+
+  record_list_t list = {NULL, 0, 0};
+  int failed = 0;
+  char id[64];
+  for (const char *p = codes; *p;) {
+    const size_t len = strcspn(p, ",");
+    snprintf(id, sizeof(id), "%.*s", (int)len, p);
+    p += len + (p[len] == ',');
+    if (*id)
+      failed |= bench_code(&list, &o, reg, id) < 0;
+  }
+  ldpc_registry_destroy(reg);
+
+  int rc = failed;
+  if (csv_path && write_csv(csv_path, &list, label) < 0) {
+    fprintf(stderr, "%s: write failed\n", csv_path);
+    rc = 1;
+  }
+  if (json_path && write_json(json_path, &list, label, &o) < 0) {
+    fprintf(stderr, "%s: write failed\n", json_path);
+    rc = 1;
+  }
+  if (baseline) {
+    const int reg_count = compare_baseline(baseline, &list, tolerance);
+    if (reg_count < 0) {
+      fprintf(stderr, "%s: cannot read the baseline\n", baseline);
+      rc = 1;
+    } else if (reg_count > 0) {
+      rc = 2;
+    }
+  }
+  free(list.r);
+  return rc;
+}
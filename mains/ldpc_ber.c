@@ -5,10 +5,75 @@
  * This program evaluates the information-bit BER performance of a
  * systematic LDPC code under BPSK modulation over AWGN, using the
  * Sum-Product Algorithm (SPA) decoder.
+ *
+ * Frames are simulated by a pool of worker threads:
+ *   - The (SNR point, frame) space is split into chunks of
+ *     FRAMES_PER_CHUNK frames; idle workers grab the next chunk from a
+ *     shared counter, so fast and slow SNR points balance automatically.
+ *   - Every chunk draws from its own RNG stream seeded from
+ *     (seed, SNR index, chunk index), so a fixed --seed gives identical
+ *     results for any thread count. Info bits, Ziggurat noise and LLRs
+ *     are generated a frame at a time (ldpc_channel.h).
+ *   - Each worker owns its decoder context, buffers and error counters;
+ *     counters are merged after all workers have finished.
+ *
+ * Stopping per SNR point:
+ *   - fixed mode (default): exactly --frames frames
+ *   - --target-errors E: until E frame errors, bounded by --max-frames
+ *     and optionally --time-budget seconds
+ *   - --prune-ber B: points above the first one with BER < B are skipped
+ *   Error-driven stopping is evaluated on chunks in index order, so it is
+ *   reproducible for a fixed seed; only --time-budget depends on speed.
+ *
+ * Usage:
+ *   ldpc_ber [--threads T] [--seed S] [--frames F] [--target-errors E]
+ *            [--max-frames F] [--time-budget SEC] [--prune-ber B]
+ *            [--sparse-encoder] [--qc] [--code ID] [--gpu]
+ *            [--puncture P] [--shorten S] [--stats] [--crc L]
+ *            [--flip P]
+ *
+ *   H and G are read from <folder>/code.bin (ldpc_codefile.h, see
+ *   csv2bin) when present, else from H.csv / G.csv. code.bin is mapped
+ *   and the decoders / encoder work on the mapped arrays (no dense H,
+ *   nothing copied; the pages are shared with other processes).
+ *   --code ID selects matrices/<ID> without the interactive prompt and
+ *   resolves it through the code registry (ldpc_registry.h): a missing
+ *   code is converted from CSV or built (e.g. --code N4096_wc3_wr6_s7_peg).
+ *   --qc reads the QC base matrix <folder>/base.txt (ldpc_qc.h) instead of
+ *   H.csv / G.csv and uses the structured QC encoder with the Z-block
+ *   layered decoder.
+ *   --gpu decodes on the CUDA backend (ldpc_gpu.h, `make CUDA=1`): every
+ *   worker takes GPU_CHUNKS chunks per submission and generates the next
+ *   submission while the previous one is decoded (double buffering).
+ *   Frames and RNG streams are the same as on the CPU; the GPU decodes in
+ *   single precision with flooding and ignores the stopping rules.
+ *   --puncture P / --shorten S run the mother code at rate
+ *   (K − S) / (N − P − S) (ldpc_rate.h): P parity bits are not sent and
+ *   S information bits are fixed to 0; Eb/N0 and BER use the effective
+ *   rate and the K − S user bits.
+ *   --stats attaches a statistics record to every decoder
+ *   (ldpc_stats.h) and adds, per SNR point, mean / median / 99th
+ *   percentile / maximum iterations, converged and stalled frames and the
+ *   mean check-node, variable-node and syndrome time per frame to the
+ *   results CSV; the iteration histogram and the mean unsatisfied-check
+ *   trajectory go to <results>_stats.csv. Frames are identical with and
+ *   without it.
+ *   --crc L appends an L-bit CRC (8, 16, 24 or 32; ldpc_crc.h) to the
+ *   user bits and attaches it to the decoders, so frames stop as soon as
+ *   the CRC passes; Eb/N0 and BER count the K − S − L user bits only.
+ *   --flip P post-processes failed frames by flipping the P least
+ *   reliable bits (ldpc_postprocess_flip()). With either option the
+ *   results CSV gains, per SNR point, the frames the decoder reported as
+ *   failed, the erroneous frames it delivered as good (undetected), the
+ *   early CRC exits and the frames recovered by post-processing.
  */
 
+#define _POSIX_C_SOURCE 200809L /* strdup() under -std=c99 */
+
 #include <dirent.h>
 #include <math.h>
+#include <pthread.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -19,30 +84,55 @@
 #else
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 #endif
 
+#include "ldpc_channel.h"
+#include "ldpc_codefile.h"
+#include "ldpc_crc.h"
 #include "ldpc_decoder.h"
 #include "ldpc_encoder.h"
-
-#define PI 3.141592653589793
+#include "ldpc_gpu.h"
+#include "ldpc_qc.h"
+#include "ldpc_rate.h"
+#include "ldpc_registry.h"
+#include "ldpc_stats.h"
+#include "ldpc_sparse_encoder.h"
 
 /* ============================================================
  * Simulation parameters
  * ============================================================ */
-const int N_trials = 10; /* Monte Carlo trials */
+const int N_trials = 10; /* Monte Carlo trials (default for --frames) */
 const double EbN0_min = -2.0;
 const double EbN0_max = 10.0;
 const double EbN0_step = 0.5;
 const int max_iter_spa = 40; /* SPA maximum iteration */
 
+/* Frame limit per point when running with --target-errors */
+const long max_frames_default = 1000000;
+
+/* Check-node kernel: SPA (reference) or MIN_SUM / NMS (param = alpha) /
+ * OMS (param = beta) */
+const ldpc_kernel_t decoder_kernel = LDPC_KERNEL_SPA;
+const double decoder_kernel_param = 0.0;
+
+/* Message-passing schedule: FLOODING or LAYERED */
+const ldpc_schedule_t decoder_schedule = LDPC_SCHEDULE_FLOODING;
+
+/* Early abort of undecodable frames (0 = disabled): iterations without any
+ * hard-decision change / without syndrome-weight improvement */
+const int stop_unchanged_iters = 0;
+const int stop_syndrome_iters = 0;
+
+#define FRAMES_PER_CHUNK 8 /* frames per work item */
+#define GPU_CHUNKS 128     /* work items per GPU submission (--gpu) */
+
 /* ============================================================
- * Gaussian noise generator
+ * Per-chunk random stream (ldpc_channel.h, xoshiro256**)
  * ============================================================ */
-static double rand_uniform(void) { return (rand() + 1.0) / (RAND_MAX + 2.0); }
-static double randn(void) {
-  double u1 = rand_uniform();
-  double u2 = rand_uniform();
-  return sqrt(-2.0 * log(u1)) * cos(2.0 * PI * u2);
+/* independent stream for (seed, SNR point, chunk) */
+static void rng_seed(ldpc_rng_t *r, uint64_t seed, int point, long chunk) {
+  ldpc_rng_seed(r, seed ^ ((uint64_t)point << 40) ^ (uint64_t)chunk);
 }
 
 /* ============================================================
@@ -56,24 +146,19 @@ static double bpsk_ber(double EbN0_linear) {
  * Load matrix from CSV
  * ============================================================ */
 static int load_matrix(int **mat, int rows, int cols, const char *path) {
-  FILE *fp = fopen(path, "r");
-  if (!fp) {
+  int rc = ldpc_load_matrix_csv(mat, rows, cols, path);
+  if (rc == -1)
     fprintf(stderr, "ERROR: cannot open %s\n", path);
-    return -1;
-  }
+  else if (rc)
+    fprintf(stderr, "ERROR: insufficient rows / columns in %s\n", path);
+  return rc;
+}
 
-  char line[20000];
-  for (int r = 0; r < rows; r++) {
-    if (!fgets(line, sizeof(line), fp)) {
-      fprintf(stderr, "ERROR: insufficient rows in %s\n", path);
-      fclose(fp);
-      return -2;
-    }
-    for (int c = 0; c < cols; c++)
-      mat[r][c] = (line[c] == '1') ? 1 : 0;
-  }
-  fclose(fp);
-  return 0;
+static int file_exists(const char *path) {
+  FILE *fp = fopen(path, "rb");
+  if (fp)
+    fclose(fp);
+  return fp != NULL;
 }
 
 /* ============================================================
@@ -134,25 +219,849 @@ static void select_ldpc_folder(char *selected_path, size_t bufsize) {
   printf("\nUsing LDPC folder: %s\n\n", selected_path);
 }
 
+/* ============================================================
+ * Parallel Monte-Carlo engine
+ * ============================================================ */
+typedef enum {
+  STOP_FRAMES = 0, /* frame limit reached                   */
+  STOP_TARGET,     /* target number of frame errors reached */
+  STOP_TIME,       /* per-point time budget exhausted       */
+  STOP_PRUNED      /* skipped: a lower SNR point fell below --prune-ber */
+} stop_reason_t;
+
+static const char *stop_names[] = {"frames", "target", "time", "pruned"};
+
+typedef struct {
+  double EbN0_dB;
+  double sigma2;
+  long long frames;     /* frames simulated          */
+  long long err_info;   /* information-bit errors    */
+  long long err_frames; /* frames with >= 1 bit error */
+  stop_reason_t stop;
+  ldpc_stats_t *stats;  /* decoder statistics (--stats), or NULL */
+  long long detected;   /* frames with a failed decoder status   */
+  long long undetected; /* error frames delivered as good        */
+  long long crc_exits;  /* LDPC_DECODE_CRC_OK frames             */
+  long long recovered;  /* LDPC_DECODE_RECOVERED frames          */
+} snr_point_t;
+
+/* result of one chunk of frames */
+typedef struct {
+  long long frames;
+  long long err_info;
+  long long err_frames;
+  ldpc_stats_t *stats; /* chunk statistics (--stats), or NULL */
+  long long detected, undetected, crc_exits, recovered; /* decoder status */
+} tally_t;
+
+/*
+ * Per-point scheduling state. Chunk results arrive out of order; they are
+ * folded into the point totals strictly in chunk order, and the stopping
+ * rule is evaluated after each folded chunk. The point's result is thus
+ * the same chunk prefix for any thread count; chunks completing after the
+ * stopping chunk are discarded.
+ */
+typedef struct {
+  tally_t *res;        /* [cap] chunk results                */
+  unsigned char *done; /* [cap] result present               */
+  long cap;
+  long issued; /* chunks handed out                         */
+  long folded; /* chunks folded into the totals (in order)  */
+  int open;    /* still handing out chunks                  */
+  int final;   /* totals are final                          */
+  double t_start;
+} point_run_t;
+
+typedef struct {
+  /* shared, read-only while workers run */
+  int **H;
+  const ldpc_packed_encoder_t *enc; /* packed G, shared read-only */
+  int sparse_encoder;               /* 1: encode from H, enc unused */
+  const ldpc_qc_code_t *qc; /* QC code: H / enc unused          */
+  const ldpc_codefile_t *cf; /* mapped code file, or NULL        */
+  int gpu;                  /* 1: decode on the GPU backend     */
+  int n_punct, n_short;     /* rate matching (0, 0: mother code) */
+  int stats;                /* 1: collect decoder statistics    */
+  const ldpc_crc_t *crc;    /* outer CRC (--crc), or NULL       */
+  int flip_bits;            /* --flip P (0: no post-processing) */
+  int M, N, K;
+  int k_info;               /* user bits per frame (K - n_short - L) */
+  snr_point_t *points;
+  int n_points;
+  long max_frames;          /* frame limit per point               */
+  long max_chunks;          /* chunks per point at max_frames      */
+  long long target_errors;  /* frame errors per point (0: off)     */
+  double time_budget;       /* seconds per point (0: off)          */
+  double prune_ber;         /* prune above this SNR (0: off)       */
+  uint64_t seed;
+
+  /* work distribution, guarded by lock */
+  pthread_mutex_t lock;
+  point_run_t *run;
+  int cur_point; /* lowest point that may still hand out chunks */
+  int failed;
+} sim_t;
+
+typedef struct {
+  sim_t *sim;
+  pthread_t tid;
+} worker_t;
+
+static double now_sec(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1e-9 * (double)ts.tv_nsec;
+}
+
+static double point_ber(const snr_point_t *pt, int K) {
+  return pt->frames ? (double)pt->err_info / ((double)pt->frames * K) : 0.0;
+}
+
+/* lock held: stop point p and drop the chunk results not folded */
+static void sim_close(point_run_t *r) {
+  r->final = 1;
+  r->open = 0;
+  for (long c = r->folded; c < r->issued; c++)
+    if (r->done[c])
+      ldpc_stats_destroy(r->res[c].stats); /* results past the stop */
+  free(r->res);
+  free(r->done);
+  r->res = NULL;
+  r->done = NULL;
+}
+
+/* lock held: mark point p final and apply curve pruning */
+static void sim_finalize(sim_t *sim, int p) {
+  snr_point_t *pt = &sim->points[p];
+
+  sim_close(&sim->run[p]);
+
+  if (pt->stop != STOP_PRUNED) {
+    printf("  Eb/N0 = %5.2f dB : %lld frames, %lld frame errors (%s)\n",
+           pt->EbN0_dB, pt->frames, pt->err_frames, stop_names[pt->stop]);
+    fflush(stdout);
+  }
+
+  if (sim->prune_ber > 0.0 && pt->stop != STOP_PRUNED &&
+      point_ber(pt, sim->k_info) < sim->prune_ber) {
+    /*
+     * A later point may already be final (its chunks finished while p
+     * still had some in flight). Its totals are dropped as well, so the
+     * pruned curve does not depend on the thread count, but its results
+     * are already released and its own pruning has already run.
+     */
+    for (int q = p + 1; q < sim->n_points; q++) {
+      snr_point_t *pq = &sim->points[q];
+      if (pq->stop == STOP_PRUNED)
+        continue;
+      pq->frames = pq->err_info = pq->err_frames = 0;
+      pq->detected = pq->undetected = pq->crc_exits = pq->recovered = 0;
+      if (pq->stats)
+        ldpc_stats_reset(pq->stats);
+      pq->stop = STOP_PRUNED;
+      if (!sim->run[q].final)
+        sim_close(&sim->run[q]);
+    }
+  }
+}
+
+/* lock held: fold completed chunks of point p in order, check stopping */
+static void sim_fold(sim_t *sim, int p) {
+  point_run_t *r = &sim->run[p];
+  snr_point_t *pt = &sim->points[p];
+
+  while (!r->final && r->folded < r->issued && r->done[r->folded]) {
+    const tally_t *t = &r->res[r->folded++];
+    pt->frames += t->frames;
+    pt->err_info += t->err_info;
+    pt->err_frames += t->err_frames;
+    pt->detected += t->detected;
+    pt->undetected += t->undetected;
+    pt->crc_exits += t->crc_exits;
+    pt->recovered += t->recovered;
+    if (t->stats) {
+      ldpc_stats_merge(pt->stats, t->stats);
+      ldpc_stats_destroy(t->stats);
+    }
+
+    if (sim->target_errors > 0 && pt->err_frames >= sim->target_errors) {
+      pt->stop = STOP_TARGET;
+      sim_finalize(sim, p);
+    }
+  }
+
+  if (!r->final && !r->open && r->folded == r->issued)
+    sim_finalize(sim, p);
+}
+
+/* lock held: room for chunk index `chunk` in the result arrays */
+static int sim_reserve(point_run_t *r, long chunk) {
+  if (chunk < r->cap)
+    return 0;
+
+  long cap = r->cap ? 2 * r->cap : 64;
+  tally_t *res = realloc(r->res, cap * sizeof(tally_t));
+  if (!res)
+    return -1;
+  r->res = res;
+
+  unsigned char *done = realloc(r->done, cap);
+  if (!done)
+    return -1;
+  memset(done + r->cap, 0, cap - r->cap);
+  r->done = done;
+  r->cap = cap;
+  return 0;
+}
+
+/* next work item (point, chunk); returns 0 when nothing is left */
+static int sim_take_item(sim_t *sim, int *point, long *chunk) {
+  int found = 0;
+
+  pthread_mutex_lock(&sim->lock);
+  while (!sim->failed && sim->cur_point < sim->n_points) {
+    const int p = sim->cur_point;
+    point_run_t *r = &sim->run[p];
+
+    if (r->open && r->issued >= sim->max_chunks)
+      r->open = 0;
+    if (r->open && sim->time_budget > 0.0 && r->issued > 0 &&
+        now_sec() - r->t_start > sim->time_budget) {
+      r->open = 0;
+      sim->points[p].stop = STOP_TIME;
+    }
+    if (!r->open || r->final) {
+      sim_fold(sim, p);
+      sim->cur_point++;
+      continue;
+    }
+
+    if (sim_reserve(r, r->issued)) {
+      sim->failed = 1;
+      break;
+    }
+    if (r->issued == 0)
+      r->t_start = now_sec();
+
+    *point = p;
+    *chunk = r->issued++;
+    found = 1;
+    break;
+  }
+  pthread_mutex_unlock(&sim->lock);
+  return found;
+}
+
+static void sim_submit(sim_t *sim, int p, long chunk, const tally_t *t) {
+  pthread_mutex_lock(&sim->lock);
+  point_run_t *r = &sim->run[p];
+  if (!r->final) {
+    r->res[chunk] = *t;
+    r->done[chunk] = 1;
+    sim_fold(sim, p);
+  } else {
+    ldpc_stats_destroy(t->stats);
+  }
+  pthread_mutex_unlock(&sim->lock);
+}
+
+/*
+ * One frame: k_info random bits, the CRC if any (--crc), zero padding to
+ * K, mother-code encoding,
+ * BPSK over AWGN and N decoder LLRs. With rate matching only the
+ * tx_length transmitted bits go through the channel (tx / rx buffers).
+ * Returns -1 if the sparse encoder fails.
+ */
+static int sim_frame(const sim_t *sim, const ldpc_rate_t *rate,
+                     ldpc_sparse_encoder_t *senc, const ldpc_awgn_t *ch,
+                     ldpc_rng_t *rng, int *inf, int *code, int *tx,
+                     double *rx, double *LLR) {
+  const int k_crc = sim->crc ? sim->crc->k : sim->k_info;
+  ldpc_rng_bits(rng, inf, sim->k_info);
+  if (sim->crc)
+    ldpc_crc_append(sim->crc, inf);
+  memset(inf + k_crc, 0, (sim->K - k_crc) * sizeof(int));
+
+  if (sim->qc) {
+    ldpc_qc_encode(sim->qc, code, inf); /* encodable checked in main */
+  } else if (senc) {
+    if (ldpc_sparse_encode(senc, code, inf))
+      return -1;
+  } else {
+    ldpc_encode_bits(sim->enc, code, inf);
+  }
+
+  if (!rate) {
+    ldpc_awgn_bpsk(ch, rng, code, NULL, LLR, sim->N);
+  } else {
+    ldpc_rate_puncture(rate, code, tx);
+    ldpc_awgn_bpsk(ch, rng, tx, NULL, rx, ldpc_rate_tx_length(rate));
+    ldpc_rate_depuncture(rate, rx, LLR);
+  }
+  return 0;
+}
+
+/* one GPU submission: up to GPU_CHUNKS work items and their info bits */
+typedef struct {
+  int n;      /* chunks taken     */
+  int frames; /* frames generated */
+  int point[GPU_CHUNKS];
+  long chunk[GPU_CHUNKS];
+  int count[GPU_CHUNKS]; /* frames of each chunk */
+  int *inf;              /* [GPU_CHUNKS * FRAMES_PER_CHUNK][K] */
+} gpu_batch_t;
+
+/* take chunks and write their channel LLRs to the GPU input buffer */
+static int gpu_fill(sim_t *sim, ldpc_gpu_t *gpu, const ldpc_rate_t *rate,
+                    ldpc_sparse_encoder_t *senc, gpu_batch_t *gb,
+                    int *code, int *tx, double *rx, double *LLR) {
+  const int N = sim->N;
+  const int K = sim->K;
+  float *in = ldpc_gpu_input(gpu);
+  int p;
+  long chunk;
+
+  gb->n = 0;
+  gb->frames = 0;
+  while (gb->n < GPU_CHUNKS && sim_take_item(sim, &p, &chunk)) {
+    long f0 = chunk * FRAMES_PER_CHUNK;
+    long f1 = f0 + FRAMES_PER_CHUNK;
+    if (f1 > sim->max_frames)
+      f1 = sim->max_frames;
+
+    ldpc_awgn_t ch;
+    ldpc_awgn_init(&ch, sim->points[p].sigma2);
+    ldpc_rng_t rng;
+    rng_seed(&rng, sim->seed, p, chunk);
+
+    for (long f = f0; f < f1; f++) {
+      int *inf = gb->inf + (size_t)gb->frames * K;
+      if (sim_frame(sim, rate, senc, &ch, &rng, inf, code, tx, rx, LLR))
+        return -1;
+
+      float *x = in + (size_t)gb->frames * N;
+      for (int j = 0; j < N; j++)
+        x[j] = (float)LLR[j];
+      gb->frames++;
+    }
+
+    gb->point[gb->n] = p;
+    gb->chunk[gb->n] = chunk;
+    gb->count[gb->n] = (int)(f1 - f0);
+    gb->n++;
+  }
+  return 0;
+}
+
+/* wait for a submission and fold its chunks */
+static int gpu_tally(sim_t *sim, ldpc_gpu_t *gpu, const gpu_batch_t *gb,
+                     int *inf_hat) {
+  const int K = sim->K;
+  if (ldpc_gpu_collect(gpu, NULL, inf_hat, NULL) < 0)
+    return -1;
+
+  size_t f = 0;
+  for (int c = 0; c < gb->n; c++) {
+    tally_t t = {0, 0, 0, NULL, 0, 0, 0, 0};
+    for (int k = 0; k < gb->count[c]; k++, f++) {
+      const int *a = gb->inf + f * K;
+      const int *b = inf_hat + f * K;
+      long long err = 0;
+      for (int i = 0; i < sim->k_info; i++)
+        if (a[i] != b[i])
+          err++;
+      t.frames++;
+      t.err_info += err;
+      t.err_frames += (err != 0);
+    }
+    sim_submit(sim, gb->point[c], gb->chunk[c], &t);
+  }
+  return 0;
+}
+
+/* --gpu worker loop: fill one buffer set while the other is decoded */
+static int sim_gpu_loop(sim_t *sim, const ldpc_decoder_t *dec,
+                        const ldpc_rate_t *rate, ldpc_sparse_encoder_t *senc,
+                        int *code, int *tx, double *rx, double *LLR) {
+  const int K = sim->K;
+  const int max_frames = GPU_CHUNKS * FRAMES_PER_CHUNK;
+  int rc = -1;
+
+  gpu_batch_t *gb = calloc(2, sizeof(gpu_batch_t));
+  int *inf_hat = malloc((size_t)max_frames * K * sizeof(int));
+  ldpc_gpu_t *gpu = ldpc_gpu_create(dec, max_frames, 0);
+  if (!gb || !inf_hat || !gpu)
+    goto done;
+  gb[0].inf = malloc((size_t)max_frames * K * sizeof(int));
+  gb[1].inf = malloc((size_t)max_frames * K * sizeof(int));
+  if (!gb[0].inf || !gb[1].inf)
+    goto done;
+
+  int cur = 0, pending = 0;
+  for (;;) {
+    if (gpu_fill(sim, gpu, rate, senc, &gb[cur], code, tx, rx, LLR))
+      goto done;
+    if (gb[cur].frames > 0 &&
+        ldpc_gpu_submit(gpu, NULL, gb[cur].frames, max_iter_spa))
+      goto done;
+    if (pending && gpu_tally(sim, gpu, &gb[cur ^ 1], inf_hat))
+      goto done;
+    if (gb[cur].frames == 0)
+      break;
+    pending = 1;
+    cur ^= 1;
+  }
+  rc = 0;
+
+done:
+  ldpc_gpu_destroy(gpu);
+  if (gb) {
+    free(gb[0].inf);
+    free(gb[1].inf);
+  }
+  free(gb);
+  free(inf_hat);
+  return rc;
+}
+
+static void *sim_worker(void *arg) {
+  worker_t *w = (worker_t *)arg;
+  sim_t *sim = w->sim;
+  const int N = sim->N;
+  const int K = sim->K;
+
+  int *inf = malloc(K * sizeof(int));
+  int *code = malloc(N * sizeof(int));
+  int *tx = malloc(N * sizeof(int));
+  double *rx = malloc(N * sizeof(double));
+  double *LLR = malloc(N * sizeof(double));
+  int *ecc_hat = malloc(N * sizeof(int));
+  int *inf_hat = malloc(K * sizeof(int));
+
+  /* --stats: per-frame record (trajectory buffer), aggregated per chunk */
+  ldpc_frame_stats_t fs;
+  memset(&fs, 0, sizeof(fs));
+  int *unsat = sim->stats ? malloc((max_iter_spa + 1) * sizeof(int)) : NULL;
+
+  /* decoder context: Tanner graph and message storage built once */
+  ldpc_decoder_t *dec = NULL;
+  ldpc_qc_decoder_t *qdec = NULL;
+  if (sim->qc)
+    qdec = ldpc_qc_decoder_create(sim->qc);
+  else if (sim->cf)
+    dec = ldpc_codefile_decoder(sim->cf); /* borrows the mapped graph */
+  else
+    dec = ldpc_decoder_create(sim->H, sim->M, N, K);
+
+  /* sparse encoder keeps per-frame workspace: one per worker */
+  ldpc_sparse_encoder_t *senc =
+      sim->sparse_encoder ? ldpc_sparse_encoder_create(sim->H, sim->M, N, K)
+                          : NULL;
+
+  /* rate matching: masks derived from one puncturing order per worker */
+  ldpc_rate_t *rate = NULL;
+  if (dec && (sim->n_punct || sim->n_short)) {
+    rate = ldpc_rate_create(dec);
+    if (rate && ldpc_rate_set(rate, sim->n_punct, sim->n_short)) {
+      ldpc_rate_destroy(rate);
+      rate = NULL;
+    }
+  }
+
+  if (!inf || !code || !tx || !rx || !LLR || !ecc_hat || !inf_hat ||
+      (!dec && !qdec) || (sim->sparse_encoder && !senc) ||
+      (sim->stats && !unsat) ||
+      ((sim->n_punct || sim->n_short) && !rate) ||
+      (dec &&
+       ldpc_decoder_set_kernel(dec, decoder_kernel, decoder_kernel_param)) ||
+      (dec && ldpc_decoder_set_crc(dec, sim->crc)) ||
+      (qdec && ldpc_qc_decoder_set_kernel(qdec, decoder_kernel,
+                                          decoder_kernel_param))) {
+    pthread_mutex_lock(&sim->lock);
+    sim->failed = 1;
+    pthread_mutex_unlock(&sim->lock);
+    goto cleanup;
+  }
+  if (dec) {
+    ldpc_decoder_set_schedule(dec, decoder_schedule);
+    ldpc_decoder_set_stopping(dec, stop_unchanged_iters, stop_syndrome_iters);
+    if (sim->flip_bits)
+      ldpc_decoder_set_postprocess(dec, ldpc_postprocess_flip,
+                                   &sim->flip_bits);
+    if (sim->stats) {
+      fs.unsat = unsat;
+      fs.unsat_cap = max_iter_spa + 1;
+      ldpc_decoder_set_stats(dec, &fs);
+    }
+  }
+
+  if (sim->gpu) {
+    if (sim_gpu_loop(sim, dec, rate, senc, code, tx, rx, LLR)) {
+      pthread_mutex_lock(&sim->lock);
+      sim->failed = 1;
+      pthread_mutex_unlock(&sim->lock);
+    }
+    goto cleanup;
+  }
+
+  int p;
+  long chunk;
+  while (sim_take_item(sim, &p, &chunk)) {
+    long f0 = chunk * FRAMES_PER_CHUNK;
+    long f1 = f0 + FRAMES_PER_CHUNK;
+    if (f1 > sim->max_frames)
+      f1 = sim->max_frames;
+
+    ldpc_awgn_t ch;
+    ldpc_awgn_init(&ch, sim->points[p].sigma2);
+    tally_t t = {0, 0, 0, NULL, 0, 0, 0, 0};
+    if (sim->stats && !(t.stats = ldpc_stats_create(max_iter_spa))) {
+      pthread_mutex_lock(&sim->lock);
+      sim->failed = 1;
+      pthread_mutex_unlock(&sim->lock);
+      goto cleanup;
+    }
+
+    ldpc_rng_t rng;
+    rng_seed(&rng, sim->seed, p, chunk);
+
+    for (long f = f0; f < f1; f++) {
+
+      if (sim_frame(sim, rate, senc, &ch, &rng, inf, code, tx, rx, LLR)) {
+        ldpc_stats_destroy(t.stats);
+        pthread_mutex_lock(&sim->lock);
+        sim->failed = 1;
+        pthread_mutex_unlock(&sim->lock);
+        goto cleanup;
+      }
+
+      int status;
+      if (qdec)
+        status = ldpc_qc_decode(qdec, LLR, ecc_hat, inf_hat, max_iter_spa);
+      else
+        status = ldpc_decoder_decode(dec, LLR, ecc_hat, inf_hat, max_iter_spa);
+      if (t.stats)
+        ldpc_stats_add(t.stats, &fs);
+
+      long long err = 0;
+      for (int i = 0; i < sim->k_info; i++)
+        if (inf[i] != inf_hat[i])
+          err++;
+
+      t.frames++;
+      t.err_info += err;
+      t.err_frames += (err != 0);
+      t.detected += LDPC_DECODE_FAILED(status);
+      t.undetected += (err != 0 && !LDPC_DECODE_FAILED(status));
+      t.crc_exits += (status == LDPC_DECODE_CRC_OK);
+      t.recovered += (status == LDPC_DECODE_RECOVERED);
+    }
+
+    sim_submit(sim, p, chunk, &t);
+  }
+
+cleanup:
+  ldpc_rate_destroy(rate);
+  ldpc_sparse_encoder_destroy(senc);
+  ldpc_decoder_destroy(dec);
+  ldpc_qc_decoder_destroy(qdec);
+  free(inf);
+  free(code);
+  free(tx);
+  free(rx);
+  free(LLR);
+  free(ecc_hat);
+  free(inf_hat);
+  free(unsat);
+  return NULL;
+}
+
+/* run all SNR points on n_threads workers; returns 0 on success */
+static int sim_run(sim_t *sim, int n_threads) {
+  worker_t *workers = calloc(n_threads, sizeof(worker_t));
+  sim->run = calloc(sim->n_points, sizeof(point_run_t));
+  if (!workers || !sim->run) {
+    free(workers);
+    free(sim->run);
+    return -1;
+  }
+
+  sim->max_chunks = (sim->max_frames + FRAMES_PER_CHUNK - 1) / FRAMES_PER_CHUNK;
+  sim->cur_point = 0;
+  sim->failed = 0;
+  for (int p = 0; p < sim->n_points; p++) {
+    sim->run[p].open = 1;
+    sim->points[p].stop = STOP_FRAMES;
+  }
+  pthread_mutex_init(&sim->lock, NULL);
+
+  int started = 0;
+  for (int t = 0; t < n_threads; t++) {
+    workers[t].sim = sim;
+    if (pthread_create(&workers[t].tid, NULL, sim_worker, &workers[t]))
+      break;
+    started++;
+  }
+
+  int rc = (started > 0) ? 0 : -1;
+
+  for (int t = 0; t < started; t++)
+    pthread_join(workers[t].tid, NULL);
+
+  if (sim->failed)
+    rc = -1;
+
+  /* every point is final once all chunks are in */
+  for (int p = 0; p < sim->n_points; p++) {
+    if (!sim->run[p].final) {
+      sim->run[p].open = 0;
+      sim_fold(sim, p);
+    }
+  }
+
+  pthread_mutex_destroy(&sim->lock);
+  free(sim->run);
+  sim->run = NULL;
+  free(workers);
+  return rc;
+}
+
+/* ============================================================
+ * Statistics
+ * ============================================================ */
+/**
+ * @brief 95% Wilson score interval for k events in n trials.
+ *
+ * Well-behaved for k = 0 (upper bound ≈ 3.84/n) and small n.
+ */
+static void wilson_ci(long long k, double n, double *lo, double *hi) {
+  const double z = 1.959963984540054;
+  if (n <= 0.0) {
+    *lo = 0.0;
+    *hi = 1.0;
+    return;
+  }
+  double ph = (double)k / n;
+  double z2n = z * z / n;
+  double denom = 1.0 + z2n;
+  double centre = (ph + 0.5 * z2n) / denom;
+  double half = z * sqrt(ph * (1.0 - ph) / n + 0.25 * z2n / n) / denom;
+  *lo = (k > 0 && centre - half > 0.0) ? centre - half : 0.0;
+  *hi = (centre + half < 1.0) ? centre + half : 1.0;
+}
+
+/**
+ * @brief Flag points where the BER curve flattens into an error floor.
+ *
+ * The local slope (decades per dB) between neighbouring measured points is
+ * compared with the steepest slope seen at lower Eb/N0; a point is flagged
+ * once its slope falls below a quarter of that waterfall slope. Points
+ * without errors carry no slope information and are never flagged.
+ */
+static void detect_floor(const snr_point_t *points, int n_points, int K,
+                         int *floor_flag) {
+  double max_slope = 0.0;
+  int prev = -1;
+
+  for (int p = 0; p < n_points; p++) {
+    floor_flag[p] = 0;
+    if (points[p].stop == STOP_PRUNED || points[p].err_info == 0)
+      continue;
+
+    if (prev >= 0) {
+      double dB = points[p].EbN0_dB - points[prev].EbN0_dB;
+      double slope = (log10(point_ber(&points[prev], K)) -
+                      log10(point_ber(&points[p], K))) /
+                     dB;
+      if (max_slope >= 1.0 && slope < 0.25 * max_slope)
+        floor_flag[p] = 1;
+      if (slope > max_slope)
+        max_slope = slope;
+    }
+    prev = p;
+  }
+}
+
+/* ============================================================
+ * Decoder statistics output (--stats)
+ * ============================================================ */
+/* --stats columns of a results row */
+static void write_stats_columns(FILE *fp, const ldpc_stats_t *st) {
+  int it_max = 0;
+  for (int t = 0; t <= st->max_iter; t++)
+    if (st->iter_hist[t])
+      it_max = t;
+  double ns_check, ns_var, ns_syn;
+  ldpc_stats_phase_ns(st, &ns_check, &ns_var, &ns_syn);
+
+  fprintf(fp, ",%.4f,%d,%d,%d,%llu,%llu,%.1f,%.1f,%.1f",
+          ldpc_stats_mean_iterations(st),
+          ldpc_stats_iteration_quantile(st, 0.5),
+          ldpc_stats_iteration_quantile(st, 0.99), it_max, st->converged,
+          st->stalled, ns_check, ns_var, ns_syn);
+}
+
+/*
+ * Per point and iteration t: frames that ran exactly t iterations and the
+ * mean unsatisfied-check count after t iterations.
+ */
+static int write_stats_file(const char *path, const snr_point_t *points,
+                            int n_points, int max_iter) {
+  FILE *fp = fopen(path, "w");
+  if (!fp)
+    return -1;
+  fprintf(fp, "EbN0_dB,iter,frames,mean_unsat\n");
+  for (int p = 0; p < n_points; p++) {
+    const snr_point_t *pt = &points[p];
+    if (pt->stop == STOP_PRUNED || !pt->stats->frames)
+      continue;
+    for (int t = 0; t <= max_iter; t++)
+      fprintf(fp, "%.1f,%d,%llu,%.4f\n", pt->EbN0_dB, t,
+              pt->stats->iter_hist[t], ldpc_stats_mean_unsat(pt->stats, t));
+  }
+  return fclose(fp) ? -1 : 0;
+}
+
+static int default_thread_count(void) {
+#if defined(_SC_NPROCESSORS_ONLN)
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  if (n > 0)
+    return (int)n;
+#endif
+  return 1;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [--threads T] [--seed S] [--frames F]\n"
+          "          [--target-errors E] [--max-frames F] [--time-budget SEC]\n"
+          "          [--prune-ber B] [--sparse-encoder] [--qc] [--code ID]\n"
+          "          [--gpu] [--puncture P] [--shorten S] [--stats]\n"
+          "          [--crc L] [--flip P]\n"
+          "\n"
+          "  --frames F         frames per SNR point (fixed mode, default %d)\n"
+          "  --target-errors E  simulate each point until E frame errors\n"
+          "  --max-frames F     frame limit per point (same as --frames;\n"
+          "                     default %ld with --target-errors)\n"
+          "  --time-budget SEC  wall-clock limit per point\n"
+          "  --prune-ber B      skip higher SNR points once BER < B\n"
+          "  --sparse-encoder   encode from H (G.csv is not loaded)\n"
+          "  --qc               QC code from base.txt (layered Z-block\n"
+          "                     decoder, H.csv / G.csv are not loaded)\n"
+          "  --code ID          code N{N}_wc{wc}_wr{wr}[_s{seed}]\n"
+          "                     [_peg|_ace|_qc{Z}] from the registry\n"
+          "                     (built on a miss, no prompt)\n"
+          "  --gpu              decode on the CUDA backend (make CUDA=1)\n"
+          "  --puncture P       do not transmit P parity bits\n"
+          "  --shorten S        fix S information bits to 0 (not sent)\n"
+          "  --stats            iteration / syndrome / timing statistics\n"
+          "                     (not with --qc or --gpu)\n"
+          "  --crc L            L-bit CRC on the user bits (8, 16, 24, 32),\n"
+          "                     early exit when it passes (not with --qc\n"
+          "                     or --gpu)\n"
+          "  --flip P           flip the P least reliable bits of failed\n"
+          "                     frames (1 .. %d, not with --qc or --gpu)\n",
+          prog, N_trials, max_frames_default, LDPC_FLIP_MAX_BITS);
+}
+
 /* ============================================================
  * MAIN
  * ============================================================ */
-int main(void) {
+int main(int argc, char **argv) {
+  int n_threads = default_thread_count();
+  uint64_t seed = (uint64_t)time(NULL);
+  long max_frames = 0;
+  long long target_errors = 0;
+  double time_budget = 0.0;
+  double prune_ber = 0.0;
+  int sparse_encoder = 0;
+  int use_qc = 0;
+  int use_gpu = 0;
+  int n_punct = 0, n_short = 0;
+  int use_stats = 0;
+  int crc_bits = 0, flip_bits = 0;
+  const char *code_id = NULL;
+
+  for (int a = 1; a < argc; a++) {
+    if (!strcmp(argv[a], "--threads") && a + 1 < argc) {
+      n_threads = atoi(argv[++a]);
+    } else if (!strcmp(argv[a], "--seed") && a + 1 < argc) {
+      seed = strtoull(argv[++a], NULL, 10);
+    } else if ((!strcmp(argv[a], "--frames") ||
+                !strcmp(argv[a], "--max-frames")) &&
+               a + 1 < argc) {
+      max_frames = atol(argv[++a]);
+      if (max_frames < 1) {
+        usage(argv[0]);
+        return 1;
+      }
+    } else if (!strcmp(argv[a], "--target-errors") && a + 1 < argc) {
+      target_errors = atoll(argv[++a]);
+    } else if (!strcmp(argv[a], "--time-budget") && a + 1 < argc) {
+      time_budget = atof(argv[++a]);
+    } else if (!strcmp(argv[a], "--prune-ber") && a + 1 < argc) {
+      prune_ber = atof(argv[++a]);
+    } else if (!strcmp(argv[a], "--sparse-encoder")) {
+      sparse_encoder = 1;
+    } else if (!strcmp(argv[a], "--qc")) {
+      use_qc = 1;
+    } else if (!strcmp(argv[a], "--code") && a + 1 < argc) {
+      code_id = argv[++a];
+    } else if (!strcmp(argv[a], "--gpu")) {
+      use_gpu = 1;
+    } else if (!strcmp(argv[a], "--puncture") && a + 1 < argc) {
+      n_punct = atoi(argv[++a]);
+    } else if (!strcmp(argv[a], "--shorten") && a + 1 < argc) {
+      n_short = atoi(argv[++a]);
+    } else if (!strcmp(argv[a], "--stats")) {
+      use_stats = 1;
+    } else if (!strcmp(argv[a], "--crc") && a + 1 < argc) {
+      crc_bits = atoi(argv[++a]);
+    } else if (!strcmp(argv[a], "--flip") && a + 1 < argc) {
+      flip_bits = atoi(argv[++a]);
+    } else {
+      usage(argv[0]);
+      return 1;
+    }
+  }
+  if (max_frames == 0)
+    max_frames = (target_errors > 0) ? max_frames_default : N_trials;
+  if (n_threads < 1 || target_errors < 0 || time_budget < 0.0 ||
+      prune_ber < 0.0 || n_punct < 0 || n_short < 0 ||
+      (use_qc && (sparse_encoder || use_gpu || n_punct || n_short)) ||
+      (use_stats && (use_qc || use_gpu)) ||
+      (crc_bits && crc_bits != 8 && crc_bits != 16 && crc_bits != 24 &&
+       crc_bits != 32) ||
+      flip_bits < 0 || flip_bits > LDPC_FLIP_MAX_BITS ||
+      ((crc_bits || flip_bits) && (use_qc || use_gpu))) {
+    usage(argv[0]);
+    return 1;
+  }
+  if (use_gpu && ldpc_gpu_device_count() == 0) {
+    fprintf(stderr, "--gpu: no CUDA device (build with make CUDA=1)\n");
+    return 1;
+  }
+
   printf("==============================================\n");
   printf("          LDPC BER Simulation (AWGN)          \n");
   printf("==============================================\n\n");
 
-  /* 1. Select folder */
+  /* 1. Select folder (--code: by ID, no prompt) */
   char folder[256];
-  select_ldpc_folder(folder, sizeof(folder));
+  if (code_id)
+    snprintf(folder, sizeof(folder), "matrices/%s", code_id);
+  else
+    select_ldpc_folder(folder, sizeof(folder));
 
   /* 2. Parse parameters from folder name */
-  int N = 0, wc = 0, wr = 0;
-  if (sscanf(folder, "matrices/N%d_wc%d_wr%d", &N, &wc, &wr) != 3) {
-    fprintf(stderr,
-            "Folder name format error. Expected matrices/N{N}_wc{wc}_wr{wr}\n");
+  ldpc_code_key_t key;
+  char id[64];
+  if (ldpc_code_parse_id(folder, &key) || ldpc_code_id(&key, id, sizeof(id))) {
+    fprintf(stderr, "Folder name format error. Expected "
+                    "matrices/N{N}_wc{wc}_wr{wr}[_s{seed}][_peg|_ace|_qc{Z}]\n");
     return 1;
   }
+  int N = key.N, wc = key.wc, wr = key.wr;
 
   int M = (N * wc) / wr;
   int K = N - M;
@@ -163,17 +1072,130 @@ int main(void) {
   printf("  M  = %d\n", M);
   printf("  wc = %d, wr = %d\n\n", wc, wr);
 
-  /* 3. Load H,G matrices */
-  int **H = alloc_matrix_int(M, N);
-  int **G = alloc_matrix_int(K, N);
+  /* rate matching on the mother code (ldpc_rate.h) */
+  if (n_punct > N - K || n_short > K - 1) {
+    fprintf(stderr, "--puncture at most %d, --shorten at most %d\n", N - K,
+            K - 1);
+    return 1;
+  }
+  const int k_info = K - n_short - crc_bits;
+  const int n_tx = N - n_punct - n_short;
+  if (k_info < 1) {
+    fprintf(stderr, "--crc %d leaves no user bits\n", crc_bits);
+    return 1;
+  }
+  if (n_punct || n_short)
+    printf("Rate matching: %d punctured, %d shortened -> k = %d, n = %d, "
+           "R = %.4f\n\n",
+           n_punct, n_short, k_info + crc_bits, n_tx,
+           (double)(k_info + crc_bits) / n_tx);
+
+  /* outer CRC over the user bits (ldpc_crc.h) */
+  ldpc_crc_t *crc = NULL;
+  if (crc_bits) {
+    crc = ldpc_crc_create_std(crc_bits, k_info + crc_bits);
+    if (!crc) {
+      fprintf(stderr, "CRC setup failed.\n");
+      return 1;
+    }
+    printf("CRC%d on %d user bits (early exit on CRC pass)\n", crc_bits,
+           k_info);
+  }
+  if (flip_bits)
+    printf("Post-processing: flip the %d least reliable bits\n", flip_bits);
+  if (crc_bits || flip_bits)
+    printf("\n");
 
-  char path_H[256], path_G[256];
+  /* 3. Load H,G matrices (G only for the generator-matrix encoder) from
+   *    code.bin or the CSV files, or the QC base matrix */
+  int **H = NULL;
+  ldpc_packed_encoder_t *enc = NULL;
+  ldpc_qc_code_t *qc = NULL;
+  ldpc_codefile_t *cf = NULL;       /* code.bin opened here           */
+  ldpc_registry_t *reg = NULL;      /* --code lookups                 */
+  const ldpc_codefile_t *cfv = NULL; /* mapped code (cf or registry)  */
+
+  char path_H[512], path_G[512], path_bin[512];
   snprintf(path_H, sizeof(path_H), "%s/H.csv", folder);
   snprintf(path_G, sizeof(path_G), "%s/G.csv", folder);
+  snprintf(path_bin, sizeof(path_bin), "%s/code.bin", folder);
 
-  if (load_matrix(H, M, N, path_H) || load_matrix(G, K, N, path_G)) {
-    fprintf(stderr, "Matrix load failed.\n");
-    return 1;
+  if (use_qc) {
+    char path_B[512];
+    snprintf(path_B, sizeof(path_B), "%s/base.txt", folder);
+    qc = ldpc_qc_load(path_B);
+    if (!qc) {
+      fprintf(stderr, "Cannot load QC base matrix %s\n", path_B);
+      return 1;
+    }
+    if (qc->N != N || qc->M != M) {
+      fprintf(stderr, "%s: %d x %d does not match the folder (%d x %d)\n",
+              path_B, qc->M, qc->N, M, N);
+      return 1;
+    }
+    if (!qc->encodable) {
+      fprintf(stderr, "%s: base matrix is not dual-diagonal\n", path_B);
+      return 1;
+    }
+    printf("QC code: %d x %d base matrix, Z = %d (layered decoding)\n\n",
+           qc->mb, qc->nb, qc->Z);
+  } else if (code_id) {
+    printf("Registry lookup: %s\n", id);
+    reg = ldpc_registry_create("matrices", 1);
+    const ldpc_code_t *code = reg ? ldpc_registry_get(reg, &key) : NULL;
+    if (!code) {
+      fprintf(stderr, "Code %s not found and could not be built\n", id);
+      return 1;
+    }
+    cfv = code->cf;
+  } else if (file_exists(path_bin)) {
+    cf = ldpc_codefile_open(path_bin);
+    if (!cf) {
+      fprintf(stderr, "%s: invalid or corrupt code file\n", path_bin);
+      return 1;
+    }
+    if (cf->N != N || cf->M != M) {
+      fprintf(stderr, "%s: %d x %d does not match the folder (%d x %d)\n",
+              path_bin, cf->M, cf->N, M, N);
+      return 1;
+    }
+    cfv = cf;
+  } else {
+    H = alloc_matrix_int(M, N);
+    if (load_matrix(H, M, N, path_H)) {
+      fprintf(stderr, "Matrix load failed.\n");
+      return 1;
+    }
+  }
+
+  if (cfv) {
+    if (sparse_encoder) {
+      /* the sparse encoder is still built from a dense H */
+      H = alloc_matrix_int(M, N);
+      ldpc_codefile_expand_H(cfv, H);
+    } else {
+      enc = ldpc_codefile_encoder(cfv);
+      if (!enc) {
+        fprintf(stderr, "%s: no G section (use --sparse-encoder)\n",
+                path_bin);
+        return 1;
+      }
+    }
+    printf("Mapped %s/code.bin (%zu bytes)\n\n", folder, cfv->size);
+  } else if (!use_qc && !sparse_encoder) {
+    int **G = alloc_matrix_int(K, N);
+    if (load_matrix(G, K, N, path_G)) {
+      fprintf(stderr, "Matrix load failed.\n");
+      return 1;
+    }
+
+    /* packed generator rows; G itself is no longer needed */
+    enc = ldpc_packed_encoder_create(G, N, K);
+    if (!enc) {
+      fprintf(stderr, "Encoder setup failed.\n");
+      return 1;
+    }
+    free_matrix_int(G, K);
   }
 
   /* 4. Create results directory */
@@ -184,12 +1206,20 @@ int main(void) {
 #endif
 
   /* =============================================
-   * NEW: include N, wc, wr, max_iter_spa in file name
+   * NEW: include the code ID (N, wc, wr, ...) and max_iter_spa in file name
    * ============================================= */
+  char tag[64] = "";
+  if (n_punct || n_short)
+    snprintf(tag, sizeof(tag), "_p%d_s%d", n_punct, n_short);
+  if (crc_bits)
+    snprintf(tag + strlen(tag), sizeof(tag) - strlen(tag), "_crc%d",
+             crc_bits);
+  if (flip_bits)
+    snprintf(tag + strlen(tag), sizeof(tag) - strlen(tag), "_flip%d",
+             flip_bits);
   char csv_path[256];
-  snprintf(csv_path, sizeof(csv_path),
-           "results/ldpc_ber_N%d_wc%d_wr%d_iter%d_data.csv", N, wc, wr,
-           max_iter_spa);
+  snprintf(csv_path, sizeof(csv_path), "results/ldpc_ber_%s%s_iter%d_data.csv",
+           id, tag, max_iter_spa);
 
   FILE *fp = fopen(csv_path, "w");
   if (!fp) {
@@ -197,75 +1227,160 @@ int main(void) {
     return 1;
   }
 
-  fprintf(fp, "EbN0_dB,BER_info,BER_bpsk\n");
+  const int use_crc_columns = crc_bits || flip_bits;
+  fprintf(fp, "EbN0_dB,BER_info,BER_bpsk,FER,frames,err_bits,err_frames,"
+              "BER_lo,BER_hi,FER_lo,FER_hi,stop,floor%s%s\n",
+          use_stats ? ",iter_mean,iter_p50,iter_p99,iter_max,converged,"
+                      "stalled,ns_check,ns_var,ns_syn"
+                    : "",
+          use_crc_columns ? ",detected,undetected,crc_exits,recovered" : "");
 
   printf("Saving results to: %s\n\n", csv_path);
 
-  srand((unsigned int)time(NULL));
-
-  /* buffers */
-  int *inf = malloc(K * sizeof(int));
-  int *code = malloc(N * sizeof(int));
-  double *tx = malloc(N * sizeof(double));
-  double *rx = malloc(N * sizeof(double));
-  double *LLR = malloc(N * sizeof(double));
-  int *ecc_hat = malloc(N * sizeof(int));
-  int *inf_hat = malloc(K * sizeof(int));
-
-  printf("EbN0_dB, BER_info, BER_bpsk\n");
-
-  /* 6. SNR loop */
-  for (double EbN0_dB = EbN0_min; EbN0_dB <= EbN0_max; EbN0_dB += EbN0_step) {
-
-    double EbN0 = pow(10.0, EbN0_dB / 10.0);
-    double R = (double)K / N;
-    double sigma2 = 1.0 / (2.0 * R * EbN0);
-
-    long long err_info = 0;
-    long long total_info_bits = (long long)N_trials * K;
-
-    for (int f = 0; f < N_trials; f++) {
+  /* 5. SNR points */
+  int n_points = (int)floor((EbN0_max - EbN0_min) / EbN0_step + 1e-9) + 1;
+  snr_point_t *points = calloc(n_points, sizeof(snr_point_t));
+  if (!points) {
+    fprintf(stderr, "Allocation failed.\n");
+    return 1;
+  }
 
-      for (int i = 0; i < K; i++)
-        inf[i] = rand() & 1;
+  const double R = (double)k_info / n_tx;
+  for (int p = 0; p < n_points; p++) {
+    double EbN0_dB = EbN0_min + p * EbN0_step;
+    points[p].EbN0_dB = EbN0_dB;
+    points[p].sigma2 = ldpc_awgn_sigma2(EbN0_dB, R);
+    if (use_stats && !(points[p].stats = ldpc_stats_create(max_iter_spa))) {
+      fprintf(stderr, "Allocation failed.\n");
+      return 1;
+    }
+  }
 
-      ldpc_encode(code, inf, G, N, K);
+  printf("Threads = %d, seed = %llu, max frames per point = %ld\n", n_threads,
+         (unsigned long long)seed, max_frames);
+  if (target_errors > 0)
+    printf("Target frame errors = %lld\n", target_errors);
+  if (time_budget > 0.0)
+    printf("Time budget per point = %.1f s\n", time_budget);
+  if (prune_ber > 0.0)
+    printf("Prune above BER < %.1e\n", prune_ber);
+  if (use_gpu)
+    printf("GPU decoding: %d frames per submission\n",
+           GPU_CHUNKS * FRAMES_PER_CHUNK);
+  printf("\n");
 
-      for (int i = 0; i < N; i++)
-        tx[i] = (code[i] == 1) ? +1.0 : -1.0;
+  /* 6. Run all SNR points in parallel */
+  sim_t sim;
+  memset(&sim, 0, sizeof(sim));
+  sim.H = H;
+  sim.enc = enc;
+  sim.sparse_encoder = sparse_encoder;
+  sim.qc = qc;
+  sim.cf = cfv;
+  sim.gpu = use_gpu;
+  sim.M = M;
+  sim.N = N;
+  sim.K = K;
+  sim.k_info = k_info;
+  sim.n_punct = n_punct;
+  sim.n_short = n_short;
+  sim.stats = use_stats;
+  sim.crc = crc;
+  sim.flip_bits = flip_bits;
+  sim.points = points;
+  sim.n_points = n_points;
+  sim.max_frames = max_frames;
+  sim.target_errors = target_errors;
+  sim.time_budget = time_budget;
+  sim.prune_ber = prune_ber;
+  sim.seed = seed;
 
-      for (int i = 0; i < N; i++)
-        rx[i] = tx[i] + sqrt(sigma2) * randn();
+  if (sim_run(&sim, n_threads)) {
+    fprintf(stderr, "Simulation failed (thread, encoder or decoder setup).\n");
+    return 1;
+  }
 
-      for (int i = 0; i < N; i++)
-        LLR[i] = 2.0 * rx[i] / sigma2;
+  int *floor_flag = calloc(n_points, sizeof(int));
+  if (!floor_flag) {
+    fprintf(stderr, "Allocation failed.\n");
+    return 1;
+  }
+  detect_floor(points, n_points, k_info, floor_flag);
 
-      ldpc_decode_spa(LLR, ecc_hat, inf_hat, H, M, N, K, max_iter_spa);
+  /*
+   * Confidence intervals are 95% Wilson intervals. The FER interval is
+   * exact in the binomial sense; the BER interval treats bits as
+   * independent and is optimistic, since decoding errors come in bursts.
+   */
+  printf("\nEbN0_dB, BER_info, BER_bpsk, FER, frames, err_frames, "
+         "BER 95%% CI, stop\n");
 
-      for (int i = 0; i < K; i++)
-        if (inf[i] != inf_hat[i])
-          err_info++;
+  int first_floor = -1;
+  for (int p = 0; p < n_points; p++) {
+    const snr_point_t *pt = &points[p];
+    if (pt->stop == STOP_PRUNED) {
+      printf("%.1f, pruned\n", pt->EbN0_dB);
+      continue;
     }
 
-    double BER_info = (double)err_info / total_info_bits;
+    double EbN0 = pow(10.0, pt->EbN0_dB / 10.0);
+    double total_info_bits = (double)pt->frames * k_info;
+
+    double BER_info = point_ber(pt, k_info);
     double BER_bpsk = bpsk_ber(EbN0);
+    double FER = pt->frames ? (double)pt->err_frames / pt->frames : 0.0;
+    double ber_lo, ber_hi, fer_lo, fer_hi;
+    wilson_ci(pt->err_info, total_info_bits, &ber_lo, &ber_hi);
+    wilson_ci(pt->err_frames, (double)pt->frames, &fer_lo, &fer_hi);
 
-    printf("%.1f, %.10e, %.10e\n", EbN0_dB, BER_info, BER_bpsk);
-    fprintf(fp, "%.1f,%.10e,%.10e\n", EbN0_dB, BER_info, BER_bpsk);
+    if (floor_flag[p] && first_floor < 0)
+      first_floor = p;
+
+    printf("%.1f, %.10e, %.10e, %.4e, %lld, %lld, [%.3e, %.3e], %s%s\n",
+           pt->EbN0_dB, BER_info, BER_bpsk, FER, pt->frames, pt->err_frames,
+           ber_lo, ber_hi, stop_names[pt->stop],
+           floor_flag[p] ? " (floor?)" : "");
+    fprintf(fp, "%.1f,%.10e,%.10e,%.10e,%lld,%lld,%lld,%.10e,%.10e,%.10e,"
+                "%.10e,%s,%d",
+            pt->EbN0_dB, BER_info, BER_bpsk, FER, pt->frames, pt->err_info,
+            pt->err_frames, ber_lo, ber_hi, fer_lo, fer_hi,
+            stop_names[pt->stop], floor_flag[p]);
+    if (pt->stats)
+      write_stats_columns(fp, pt->stats);
+    if (use_crc_columns)
+      fprintf(fp, ",%lld,%lld,%lld,%lld", pt->detected, pt->undetected,
+              pt->crc_exits, pt->recovered);
+    fprintf(fp, "\n");
   }
 
+  if (first_floor >= 0)
+    printf("\nError floor suspected from Eb/N0 = %.1f dB "
+           "(BER slope flattens).\n",
+           points[first_floor].EbN0_dB);
+
   fclose(fp);
 
-  free(inf);
-  free(code);
-  free(tx);
-  free(rx);
-  free(LLR);
-  free(ecc_hat);
-  free(inf_hat);
+  if (use_stats) {
+    char stats_path[256];
+    snprintf(stats_path, sizeof(stats_path), "%.*s_stats.csv",
+             (int)(strlen(csv_path) - strlen("_data.csv")), csv_path);
+    if (write_stats_file(stats_path, points, n_points, max_iter_spa))
+      fprintf(stderr, "Cannot write %s\n", stats_path);
+    else
+      printf("\nDecoder statistics saved to %s\n", stats_path);
+  }
 
-  free_matrix_int(H, M);
-  free_matrix_int(G, K);
+  free(floor_flag);
+  for (int p = 0; p < n_points; p++)
+    ldpc_stats_destroy(points[p].stats);
+  free(points);
+  if (H)
+    free_matrix_int(H, M);
+  ldpc_packed_encoder_destroy(enc);
+  ldpc_qc_destroy(qc);
+  ldpc_crc_destroy(crc);
+  ldpc_codefile_close(cf); /* after enc, which borrows its G rows */
+  ldpc_registry_destroy(reg);
 
   printf("\nResults saved to %s\n", csv_path);
   return 0;
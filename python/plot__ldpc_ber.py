@@ -31,7 +31,10 @@ def find_latest_ldpc_csv():
     if not os.path.exists(results_dir):
         raise FileNotFoundError("results/ directory not found.")
 
-    pattern = re.compile(r"ldpc_ber_N(\d+)_wc(\d+)_wr(\d+)_iter(\d+)_data\.csv")
+    # optional code-ID tags between wr and iter (e.g. _s7_peg)
+    pattern = re.compile(
+        r"ldpc_ber_N(\d+)_wc(\d+)_wr(\d+)(?:_[a-z0-9]+)*?_iter(\d+)_data\.csv"
+    )
 
     candidates = []
     for f in os.listdir(results_dir):
@@ -0,0 +1,333 @@
+/**
+ * @file ldpc_analysis.c
+ * @brief Cycle counts, girth and cycle participation of LDPC Tanner graphs.
+ *
+ * Node numbering inside the BFS: variables 0..N-1, checks N..N+M-1.
+ *
+ *   4-cycles  : per check a, overlap counters cnt[b] (b > a) filled from
+ *               the columns of a's variables; Σ C(cnt[b], 2)
+ *   girth     : BFS per variable with first-hop branch labels
+ *   6/8-cycles: DFS over v0 c0 v1 c1 … v_{k-1} c_{k-1} (v0), all variable
+ *               indices > v0, all checks distinct
+ */
+
+#include "ldpc_analysis.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* Graph Construction                                                         */
+/* ========================================================================== */
+ldpc_graph_t *ldpc_graph_create(int **H, int M, int N) {
+  int i, j;
+
+  ldpc_graph_t *g = (ldpc_graph_t *)calloc(1, sizeof(ldpc_graph_t));
+  if (!g)
+    return NULL;
+
+  g->M = M;
+  g->N = N;
+  g->row_ptr = (int *)calloc(M + 1, sizeof(int));
+  g->col_ptr = (int *)calloc(N + 1, sizeof(int));
+  if (!g->row_ptr || !g->col_ptr) {
+    ldpc_graph_destroy(g);
+    return NULL;
+  }
+
+  for (i = 0; i < M; i++)
+    for (j = 0; j < N; j++)
+      if (H[i][j]) {
+        g->row_ptr[i + 1]++;
+        g->col_ptr[j + 1]++;
+      }
+  for (i = 0; i < M; i++)
+    g->row_ptr[i + 1] += g->row_ptr[i];
+  for (j = 0; j < N; j++)
+    g->col_ptr[j + 1] += g->col_ptr[j];
+  g->E = g->row_ptr[M];
+
+  g->col_idx = (int *)malloc(((size_t)g->E + 1) * sizeof(int));
+  g->row_idx = (int *)malloc(((size_t)g->E + 1) * sizeof(int));
+  int *fill = (int *)malloc((N + 1) * sizeof(int));
+  if (!g->col_idx || !g->row_idx || !fill) {
+    free(fill);
+    ldpc_graph_destroy(g);
+    return NULL;
+  }
+
+  memcpy(fill, g->col_ptr, N * sizeof(int));
+  for (i = 0; i < M; i++) {
+    int e = g->row_ptr[i];
+    for (j = 0; j < N; j++)
+      if (H[i][j]) {
+        g->col_idx[e++] = j;
+        g->row_idx[fill[j]++] = i;
+      }
+  }
+  free(fill);
+
+  return g;
+}
+
+void ldpc_graph_destroy(ldpc_graph_t *g) {
+  if (!g)
+    return;
+
+  free(g->row_ptr);
+  free(g->col_idx);
+  free(g->col_ptr);
+  free(g->row_idx);
+  free(g);
+}
+
+/* ========================================================================== */
+/* 4-Cycles via Check-Pair Overlaps                                           */
+/* ========================================================================== */
+long long ldpc_count_cycles4(const ldpc_graph_t *g, long long limit,
+                             long long *var_part, long long *chk_part) {
+  const int M = g->M;
+  int *cnt = (int *)calloc(M + 1, sizeof(int));
+  int *touched = (int *)malloc((M + 1) * sizeof(int));
+  long long total = 0;
+  int a, b, e, s;
+
+  if (!cnt || !touched) {
+    free(cnt);
+    free(touched);
+    return -1;
+  }
+  if (var_part)
+    memset(var_part, 0, (size_t)g->N * sizeof(long long));
+  if (chk_part)
+    memset(chk_part, 0, (size_t)M * sizeof(long long));
+
+  for (a = 0; a < M; a++) {
+    int n_touched = 0;
+
+    /* overlap of check a with every later check b */
+    for (e = g->row_ptr[a]; e < g->row_ptr[a + 1]; e++) {
+      const int v = g->col_idx[e];
+      for (s = g->col_ptr[v]; s < g->col_ptr[v + 1]; s++) {
+        b = g->row_idx[s];
+        if (b <= a)
+          continue;
+        if (cnt[b]++ == 0)
+          touched[n_touched++] = b;
+      }
+    }
+
+    for (int t = 0; t < n_touched; t++) {
+      b = touched[t];
+      long long c = (long long)cnt[b] * (cnt[b] - 1) / 2;
+      total += c;
+      if (chk_part && c) {
+        chk_part[a] += c;
+        chk_part[b] += c;
+      }
+    }
+
+    /* each shared variable lies on (t - 1) cycles of the pair (a, b) */
+    if (var_part)
+      for (e = g->row_ptr[a]; e < g->row_ptr[a + 1]; e++) {
+        const int v = g->col_idx[e];
+        for (s = g->col_ptr[v]; s < g->col_ptr[v + 1]; s++) {
+          b = g->row_idx[s];
+          if (b > a && cnt[b] >= 2)
+            var_part[v] += cnt[b] - 1;
+        }
+      }
+
+    for (int t = 0; t < n_touched; t++)
+      cnt[touched[t]] = 0;
+
+    if (limit >= 0 && total > limit)
+      break;
+  }
+
+  free(cnt);
+  free(touched);
+  return total;
+}
+
+/* ========================================================================== */
+/* 6- / 8-Cycles by Depth-First Enumeration                                   */
+/* ========================================================================== */
+typedef struct {
+  const ldpc_graph_t *g;
+  int k;         /* cycle length / 2 */
+  int *vars;     /* [k] path variables */
+  int *chks;     /* [k] path checks    */
+  int *start_on; /* [M] stamp: check is adjacent to the start variable */
+  int stamp;
+  long long count;
+  long long *var_part;
+} cycle_dfs_t;
+
+static int in_path(const int *p, int n, int x) {
+  for (int i = 0; i < n; i++)
+    if (p[i] == x)
+      return 1;
+  return 0;
+}
+
+/* path v0 c0 … v_t fixed; extend with c_t (and v_{t+1}, or close) */
+static void cycle_dfs(cycle_dfs_t *st, int t) {
+  const ldpc_graph_t *g = st->g;
+  const int v = st->vars[t];
+
+  for (int s = g->col_ptr[v]; s < g->col_ptr[v + 1]; s++) {
+    const int c = g->row_idx[s];
+    if (in_path(st->chks, t, c))
+      continue;
+
+    if (t == st->k - 1) {
+      /* closing check must also touch v0 */
+      if (st->start_on[c] == st->stamp) {
+        st->count++;
+        if (st->var_part)
+          for (int i = 0; i < st->k; i++)
+            st->var_part[st->vars[i]]++;
+      }
+      continue;
+    }
+
+    st->chks[t] = c;
+    for (int e = g->row_ptr[c]; e < g->row_ptr[c + 1]; e++) {
+      const int u = g->col_idx[e];
+      if (u <= st->vars[0] || in_path(st->vars, t + 1, u))
+        continue;
+      st->vars[t + 1] = u;
+      cycle_dfs(st, t + 1);
+    }
+  }
+}
+
+long long ldpc_count_cycles(const ldpc_graph_t *g, int length,
+                            long long *var_part) {
+  if (length == 4)
+    return ldpc_count_cycles4(g, -1, var_part, NULL);
+  if (length != 6 && length != 8)
+    return -1;
+
+  cycle_dfs_t st;
+  memset(&st, 0, sizeof(st));
+  st.g = g;
+  st.k = length / 2;
+  st.vars = (int *)malloc(st.k * sizeof(int));
+  st.chks = (int *)malloc(st.k * sizeof(int));
+  st.start_on = (int *)calloc(g->M + 1, sizeof(int));
+  st.var_part = var_part;
+  if (!st.vars || !st.chks || !st.start_on) {
+    free(st.vars);
+    free(st.chks);
+    free(st.start_on);
+    return -1;
+  }
+  if (var_part)
+    memset(var_part, 0, (size_t)g->N * sizeof(long long));
+
+  for (int v0 = 0; v0 < g->N; v0++) {
+    st.stamp = v0 + 1;
+    for (int s = g->col_ptr[v0]; s < g->col_ptr[v0 + 1]; s++)
+      st.start_on[g->row_idx[s]] = st.stamp;
+    st.vars[0] = v0;
+    cycle_dfs(&st, 0);
+  }
+
+  /* every cycle was found once in each direction */
+  if (var_part)
+    for (int v = 0; v < g->N; v++)
+      var_part[v] /= 2;
+
+  free(st.vars);
+  free(st.chks);
+  free(st.start_on);
+  return st.count / 2;
+}
+
+/* ========================================================================== */
+/* Girth by Truncated BFS                                                     */
+/* ========================================================================== */
+int ldpc_girth(const ldpc_graph_t *g, int *local_girth) {
+  const int N = g->N;
+  const int V = g->N + g->M;
+  int *dist = (int *)malloc(V * sizeof(int));
+  int *branch = (int *)malloc(V * sizeof(int));
+  int *parent = (int *)malloc(V * sizeof(int));
+  int *queue = (int *)malloc(V * sizeof(int));
+  int girth = 0;
+
+  if (!dist || !branch || !parent || !queue) {
+    free(dist);
+    free(branch);
+    free(parent);
+    free(queue);
+    return -1;
+  }
+  for (int x = 0; x < V; x++)
+    dist[x] = -1;
+
+  for (int v = 0; v < N; v++) {
+    int best = 0; /* shortest cycle through v (0: none yet) */
+    int head = 0, tail = 0;
+
+    dist[v] = 0;
+    branch[v] = -1;
+    parent[v] = -1;
+    queue[tail++] = v;
+
+    while (head < tail) {
+      const int x = queue[head++];
+
+      /* cycles closed from depth d have length >= 2d */
+      if (best && 2 * dist[x] >= best)
+        break;
+      if (!local_girth && girth && 2 * dist[x] >= girth)
+        break;
+
+      int n0, n1;
+      const int *adj;
+      if (x < N) {
+        n0 = g->col_ptr[x];
+        n1 = g->col_ptr[x + 1];
+        adj = g->row_idx;
+      } else {
+        n0 = g->row_ptr[x - N];
+        n1 = g->row_ptr[x - N + 1];
+        adj = g->col_idx;
+      }
+
+      for (int k = n0; k < n1; k++) {
+        const int y = (x < N) ? adj[k] + N : adj[k];
+        if (y == parent[x])
+          continue;
+        if (dist[y] < 0) {
+          dist[y] = dist[x] + 1;
+          branch[y] = (x == v) ? y : branch[x];
+          parent[y] = x;
+          queue[tail++] = y;
+        } else if (branch[y] != branch[x] && y != v) {
+          int len = dist[x] + dist[y] + 1;
+          if (!best || len < best)
+            best = len;
+        }
+      }
+    }
+
+    /* reset only what this BFS touched */
+    for (int q = 0; q < tail; q++)
+      dist[queue[q]] = -1;
+
+    if (local_girth)
+      local_girth[v] = best;
+    if (best && (!girth || best < girth))
+      girth = best;
+  }
+
+  free(dist);
+  free(branch);
+  free(parent);
+  free(queue);
+  return girth;
+}
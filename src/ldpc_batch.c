@@ -0,0 +1,543 @@
+/**
+ * @file ldpc_batch.c
+ * @brief Multi-frame (SIMD lane-interleaved) LDPC belief-propagation decoder.
+ *
+ * Frames are mapped to lanes: for every edge e of the shared Tanner graph
+ * the messages of all frames are stored next to each other
+ * (msg[e * lanes + l]). The check- and variable-node updates are written
+ * as loops over a compile-time lane count with branch-free bodies, so the
+ * compiler emits one vector instruction stream for all lanes.
+ *
+ * The iteration kernel is instantiated for each supported lane count and,
+ * on x86-64, for each ISA level (baseline, AVX2, AVX-512F). The best
+ * variant for the running CPU is chosen once per batch decoder.
+ *
+ * Check-node kernels follow ldpc_decoder.c:
+ *   - SPA      : total-minus-self φ-sum (φ(x) = −log(tanh(x/2)))
+ *   - Min-Sum  : branch-free min1/min2 tracking per lane, capped at
+ *                LDPC_MS_MAX, then α/β
+ */
+
+#include "ldpc_batch.h"
+#include "ldpc_util.h"
+#include "ldpc_fastmath.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define LDPC_BATCH_X86 1
+#define LDPC_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+/* ========================================================================== */
+/* Helper: φ(x) = −log(tanh(x/2)) in single precision, with safe clipping     */
+/* ========================================================================== */
+/**
+ * @brief Float version of the SPA check-node nonlinearity.
+ *
+ * Same clipping range as the double-precision spf() in ldpc_decoder.c.
+ * Built from the polynomial exp / log of ldpc_fastmath.h so that the
+ * lane loops vectorise (libm's logf / tanhf are opaque calls):
+ *
+ *   x < 1/4     : φ(x) = −log(x/2) + x²/12 − 7x⁴/1440
+ *   1/4 ≤ x ≤ 3 : φ(x) = −log((1 − t) / (1 + t)),  t = e^−x
+ *   x > 3       : φ(x) = 2·atanh(t) = 2t·(1 + t²/3 + t⁴/5)
+ *
+ * The outer ranges avoid the cancellation in 1 − t (small x) and the
+ * log of a value next to 1 (large x). All three are evaluated and
+ * merged with bit masks.
+ */
+static LDPC_ALWAYS_INLINE float spf_f(float x) {
+  /* clamp to [1e-7, 30] on the bit pattern: non-negative floats order
+   * like their patterns and every negative input (sign bit set, e.g. a
+   * rounding residue of Σφ − φ) compares below 1e-7 */
+  ldpc_fbits_t u, lo, hi;
+  u.f = x;
+  lo.f = 1e-7f;
+  hi.f = 30.0f;
+  u.i ^= (u.i ^ lo.i) & -(int32_t)(u.i < lo.i);
+  u.i ^= (u.i ^ hi.i) & -(int32_t)(u.i > hi.i);
+  x = u.f;
+
+  const float t = ldpc_fast_exp(-x);
+  const float x2 = x * x;
+  const float t2 = t * t;
+  ldpc_fbits_t arg, half, tail, mid, far, q;
+  arg.f = (1.0f - t) / (1.0f + t); /* tanh(x/2) */
+  half.f = 0.5f * x;
+  tail.f = x2 * (1.0f / 12.0f - x2 * (7.0f / 1440.0f));
+  far.f = 2.0f * t * (1.0f + t2 * (1.0f / 3.0f + t2 * 0.2f));
+
+  q.f = 0.25f;
+  const int32_t small = -(int32_t)(u.i < q.i);
+  q.f = 3.0f;
+  const int32_t large = -(int32_t)(u.i > q.i);
+  arg.i = (half.i & small) | (arg.i & ~small);
+  tail.i &= small;
+  mid.f = tail.f - ldpc_fast_log(arg.f);
+  mid.i = (far.i & large) | (mid.i & ~large);
+  return mid.f;
+}
+
+/* ========================================================================== */
+/* Lane Primitives                                                            */
+/* ========================================================================== */
+/*
+ * Each helper processes one group of L lanes. The restrict-qualified
+ * arguments tell the compiler that the lane vectors never overlap, which
+ * is what allows every loop below to become straight vector code.
+ */
+static LDPC_ALWAYS_INLINE void lanes_add(float *restrict acc,
+                                         const float *restrict m,
+                                         const int L) {
+  int l;
+  for (l = 0; l < L; l++)
+    acc[l] += m[l];
+}
+
+static LDPC_ALWAYS_INLINE void lanes_sub(float *restrict out,
+                                         const float *restrict acc,
+                                         const float *restrict m,
+                                         const int L) {
+  int l;
+  for (l = 0; l < L; l++)
+    out[l] = acc[l] - m[l];
+}
+
+/* sign product and two smallest magnitudes */
+static LDPC_ALWAYS_INLINE void
+lanes_ms_scan(const float *restrict x, float *restrict sgn,
+              float *restrict min1, float *restrict min2, const int L) {
+  int l;
+  for (l = 0; l < L; l++) {
+    float ax = fabsf(x[l]);
+    float hi = (min1[l] > ax) ? min1[l] : ax;
+    min2[l] = (min2[l] < hi) ? min2[l] : hi;
+    min1[l] = (min1[l] < ax) ? min1[l] : ax;
+    sgn[l] *= (x[l] < 0.0f) ? -1.0f : 1.0f;
+  }
+}
+
+/* extrinsic output: argmin edge gets mag2, every other edge mag1 */
+static LDPC_ALWAYS_INLINE void
+lanes_ms_out(float *restrict out, const float *restrict x,
+             const float *restrict sgn, const float *restrict min1,
+             const float *restrict mag1, const float *restrict mag2,
+             const int L) {
+  int l;
+  for (l = 0; l < L; l++) {
+    float ax = fabsf(x[l]);
+    float mag = (ax == min1[l]) ? mag2[l] : mag1[l];
+    float sx = (x[l] < 0.0f) ? -sgn[l] : sgn[l];
+    out[l] = sx * mag;
+  }
+}
+
+/* SPA: φ(|x|) per edge (kept in out), their sum and the sign product */
+static LDPC_ALWAYS_INLINE void
+lanes_spa_scan(const float *restrict x, float *restrict out,
+               float *restrict acc, float *restrict sgn, const int L) {
+  int l;
+  for (l = 0; l < L; l++) {
+    out[l] = spf_f(fabsf(x[l]));
+    acc[l] += out[l];
+    sgn[l] *= (x[l] < 0.0f) ? -1.0f : 1.0f;
+  }
+}
+
+/* SPA extrinsic output: sign · φ(Σφ − φ(|x|)), with φ(|x|) read from io */
+static LDPC_ALWAYS_INLINE void
+lanes_spa_out(float *restrict io, const float *restrict x,
+              const float *restrict sgn, const float *restrict acc,
+              const int L) {
+  int l;
+  for (l = 0; l < L; l++) {
+    float sx = (x[l] < 0.0f) ? -sgn[l] : sgn[l];
+    io[l] = sx * spf_f(acc[l] - io[l]);
+  }
+}
+
+/* ========================================================================== */
+/* One Flooding Iteration Over All Lanes                                      */
+/* ========================================================================== */
+/**
+ * @brief CN update, VN update, hard decision and per-lane syndrome weight.
+ *
+ * L is a compile-time constant at every call site, so all `l` loops have
+ * a fixed trip count and vectorise fully.
+ */
+static LDPC_ALWAYS_INLINE void batch_iterate_body(ldpc_batch_t *b,
+                                                  const int L) {
+  const ldpc_decoder_t *g = b->graph;
+  const int *row_ptr = g->row_ptr;
+  const int *col_idx = g->col_idx;
+  const int *col_ptr = g->col_ptr;
+  const int *col_edge = g->col_edge;
+  const float *llr = b->llr;
+  float *v2c = b->v2c;
+  float *c2v = b->c2v;
+  unsigned char *hard = b->hard;
+  const float alpha = b->alpha;
+  const float beta = b->beta;
+  const float cap = (float)LDPC_MS_MAX;
+  int i, j, e, s, l;
+
+  float acc[LDPC_BATCH_MAX_LANES];
+  float sgn[LDPC_BATCH_MAX_LANES];
+  float min1[LDPC_BATCH_MAX_LANES];
+  float min2[LDPC_BATCH_MAX_LANES];
+  float mag2[LDPC_BATCH_MAX_LANES];
+  unsigned char par[LDPC_BATCH_MAX_LANES];
+  int unsat[LDPC_BATCH_MAX_LANES];
+
+  /* ------------------------ Check node update ----------------------- */
+  if (b->kernel == LDPC_KERNEL_SPA) {
+    for (i = 0; i < g->M; i++) {
+      const int e0 = row_ptr[i];
+      const int e1 = row_ptr[i + 1];
+
+      /* (−1)^d: see check_sign0() in ldpc_decoder.c */
+      const float sgn0 = ((e1 - e0) & 1) ? -1.0f : 1.0f;
+      for (l = 0; l < L; l++) {
+        sgn[l] = sgn0;
+        acc[l] = 0.0f;
+      }
+      for (e = e0; e < e1; e++)
+        lanes_spa_scan(v2c + (size_t)e * L, c2v + (size_t)e * L, acc, sgn, L);
+      for (e = e0; e < e1; e++)
+        lanes_spa_out(c2v + (size_t)e * L, v2c + (size_t)e * L, sgn, acc, L);
+    }
+  } else {
+    for (i = 0; i < g->M; i++) {
+      const int e0 = row_ptr[i];
+      const int e1 = row_ptr[i + 1];
+
+      const float sgn0 = ((e1 - e0) & 1) ? -1.0f : 1.0f;
+      for (l = 0; l < L; l++) {
+        sgn[l] = sgn0;
+        min1[l] = HUGE_VALF;
+        min2[l] = HUGE_VALF;
+      }
+      for (e = e0; e < e1; e++)
+        lanes_ms_scan(v2c + (size_t)e * L, sgn, min1, min2, L);
+
+      /* mag1 = output magnitude for non-argmin edges, mag2 = for argmin;
+       * the raw min1 is kept to identify the argmin edge lane-wise; both
+       * magnitudes are capped at LDPC_MS_MAX (min2 = inf on degree 1) */
+      for (l = 0; l < L; l++) {
+        float m1 = ((min1[l] < cap) ? min1[l] : cap) - beta;
+        float m2 = ((min2[l] < cap) ? min2[l] : cap) - beta;
+        acc[l] = alpha * ((m1 > 0.0f) ? m1 : 0.0f);
+        mag2[l] = alpha * ((m2 > 0.0f) ? m2 : 0.0f);
+      }
+      for (e = e0; e < e1; e++)
+        lanes_ms_out(c2v + (size_t)e * L, v2c + (size_t)e * L, sgn, min1, acc,
+                     mag2, L);
+    }
+  }
+
+  /* -------------- Variable node update + tentative decision -------- */
+  for (j = 0; j < g->N; j++) {
+    const int s0 = col_ptr[j];
+    const int s1 = col_ptr[j + 1];
+    const float *lj = llr + (size_t)j * L;
+    unsigned char *hj = hard + (size_t)j * L;
+
+    for (l = 0; l < L; l++)
+      acc[l] = lj[l];
+    for (s = s0; s < s1; s++)
+      lanes_add(acc, c2v + (size_t)col_edge[s] * L, L);
+    for (s = s0; s < s1; s++) {
+      e = col_edge[s];
+      lanes_sub(v2c + (size_t)e * L, acc, c2v + (size_t)e * L, L);
+    }
+    for (l = 0; l < L; l++)
+      hj[l] = (acc[l] >= 0.0f) ? 1 : 0;
+  }
+
+  /* ------------------------ Syndrome weight per lane ---------------- */
+  for (l = 0; l < L; l++)
+    unsat[l] = 0;
+  for (i = 0; i < g->M; i++) {
+    for (l = 0; l < L; l++)
+      par[l] = 0;
+    for (e = row_ptr[i]; e < row_ptr[i + 1]; e++) {
+      const unsigned char *hv = hard + (size_t)col_idx[e] * L;
+      for (l = 0; l < L; l++)
+        par[l] ^= hv[l];
+    }
+    for (l = 0; l < L; l++)
+      unsat[l] += par[l];
+  }
+  for (l = 0; l < L; l++)
+    b->unsat[l] = unsat[l];
+}
+
+/* ========================================================================== */
+/* Kernel Instantiation: lane count × ISA                                     */
+/* ========================================================================== */
+#define LDPC_BATCH_DEFINE_ITER(isa, L, attr)                                   \
+  attr static void batch_iterate_##isa##_##L(ldpc_batch_t *b) {                \
+    batch_iterate_body(b, L);                                                  \
+  }
+
+LDPC_BATCH_DEFINE_ITER(generic, 8, )
+LDPC_BATCH_DEFINE_ITER(generic, 16, )
+LDPC_BATCH_DEFINE_ITER(generic, 32, )
+
+#ifdef LDPC_BATCH_X86
+LDPC_BATCH_DEFINE_ITER(avx2, 8, LDPC_TARGET("avx2"))
+LDPC_BATCH_DEFINE_ITER(avx2, 16, LDPC_TARGET("avx2"))
+LDPC_BATCH_DEFINE_ITER(avx2, 32, LDPC_TARGET("avx2"))
+LDPC_BATCH_DEFINE_ITER(avx512f, 8, LDPC_TARGET("avx512f"))
+LDPC_BATCH_DEFINE_ITER(avx512f, 16, LDPC_TARGET("avx512f"))
+LDPC_BATCH_DEFINE_ITER(avx512f, 32, LDPC_TARGET("avx512f"))
+#endif
+
+/**
+ * @brief Pick the iteration kernel for `lanes` and the running CPU.
+ */
+static ldpc_batch_iter_fn select_iterate(int lanes, const char **isa) {
+  int idx = (lanes == 8) ? 0 : (lanes == 16) ? 1 : 2;
+
+  static const ldpc_batch_iter_fn generic[3] = {
+      batch_iterate_generic_8, batch_iterate_generic_16,
+      batch_iterate_generic_32};
+
+#ifdef LDPC_BATCH_X86
+  static const ldpc_batch_iter_fn avx2[3] = {
+      batch_iterate_avx2_8, batch_iterate_avx2_16, batch_iterate_avx2_32};
+  static const ldpc_batch_iter_fn avx512f[3] = {batch_iterate_avx512f_8,
+                                                batch_iterate_avx512f_16,
+                                                batch_iterate_avx512f_32};
+
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    *isa = "avx512f";
+    return avx512f[idx];
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    *isa = "avx2";
+    return avx2[idx];
+  }
+#endif
+
+  *isa = "generic";
+  return generic[idx];
+}
+
+/* ========================================================================== */
+/* Create / Destroy / Configure                                               */
+/* ========================================================================== */
+ldpc_batch_t *ldpc_batch_create(const ldpc_decoder_t *graph, int lanes) {
+  if (!graph || (lanes != 8 && lanes != 16 && lanes != 32))
+    return NULL;
+
+  ldpc_batch_t *b = (ldpc_batch_t *)calloc(1, sizeof(ldpc_batch_t));
+  if (!b)
+    return NULL;
+
+  b->graph = graph;
+  b->lanes = lanes;
+  b->kernel = graph->kernel;
+  b->alpha = (float)graph->alpha;
+  b->beta = (float)graph->beta;
+
+  size_t nl = (size_t)graph->N * lanes;
+  size_t el = ((size_t)graph->E + 1) * lanes;
+  b->llr = (float *)malloc(nl * sizeof(float));
+  b->v2c = (float *)malloc(el * sizeof(float));
+  b->c2v = (float *)malloc(el * sizeof(float));
+  b->hard = (unsigned char *)malloc(nl);
+  if (!b->llr || !b->v2c || !b->c2v || !b->hard) {
+    ldpc_batch_destroy(b);
+    return NULL;
+  }
+
+  b->iterate = select_iterate(lanes, &b->isa);
+  return b;
+}
+
+void ldpc_batch_destroy(ldpc_batch_t *b) {
+  if (!b)
+    return;
+
+  free(b->llr);
+  free(b->v2c);
+  free(b->c2v);
+  free(b->hard);
+  free(b);
+}
+
+int ldpc_batch_set_kernel(ldpc_batch_t *b, ldpc_kernel_t kernel,
+                          double param) {
+  switch (kernel) {
+  case LDPC_KERNEL_SPA:
+  case LDPC_KERNEL_MIN_SUM:
+    b->alpha = 1.0f;
+    b->beta = 0.0f;
+    break;
+  case LDPC_KERNEL_NMS:
+    if (!(param > 0.0 && param <= 1.0))
+      return -1;
+    b->alpha = (float)param;
+    b->beta = 0.0f;
+    break;
+  case LDPC_KERNEL_OMS:
+    if (!(param >= 0.0))
+      return -1;
+    b->alpha = 1.0f;
+    b->beta = (float)param;
+    break;
+  default:
+    return -1;
+  }
+
+  b->kernel = kernel;
+  return 0;
+}
+
+/* ========================================================================== */
+/* Batch Decoding                                                             */
+/* ========================================================================== */
+/**
+ * @brief Copy the current hard decision of lane l into frame l's outputs.
+ */
+static void write_lane(const ldpc_batch_t *b, int l, int *ecc, int *inf) {
+  const int N = b->graph->N;
+  const int K = b->graph->K;
+  const int L = b->lanes;
+  int *ecc_l = ecc + (size_t)l * N;
+  int *inf_l = inf + (size_t)l * K;
+  int j;
+
+  for (j = 0; j < N; j++)
+    ecc_l[j] = b->hard[(size_t)j * L + l];
+
+  /* systematic tail: codeword = [parity (N-K) | info (K)] */
+  for (j = 0; j < K; j++)
+    inf_l[j] = ecc_l[j + (N - K)];
+}
+
+/* 1 if the hard decision of lane l satisfies every check */
+static int hard_parity_ok(const ldpc_batch_t *b, int l) {
+  const ldpc_decoder_t *g = b->graph;
+  const int L = b->lanes;
+
+  for (int i = 0; i < g->M; i++) {
+    unsigned char par = 0;
+    for (int e = g->row_ptr[i]; e < g->row_ptr[i + 1]; e++)
+      par ^= b->hard[(size_t)g->col_idx[e] * L + l];
+    if (par)
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Decode the lane-interleaved LLRs already loaded into b->llr.
+ */
+static int batch_run(ldpc_batch_t *b, int nframes, int *ecc, int *inf,
+                     int *status, int max_iter) {
+  const ldpc_decoder_t *g = b->graph;
+  const int N = g->N;
+  const int L = b->lanes;
+  int done[LDPC_BATCH_MAX_LANES];
+  int converged = 0;
+  int j, e, l, iter;
+
+  for (l = 0; l < L; l++)
+    done[l] = (l >= nframes);
+
+  for (e = 0; e < g->E; e++)
+    memcpy(b->v2c + (size_t)e * L, b->llr + (size_t)g->col_idx[e] * L,
+           L * sizeof(float));
+
+  for (j = 0; j < N; j++)
+    for (l = 0; l < L; l++)
+      b->hard[(size_t)j * L + l] = (b->llr[(size_t)j * L + l] >= 0.0f);
+
+  /* lanes whose channel word is already valid: no iteration */
+  for (l = 0; l < nframes; l++) {
+    if (!hard_parity_ok(b, l))
+      continue;
+    write_lane(b, l, ecc, inf);
+    if (status)
+      status[l] = LDPC_DECODE_OK;
+    done[l] = 1;
+    converged++;
+  }
+
+  /* ================================================================== */
+  /* Iterate until every active lane satisfies all parity checks       */
+  /* ================================================================== */
+  for (iter = 0; iter < max_iter && converged < nframes; iter++) {
+
+    b->iterate(b);
+
+    for (l = 0; l < nframes; l++) {
+      if (!done[l] && b->unsat[l] == 0) {
+        write_lane(b, l, ecc, inf);
+        if (status)
+          status[l] = LDPC_DECODE_OK;
+        done[l] = 1;
+        converged++;
+      }
+    }
+  }
+
+  /* Lanes that never converged: deliver the last tentative decision */
+  for (l = 0; l < nframes; l++) {
+    if (!done[l]) {
+      write_lane(b, l, ecc, inf);
+      if (status)
+        status[l] = LDPC_DECODE_MAX_ITER;
+    }
+  }
+
+  return converged;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Transpose frame-major LLRs into lane-interleaved floats. Unused lanes    */
+/* carry zeros and are masked from the start.                               */
+/* ------------------------------------------------------------------------ */
+int ldpc_batch_decode(ldpc_batch_t *b, const double *LLR, int nframes,
+                      int *ecc, int *inf, int *status, int max_iter) {
+  const int N = b->graph->N;
+  const int L = b->lanes;
+  int j, l;
+
+  if (nframes < 1 || nframes > L)
+    return -1;
+
+  for (j = 0; j < N; j++) {
+    float *lj = b->llr + (size_t)j * L;
+    for (l = 0; l < nframes; l++)
+      lj[l] = (float)LLR[(size_t)l * N + j];
+    for (; l < L; l++)
+      lj[l] = 0.0f;
+  }
+  return batch_run(b, nframes, ecc, inf, status, max_iter);
+}
+
+int ldpc_batch_decode_float(ldpc_batch_t *b, const float *LLR, int nframes,
+                            int *ecc, int *inf, int *status, int max_iter) {
+  const int N = b->graph->N;
+  const int L = b->lanes;
+  int j, l;
+
+  if (nframes < 1 || nframes > L)
+    return -1;
+
+  for (j = 0; j < N; j++) {
+    float *lj = b->llr + (size_t)j * L;
+    for (l = 0; l < nframes; l++)
+      lj[l] = LLR[(size_t)l * N + j];
+    for (; l < L; l++)
+      lj[l] = 0.0f;
+  }
+  return batch_run(b, nframes, ecc, inf, status, max_iter);
+}
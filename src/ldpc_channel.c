@@ -0,0 +1,169 @@
+/**
+ * @file ldpc_channel.c
+ * @brief xoshiro256** RNG, Ziggurat Gaussian and block BPSK / AWGN.
+ */
+
+#include "ldpc_channel.h"
+#include "ldpc_util.h"
+
+#include <math.h>
+#include <pthread.h>
+
+/* ============================================================================
+ *  RNG (xoshiro256**)
+ * ============================================================================
+ */
+static inline uint64_t rotl(uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+}
+
+static inline uint64_t rng_next(ldpc_rng_t *r) {
+  uint64_t *s = r->s;
+  const uint64_t result = rotl(s[1] * 5, 7) * 9;
+  const uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 45);
+  return result;
+}
+
+/* (0, 1): 53-bit mantissa, offset by half an ulp */
+static inline double rng_uniform(ldpc_rng_t *r) {
+  return ((double)(rng_next(r) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+}
+
+void ldpc_rng_seed(ldpc_rng_t *r, uint64_t seed) {
+  uint64_t sm = seed;
+  for (int i = 0; i < 4; i++)
+    r->s[i] = ldpc_splitmix64(&sm); /* never all zero */
+}
+
+uint64_t ldpc_rng_next(ldpc_rng_t *r) { return rng_next(r); }
+
+double ldpc_rng_uniform(ldpc_rng_t *r) { return rng_uniform(r); }
+
+void ldpc_rng_bits(ldpc_rng_t *r, int *bits, int n) {
+  int i = 0;
+  for (; i + 64 <= n; i += 64) {
+    uint64_t w = rng_next(r);
+    for (int b = 0; b < 64; b++)
+      bits[i + b] = (int)((w >> b) & 1);
+  }
+  if (i < n) {
+    uint64_t w = rng_next(r);
+    for (int b = 0; i < n; i++, b++)
+      bits[i] = (int)((w >> b) & 1);
+  }
+}
+
+/* ============================================================================
+ *  Ziggurat (Doornik's ZIGNOR, 128 layers)
+ *
+ *  Layer i ≥ 1 spans [0, x[i]] × [f(x[i]), f(x[i+1])], layer 0 is the base
+ *  strip of area V including the tail beyond R. A draw u·x[i] with
+ *  |u| < x[i+1]/x[i] lies inside the layer below and is accepted outright.
+ * ============================================================================
+ */
+#define ZIG_C 128
+#define ZIG_R 3.442619855899
+#define ZIG_V 9.91256303526217e-3
+
+static double zig_x[ZIG_C + 1];
+static double zig_r[ZIG_C];
+static pthread_once_t zig_once = PTHREAD_ONCE_INIT;
+
+static void zig_init(void) {
+  double f = exp(-0.5 * ZIG_R * ZIG_R);
+  zig_x[0] = ZIG_V / f;
+  zig_x[1] = ZIG_R;
+  zig_x[ZIG_C] = 0.0;
+  for (int i = 2; i < ZIG_C; i++) {
+    zig_x[i] = sqrt(-2.0 * log(ZIG_V / zig_x[i - 1] + f));
+    f = exp(-0.5 * zig_x[i] * zig_x[i]);
+  }
+  for (int i = 0; i < ZIG_C; i++)
+    zig_r[i] = zig_x[i + 1] / zig_x[i];
+}
+
+/* Marsaglia's tail method beyond R */
+static double zig_tail(ldpc_rng_t *r, int negative) {
+  double x, y;
+  do {
+    x = log(rng_uniform(r)) / ZIG_R;
+    y = log(rng_uniform(r));
+  } while (-2.0 * y < x * x);
+  return negative ? x - ZIG_R : ZIG_R - x;
+}
+
+/* tables must be initialised */
+static inline double zig_gauss(ldpc_rng_t *r) {
+  for (;;) {
+    const uint64_t w = rng_next(r);
+    const int i = (int)(w & (ZIG_C - 1));
+    /* bits 11..63 → u in [-1, 1), independent of the layer bits */
+    const double u = (double)(w >> 11) * (2.0 / 9007199254740992.0) - 1.0;
+
+    if (fabs(u) < zig_r[i])
+      return u * zig_x[i];
+    if (i == 0)
+      return zig_tail(r, u < 0);
+
+    const double x = u * zig_x[i];
+    const double f0 = exp(-0.5 * (zig_x[i] * zig_x[i] - x * x));
+    const double f1 = exp(-0.5 * (zig_x[i + 1] * zig_x[i + 1] - x * x));
+    if (f1 + rng_uniform(r) * (f0 - f1) < 1.0)
+      return x;
+  }
+}
+
+double ldpc_rng_gauss(ldpc_rng_t *r) {
+  pthread_once(&zig_once, zig_init);
+  return zig_gauss(r);
+}
+
+void ldpc_rng_gauss_fill(ldpc_rng_t *r, double *out, int n) {
+  pthread_once(&zig_once, zig_init);
+  for (int i = 0; i < n; i++)
+    out[i] = zig_gauss(r);
+}
+
+/* ============================================================================
+ *  BPSK over AWGN
+ * ============================================================================
+ */
+double ldpc_awgn_sigma2(double EbN0_dB, double R) {
+  return 1.0 / (2.0 * R * pow(10.0, EbN0_dB / 10.0));
+}
+
+void ldpc_awgn_init(ldpc_awgn_t *ch, double sigma2) {
+  ch->sigma2 = sigma2;
+  ch->sigma = sqrt(sigma2);
+  ch->llr_scale = 2.0 / sigma2;
+}
+
+void ldpc_awgn_bpsk(const ldpc_awgn_t *ch, ldpc_rng_t *r, const int *code,
+                    double *rx, double *LLR, int n) {
+  /* noise into whichever buffer is given, then one branch-free pass */
+  double *z = rx ? rx : LLR;
+  if (!z)
+    return;
+  ldpc_rng_gauss_fill(r, z, n);
+
+  const double sigma = ch->sigma, scale = ch->llr_scale;
+  if (rx && LLR) {
+    for (int i = 0; i < n; i++) {
+      const double y = (double)(2 * code[i] - 1) + sigma * z[i];
+      rx[i] = y;
+      LLR[i] = scale * y;
+    }
+  } else if (rx) {
+    for (int i = 0; i < n; i++)
+      rx[i] = (double)(2 * code[i] - 1) + sigma * z[i];
+  } else {
+    for (int i = 0; i < n; i++)
+      LLR[i] = scale * ((double)(2 * code[i] - 1) + sigma * z[i]);
+  }
+}
@@ -0,0 +1,475 @@
+/**
+ * @file ldpc_codefile.c
+ * @brief Binary code file (code.bin) writer, mmap loader and CSV reader.
+ *
+ * The writer builds the whole file image in memory (header, CSR/CSC
+ * sections in ldpc_decoder_create() edge order, packed G), checksums it
+ * and writes it with a single fwrite(). The loader maps the file, checks
+ * the header, the checksum and every index, and then only hands out
+ * pointers into the mapping; decoder and encoder contexts borrow them.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* mmap(), fstat() under -std=c99 */
+
+#include "ldpc_codefile.h"
+#include "ldpc_util.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* ============================================================================
+ *  On-disk header
+ * ============================================================================
+ */
+static const char codefile_magic[8] = {'L', 'D', 'P', 'C', 'C', 'O', 'D', 'E'};
+
+#define CODEFILE_ENDIAN_TAG 0x01020304u
+
+typedef struct {
+  char magic[8];
+  uint32_t version;
+  uint32_t endian; /* CODEFILE_ENDIAN_TAG in the writer's byte order */
+  int32_t N, M, K, wc, wr, E;
+  int32_t g_kind, g_row_words;
+  uint64_t off_row_ptr, off_col_idx, off_col_ptr, off_row_idx, off_col_edge;
+  uint64_t off_g;
+  uint64_t file_size;
+  uint64_t checksum; /* over the file with this field zeroed */
+} codefile_header_t;
+
+/* the layout above is the file format: no padding, 112 bytes */
+typedef char codefile_header_size_check[(sizeof(codefile_header_t) == 112) ? 1
+                                                                          : -1];
+
+static uint64_t align8(uint64_t x) { return (x + 7) & ~(uint64_t)7; }
+
+/**
+ * @brief 64-bit word hash (FNV-1a step plus an xorshift per word).
+ *
+ * Every step is a bijection of the running state, so any change confined
+ * to one word always changes the result. size must be a multiple of 8.
+ */
+static uint64_t codefile_checksum(const unsigned char *data, size_t size) {
+  const size_t skip = offsetof(codefile_header_t, checksum);
+  uint64_t h = 0xcbf29ce484222325ULL;
+
+  for (size_t o = 0; o < size; o += 8) {
+    uint64_t w = 0;
+    if (o != skip)
+      memcpy(&w, data + o, 8);
+    h = (h ^ w) * 0x100000001b3ULL;
+    h ^= h >> 32;
+  }
+  return h;
+}
+
+/* ============================================================================
+ *  Writer
+ * ============================================================================
+ */
+int ldpc_codefile_write(const char *path, int **H, int **G, int M, int N,
+                        int wc, int wr) {
+  int i, j;
+
+  if (!path || !H || M <= 0 || N <= M)
+    return -1;
+  const int K = N - M;
+
+  /* degrees → E */
+  int E = 0;
+  for (i = 0; i < M; i++)
+    for (j = 0; j < N; j++)
+      E += (H[i][j] != 0);
+
+  /* G kind: P only if the last K columns are the identity */
+  int g_kind = LDPC_CODEFILE_G_NONE;
+  if (G) {
+    g_kind = LDPC_CODEFILE_G_P;
+    for (int r = 0; r < K && g_kind == LDPC_CODEFILE_G_P; r++)
+      for (int c = 0; c < K; c++)
+        if (G[r][M + c] != (r == c)) {
+          g_kind = LDPC_CODEFILE_G_FULL;
+          break;
+        }
+  }
+  const int g_bits = (g_kind == LDPC_CODEFILE_G_P) ? M : N;
+  const int g_row_words = g_kind ? LDPC_WORDS(g_bits) : 0;
+
+  /* section layout */
+  codefile_header_t hd;
+  memset(&hd, 0, sizeof(hd));
+  memcpy(hd.magic, codefile_magic, sizeof(hd.magic));
+  hd.version = LDPC_CODEFILE_VERSION;
+  hd.endian = CODEFILE_ENDIAN_TAG;
+  hd.N = N;
+  hd.M = M;
+  hd.K = K;
+  hd.wc = wc;
+  hd.wr = wr;
+  hd.E = E;
+  hd.g_kind = g_kind;
+  hd.g_row_words = g_row_words;
+
+  uint64_t off = sizeof(hd);
+  hd.off_row_ptr = off;
+  off = align8(off + (uint64_t)(M + 1) * sizeof(int32_t));
+  hd.off_col_idx = off;
+  off = align8(off + (uint64_t)E * sizeof(int32_t));
+  hd.off_col_ptr = off;
+  off = align8(off + (uint64_t)(N + 1) * sizeof(int32_t));
+  hd.off_row_idx = off;
+  off = align8(off + (uint64_t)E * sizeof(int32_t));
+  hd.off_col_edge = off;
+  off = align8(off + (uint64_t)E * sizeof(int32_t));
+  hd.off_g = off;
+  off += (uint64_t)K * g_row_words * sizeof(uint64_t);
+  hd.file_size = off;
+
+  unsigned char *img = (unsigned char *)calloc(1, (size_t)hd.file_size);
+  int *fill_v = (int *)malloc((N + 1) * sizeof(int));
+  if (!img || !fill_v) {
+    free(img);
+    free(fill_v);
+    return -1;
+  }
+
+  int32_t *row_ptr = (int32_t *)(img + hd.off_row_ptr);
+  int32_t *col_idx = (int32_t *)(img + hd.off_col_idx);
+  int32_t *col_ptr = (int32_t *)(img + hd.off_col_ptr);
+  int32_t *row_idx = (int32_t *)(img + hd.off_row_idx);
+  int32_t *col_edge = (int32_t *)(img + hd.off_col_edge);
+
+  /* CSR/CSC exactly as ldpc_decoder_create() builds them */
+  for (i = 0; i < M; i++)
+    for (j = 0; j < N; j++)
+      if (H[i][j]) {
+        row_ptr[i + 1]++;
+        col_ptr[j + 1]++;
+      }
+  for (i = 0; i < M; i++)
+    row_ptr[i + 1] += row_ptr[i];
+  for (j = 0; j < N; j++)
+    col_ptr[j + 1] += col_ptr[j];
+
+  for (j = 0; j < N; j++)
+    fill_v[j] = col_ptr[j];
+  for (i = 0; i < M; i++) {
+    int e = row_ptr[i];
+    for (j = 0; j < N; j++)
+      if (H[i][j]) {
+        int s = fill_v[j]++;
+        col_idx[e] = j;
+        row_idx[s] = i;
+        col_edge[s] = e;
+        e++;
+      }
+  }
+  free(fill_v);
+
+  if (g_kind) {
+    uint64_t *g_rows = (uint64_t *)(img + hd.off_g);
+    for (int r = 0; r < K; r++)
+      ldpc_pack_bits(g_rows + (size_t)r * g_row_words, G[r], g_bits);
+  }
+
+  memcpy(img, &hd, sizeof(hd));
+  hd.checksum = codefile_checksum(img, (size_t)hd.file_size);
+  memcpy(img, &hd, sizeof(hd));
+
+  int rc = -1;
+  FILE *fp = fopen(path, "wb");
+  if (fp) {
+    if (fwrite(img, 1, (size_t)hd.file_size, fp) == (size_t)hd.file_size)
+      rc = 0;
+    if (fclose(fp))
+      rc = -1;
+  }
+  free(img);
+  return rc;
+}
+
+int ldpc_codefile_from_csv(const char *path_bin, const char *path_H,
+                           const char *path_G, int M, int N, int wc, int wr) {
+  if (!path_bin || !path_H || M <= 0 || N <= M)
+    return -3;
+  const int K = N - M;
+
+  int **H = ldpc_alloc_matrix_int(M, N);
+  int **G = ldpc_alloc_matrix_int(K, N);
+  int rc = -3;
+  if (!H || !G)
+    goto done;
+
+  if (ldpc_load_matrix_csv(H, M, N, path_H)) {
+    rc = -1;
+    goto done;
+  }
+
+  int g_rc = path_G ? ldpc_load_matrix_csv(G, K, N, path_G) : -1;
+  if (g_rc == -2) {
+    rc = -2;
+    goto done;
+  }
+
+  rc = ldpc_codefile_write(path_bin, H, (g_rc == 0) ? G : NULL, M, N, wc, wr)
+           ? -3
+           : 0;
+
+done:
+  ldpc_free_matrix_int(H, M);
+  ldpc_free_matrix_int(G, K);
+  return rc;
+}
+
+/* ============================================================================
+ *  Loader
+ * ============================================================================
+ */
+/* section [off, off + bytes) inside the file and 8-byte aligned */
+static int section_ok(uint64_t off, uint64_t bytes, uint64_t size) {
+  return (off % 8) == 0 && off >= sizeof(codefile_header_t) && off <= size &&
+         bytes <= size - off;
+}
+
+/* offsets [n+1]: starts at 0, non-decreasing, ends at E */
+static int offsets_ok(const int *ptr, int n, int E) {
+  if (ptr[0] != 0 || ptr[n] != E)
+    return 0;
+  for (int i = 0; i < n; i++)
+    if (ptr[i + 1] < ptr[i])
+      return 0;
+  return 1;
+}
+
+static int indices_ok(const int *idx, int E, int limit) {
+  for (int e = 0; e < E; e++)
+    if (idx[e] < 0 || idx[e] >= limit)
+      return 0;
+  return 1;
+}
+
+/* header, checksum and index validation; fills the views of cf */
+static int codefile_parse(ldpc_codefile_t *cf) {
+  const unsigned char *p = (const unsigned char *)cf->base;
+  codefile_header_t hd;
+
+  if (cf->size < sizeof(hd))
+    return -1;
+  memcpy(&hd, p, sizeof(hd));
+
+  if (memcmp(hd.magic, codefile_magic, sizeof(hd.magic)) ||
+      hd.version != LDPC_CODEFILE_VERSION ||
+      hd.endian != CODEFILE_ENDIAN_TAG || hd.file_size != cf->size ||
+      cf->size % 8)
+    return -1;
+  if (hd.M <= 0 || hd.N <= hd.M || hd.K != hd.N - hd.M || hd.E < 0)
+    return -1;
+  if (codefile_checksum(p, cf->size) != hd.checksum)
+    return -1;
+
+  const uint64_t size = cf->size;
+  const uint64_t E4 = (uint64_t)hd.E * sizeof(int32_t);
+  if (!section_ok(hd.off_row_ptr, (uint64_t)(hd.M + 1) * 4, size) ||
+      !section_ok(hd.off_col_idx, E4, size) ||
+      !section_ok(hd.off_col_ptr, (uint64_t)(hd.N + 1) * 4, size) ||
+      !section_ok(hd.off_row_idx, E4, size) ||
+      !section_ok(hd.off_col_edge, E4, size))
+    return -1;
+
+  int g_bits;
+  switch (hd.g_kind) {
+  case LDPC_CODEFILE_G_NONE:
+    g_bits = 0;
+    break;
+  case LDPC_CODEFILE_G_P:
+    g_bits = hd.M;
+    break;
+  case LDPC_CODEFILE_G_FULL:
+    g_bits = hd.N;
+    break;
+  default:
+    return -1;
+  }
+  if (hd.g_row_words != LDPC_WORDS(g_bits) ||
+      !section_ok(hd.off_g,
+                  (uint64_t)hd.K * hd.g_row_words * sizeof(uint64_t), size))
+    return -1;
+
+  cf->N = hd.N;
+  cf->M = hd.M;
+  cf->K = hd.K;
+  cf->wc = hd.wc;
+  cf->wr = hd.wr;
+  cf->E = hd.E;
+  cf->row_ptr = (const int *)(p + hd.off_row_ptr);
+  cf->col_idx = (const int *)(p + hd.off_col_idx);
+  cf->col_ptr = (const int *)(p + hd.off_col_ptr);
+  cf->row_idx = (const int *)(p + hd.off_row_idx);
+  cf->col_edge = (const int *)(p + hd.off_col_edge);
+  cf->g_kind = hd.g_kind;
+  cf->g_row_words = hd.g_row_words;
+  cf->g_rows = hd.g_kind ? (const uint64_t *)(p + hd.off_g) : NULL;
+
+  /* the decoders index with these without further checks */
+  if (!offsets_ok(cf->row_ptr, cf->M, cf->E) ||
+      !offsets_ok(cf->col_ptr, cf->N, cf->E) ||
+      !indices_ok(cf->col_idx, cf->E, cf->N) ||
+      !indices_ok(cf->row_idx, cf->E, cf->M) ||
+      !indices_ok(cf->col_edge, cf->E, cf->E))
+    return -1;
+  for (int j = 0; j < cf->N; j++)
+    for (int s = cf->col_ptr[j]; s < cf->col_ptr[j + 1]; s++)
+      if (cf->col_idx[cf->col_edge[s]] != j)
+        return -1;
+
+  return 0;
+}
+
+ldpc_codefile_t *ldpc_codefile_open(const char *path) {
+  if (!path)
+    return NULL;
+
+  ldpc_codefile_t *cf = (ldpc_codefile_t *)calloc(1, sizeof(ldpc_codefile_t));
+  if (!cf)
+    return NULL;
+
+#ifndef _WIN32
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    free(cf);
+    return NULL;
+  }
+  struct stat st;
+  if (fstat(fd, &st) || st.st_size < (off_t)sizeof(codefile_header_t)) {
+    close(fd);
+    free(cf);
+    return NULL;
+  }
+  cf->size = (size_t)st.st_size;
+  void *m = mmap(NULL, cf->size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (m == MAP_FAILED) {
+    free(cf);
+    return NULL;
+  }
+  cf->base = m;
+  cf->mapped = 1;
+#else
+  /* no mmap: read the file into an 8-byte aligned buffer */
+  FILE *fp = fopen(path, "rb");
+  if (!fp) {
+    free(cf);
+    return NULL;
+  }
+  long len = -1;
+  if (!fseek(fp, 0, SEEK_END))
+    len = ftell(fp);
+  if (len < (long)sizeof(codefile_header_t) || fseek(fp, 0, SEEK_SET)) {
+    fclose(fp);
+    free(cf);
+    return NULL;
+  }
+  cf->size = (size_t)len;
+  cf->base = malloc(cf->size);
+  if (!cf->base || fread(cf->base, 1, cf->size, fp) != cf->size) {
+    fclose(fp);
+    ldpc_codefile_close(cf);
+    return NULL;
+  }
+  fclose(fp);
+#endif
+
+  if (codefile_parse(cf)) {
+    ldpc_codefile_close(cf);
+    return NULL;
+  }
+  return cf;
+}
+
+void ldpc_codefile_close(ldpc_codefile_t *cf) {
+  if (!cf)
+    return;
+
+#ifndef _WIN32
+  if (cf->mapped)
+    munmap(cf->base, cf->size);
+  else
+    free(cf->base);
+#else
+  free(cf->base);
+#endif
+  free(cf);
+}
+
+void ldpc_codefile_expand_H(const ldpc_codefile_t *cf, int **H) {
+  for (int i = 0; i < cf->M; i++) {
+    memset(H[i], 0, cf->N * sizeof(int));
+    for (int e = cf->row_ptr[i]; e < cf->row_ptr[i + 1]; e++)
+      H[i][cf->col_idx[e]] = 1;
+  }
+}
+
+ldpc_decoder_t *ldpc_codefile_decoder(const ldpc_codefile_t *cf) {
+  if (!cf)
+    return NULL;
+  return ldpc_decoder_create_csr(cf->M, cf->N, cf->K, cf->E, cf->row_ptr,
+                                 cf->col_idx, cf->col_ptr, cf->row_idx,
+                                 cf->col_edge);
+}
+
+ldpc_packed_encoder_t *ldpc_codefile_encoder(const ldpc_codefile_t *cf) {
+  if (!cf || !cf->g_rows)
+    return NULL;
+  return ldpc_packed_encoder_borrow_rows(cf->g_rows, cf->N, cf->K,
+                                         cf->g_kind == LDPC_CODEFILE_G_P);
+}
+
+/* ============================================================================
+ *  CSV reader
+ * ============================================================================
+ */
+int ldpc_load_matrix_csv(int **mat, int rows, int cols, const char *path) {
+  FILE *fp = fopen(path, "r");
+  if (!fp)
+    return -1;
+
+  /* one row plus '\n' and the terminator; longer lines are skipped over */
+  char *line = (char *)malloc((size_t)cols + 2);
+  if (!line) {
+    fclose(fp);
+    return -1;
+  }
+
+  int rc = 0;
+  for (int r = 0; r < rows && rc == 0; r++) {
+    if (!fgets(line, cols + 2, fp)) {
+      rc = -2;
+      break;
+    }
+    for (int c = 0; c < cols; c++) {
+      if (line[c] != '0' && line[c] != '1') {
+        rc = -2;
+        break;
+      }
+      mat[r][c] = line[c] - '0';
+    }
+    if (!strchr(line, '\n')) {
+      int ch;
+      while ((ch = getc(fp)) != EOF && ch != '\n')
+        ;
+    }
+  }
+
+  free(line);
+  fclose(fp);
+  return rc;
+}
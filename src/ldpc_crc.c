@@ -0,0 +1,113 @@
+/**
+ * @file ldpc_crc.c
+ * @brief Bitwise CRC and its per-bit syndrome table.
+ */
+
+#include "ldpc_crc.h"
+
+#include <stdlib.h>
+
+static uint32_t width_mask(int width) {
+  return (width == 32) ? 0xFFFFFFFFu : ((1u << width) - 1u);
+}
+
+/* one MSB-first register step with input bit b */
+static inline uint32_t crc_step(const ldpc_crc_t *crc, uint32_t r, int b) {
+  const uint32_t fb = ((r >> (crc->width - 1)) ^ (uint32_t)b) & 1u;
+  r = (r << 1) & width_mask(crc->width);
+  return fb ? r ^ crc->poly : r;
+}
+
+/* ========================================================================== */
+/* Create / Destroy                                                           */
+/* ========================================================================== */
+/*
+ * Data bit j of n = k − L data bits enters a zero register as poly and is
+ * then shifted through the remaining n − 1 − j zero inputs, so the table
+ * is filled backwards with one step per bit. CRC bit t is compared with
+ * register bit L − 1 − t. The initial register shifted through n zero
+ * inputs is the constant every valid word's syndrome has to match.
+ */
+ldpc_crc_t *ldpc_crc_create(int width, uint32_t poly, uint32_t init, int k) {
+  if (width < 1 || width > 32 || k <= width)
+    return NULL;
+
+  ldpc_crc_t *crc = (ldpc_crc_t *)calloc(1, sizeof(ldpc_crc_t));
+  if (!crc)
+    return NULL;
+  crc->width = width;
+  crc->poly = poly & width_mask(width);
+  crc->init = init & width_mask(width);
+  crc->k = k;
+  crc->col = (uint32_t *)malloc((size_t)k * sizeof(uint32_t));
+  if (!crc->col) {
+    ldpc_crc_destroy(crc);
+    return NULL;
+  }
+
+  const int n = k - width;
+  uint32_t r = crc->poly;
+  for (int j = n - 1; j >= 0; j--) {
+    crc->col[j] = r;
+    r = crc_step(crc, r, 0);
+  }
+  for (int t = 0; t < width; t++)
+    crc->col[n + t] = 1u << (width - 1 - t);
+
+  r = crc->init;
+  for (int j = 0; j < n; j++)
+    r = crc_step(crc, r, 0);
+  crc->target = r;
+  return crc;
+}
+
+ldpc_crc_t *ldpc_crc_create_std(int width, int k) {
+  switch (width) {
+  case 8:
+    return ldpc_crc_create(8, LDPC_CRC8_POLY, 0, k);
+  case 16:
+    return ldpc_crc_create(16, LDPC_CRC16_POLY, 0, k);
+  case 24:
+    return ldpc_crc_create(24, LDPC_CRC24A_POLY, 0, k);
+  case 32:
+    return ldpc_crc_create(32, LDPC_CRC32_POLY, 0, k);
+  default:
+    return NULL;
+  }
+}
+
+void ldpc_crc_destroy(ldpc_crc_t *crc) {
+  if (!crc)
+    return;
+  free(crc->col);
+  free(crc);
+}
+
+/* ========================================================================== */
+/* Encode / Check                                                             */
+/* ========================================================================== */
+uint32_t ldpc_crc_compute(const ldpc_crc_t *crc, const int *bits, int n) {
+  uint32_t r = crc->init;
+  for (int j = 0; j < n; j++)
+    r = crc_step(crc, r, bits[j] & 1);
+  return r;
+}
+
+void ldpc_crc_append(const ldpc_crc_t *crc, int *inf) {
+  const int n = crc->k - crc->width;
+  const uint32_t r = ldpc_crc_compute(crc, inf, n);
+  for (int t = 0; t < crc->width; t++)
+    inf[n + t] = (int)((r >> (crc->width - 1 - t)) & 1u);
+}
+
+uint32_t ldpc_crc_syndrome(const ldpc_crc_t *crc, const int *inf) {
+  uint32_t s = 0;
+  for (int j = 0; j < crc->k; j++)
+    if (inf[j])
+      s ^= crc->col[j];
+  return s;
+}
+
+int ldpc_crc_check(const ldpc_crc_t *crc, const int *inf) {
+  return ldpc_crc_syndrome(crc, inf) == crc->target;
+}
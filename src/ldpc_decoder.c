@@ -1,10 +1,11 @@
 /**
  * @file ldpc_decoder.c
- * @brief LDPC Sum-Product (SPA) decoder and LLR computation utilities.
+ * @brief LDPC Sum-Product (SPA) / Min-Sum decoders and LLR utilities.
  *
  * This module provides:
  *   - A standard LDPC decoder based on the Sum-Product Algorithm (SPA)
  *     operating in the log-likelihood ratio (LLR) domain
+ *   - Min-Sum, Normalized Min-Sum and Offset Min-Sum check-node kernels
  *   - A helper function to compute bit-wise LLRs from per-symbol likelihoods
  *
  * The SPA implementation uses:
@@ -18,9 +19,21 @@
  */
 
 #include "ldpc_decoder.h"
+#include "ldpc_crc.h"
+#include "ldpc_stats.h"
+#include "ldpc_util.h"
 #include <math.h>
+#include <stdio.h>
 #include <stdlib.h>
 
+#if defined(__GNUC__) && !defined(__clang__)
+#define LDPC_UNROLL _Pragma("GCC unroll 12")
+#elif defined(__clang__)
+#define LDPC_UNROLL _Pragma("unroll")
+#else
+#define LDPC_UNROLL
+#endif
+
 /* ========================================================================== */
 /* Helper: sign(x)                                                            */
 /* ========================================================================== */
@@ -49,187 +62,1009 @@ static inline double spf(double x) {
 }
 
 /* ========================================================================== */
-/* Sum-Product Algorithm (SPA) LDPC Decoder                                   */
+/* Decoder Context: Edge-Indexed Tanner Graph + Message Storage               */
 /* ========================================================================== */
+static void decoder_select_sweeps(ldpc_decoder_t *dec, int enable);
+static int dominant_degree(const int *ptr, int n, int *count);
+
+/**
+ * @brief Allocate a context with message storage for E edges; the graph
+ *        arrays are attached by the caller.
+ */
+static ldpc_decoder_t *decoder_alloc(int M, int N, int K, int E) {
+  ldpc_decoder_t *dec = (ldpc_decoder_t *)calloc(1, sizeof(ldpc_decoder_t));
+  if (!dec)
+    return NULL;
+
+  dec->M = M;
+  dec->N = N;
+  dec->K = K;
+  dec->E = E;
+  dec->kernel = LDPC_KERNEL_SPA;
+  dec->alpha = 1.0;
+  dec->beta = 0.0;
+  dec->schedule = LDPC_SCHEDULE_FLOODING;
+
+  size_t E1 = (size_t)E + 1; /* never ask malloc for 0 bytes */
+  dec->v2c = (double *)calloc(E1, sizeof(double));
+  dec->c2v = (double *)calloc(E1, sizeof(double));
+  dec->post = (double *)calloc(N + 1, sizeof(double));
+  dec->syn = (unsigned char *)calloc(M + 1, 1);
+  if (!dec->v2c || !dec->c2v || !dec->post || !dec->syn) {
+    ldpc_decoder_destroy(dec);
+    return NULL;
+  }
+  return dec;
+}
+
+/**
+ * @brief Record the dominant node degrees of the attached graph and pick
+ *        the sweeps (specialized ones for supported degrees).
+ */
+static void decoder_attach_sweeps(ldpc_decoder_t *dec) {
+  dec->deg_c = dominant_degree(dec->row_ptr, dec->M, &dec->ndeg_c);
+  dec->deg_v = dominant_degree(dec->col_ptr, dec->N, &dec->ndeg_v);
+  decoder_select_sweeps(dec, 1);
+}
+
 /**
- * @brief LDPC decoding using the Sum-Product Algorithm (LLR-domain, flooding).
+ * @brief Build the CSR/CSC edge lists of H and allocate message storage once.
  *
- * Tanner graph:
- *   - H: M×N parity-check matrix
- *   - Variable nodes: N
- *   - Check nodes   : M
+ * The dense H is scanned twice here (degree count, then fill);
+ * ldpc_decoder_decode() only walks the edge lists.
+ */
+ldpc_decoder_t *ldpc_decoder_create(int **H, int M, int N, int K) {
+  int i, j;
+
+  int *row_ptr = (int *)calloc(M + 1, sizeof(int));
+  int *col_ptr = (int *)calloc(N + 1, sizeof(int));
+  if (!row_ptr || !col_ptr) {
+    free(row_ptr);
+    free(col_ptr);
+    return NULL;
+  }
+
+  /* Pass 1: node degrees → CSR/CSC offsets */
+  for (i = 0; i < M; i++) {
+    for (j = 0; j < N; j++) {
+      if (H[i][j]) {
+        row_ptr[i + 1]++;
+        col_ptr[j + 1]++;
+      }
+    }
+  }
+  for (i = 0; i < M; i++)
+    row_ptr[i + 1] += row_ptr[i];
+  for (j = 0; j < N; j++)
+    col_ptr[j + 1] += col_ptr[j];
+
+  const int E = row_ptr[M];
+
+  size_t E1 = (size_t)E + 1; /* never ask malloc for 0 bytes */
+  int *col_idx = (int *)malloc(E1 * sizeof(int));
+  int *row_idx = (int *)malloc(E1 * sizeof(int));
+  int *col_edge = (int *)malloc(E1 * sizeof(int));
+  int *fill_v = (int *)malloc((N + 1) * sizeof(int));
+  ldpc_decoder_t *dec = decoder_alloc(M, N, K, E);
+  if (!col_idx || !row_idx || !col_edge || !fill_v || !dec) {
+    free(row_ptr);
+    free(col_ptr);
+    free(col_idx);
+    free(row_idx);
+    free(col_edge);
+    free(fill_v);
+    ldpc_decoder_destroy(dec);
+    return NULL;
+  }
+
+  /* Pass 2: fill edges in CSR order and mirror them into CSC slots */
+  for (j = 0; j < N; j++)
+    fill_v[j] = col_ptr[j];
+
+  for (i = 0; i < M; i++) {
+    int e = row_ptr[i];
+    for (j = 0; j < N; j++) {
+      if (H[i][j]) {
+        int s = fill_v[j]++;
+        col_idx[e] = j;
+        row_idx[s] = i;
+        col_edge[s] = e;
+        e++;
+      }
+    }
+  }
+  free(fill_v);
+
+  dec->row_ptr = row_ptr;
+  dec->col_idx = col_idx;
+  dec->col_ptr = col_ptr;
+  dec->row_idx = row_idx;
+  dec->col_edge = col_edge;
+  dec->owns_graph = 1;
+  decoder_attach_sweeps(dec);
+  return dec;
+}
+
+ldpc_decoder_t *ldpc_decoder_create_csr(int M, int N, int K, int E,
+                                        const int *row_ptr,
+                                        const int *col_idx,
+                                        const int *col_ptr,
+                                        const int *row_idx,
+                                        const int *col_edge) {
+  if (M <= 0 || N <= 0 || K < 0 || K > N || E < 0 || !row_ptr || !col_idx ||
+      !col_ptr || !row_idx || !col_edge)
+    return NULL;
+
+  ldpc_decoder_t *dec = decoder_alloc(M, N, K, E);
+  if (!dec)
+    return NULL;
+
+  /* borrowed: no copy, released by the owner */
+  dec->row_ptr = row_ptr;
+  dec->col_idx = col_idx;
+  dec->col_ptr = col_ptr;
+  dec->row_idx = row_idx;
+  dec->col_edge = col_edge;
+  dec->owns_graph = 0;
+  decoder_attach_sweeps(dec);
+  return dec;
+}
+
+void ldpc_decoder_destroy(ldpc_decoder_t *dec) {
+  if (!dec)
+    return;
+
+  if (dec->owns_graph) {
+    free((void *)dec->row_ptr);
+    free((void *)dec->col_idx);
+    free((void *)dec->col_ptr);
+    free((void *)dec->row_idx);
+    free((void *)dec->col_edge);
+  }
+  free(dec->v2c);
+  free(dec->c2v);
+  free(dec->post);
+  free(dec->syn);
+  free(dec);
+}
+
+int ldpc_decoder_set_kernel(ldpc_decoder_t *dec, ldpc_kernel_t kernel,
+                            double param) {
+  switch (kernel) {
+  case LDPC_KERNEL_SPA:
+  case LDPC_KERNEL_MIN_SUM:
+    dec->alpha = 1.0;
+    dec->beta = 0.0;
+    break;
+  case LDPC_KERNEL_NMS:
+    if (!(param > 0.0 && param <= 1.0))
+      return -1;
+    dec->alpha = param;
+    dec->beta = 0.0;
+    break;
+  case LDPC_KERNEL_OMS:
+    if (!(param >= 0.0))
+      return -1;
+    dec->alpha = 1.0;
+    dec->beta = param;
+    break;
+  default:
+    return -1;
+  }
+
+  dec->kernel = kernel;
+  return 0;
+}
+
+int ldpc_decoder_set_stopping(ldpc_decoder_t *dec, int unchanged_iters,
+                              int syndrome_stall_iters) {
+  if (unchanged_iters < 0 || syndrome_stall_iters < 0)
+    return -1;
+
+  dec->stop_unchanged = unchanged_iters;
+  dec->stop_syndrome = syndrome_stall_iters;
+  return 0;
+}
+
+void ldpc_decoder_set_stats(ldpc_decoder_t *dec, ldpc_frame_stats_t *stats) {
+  dec->stats = stats;
+}
+
+int ldpc_decoder_set_crc(ldpc_decoder_t *dec, const ldpc_crc_t *crc) {
+  if (crc && crc->k > dec->K)
+    return -1;
+
+  dec->crc = crc;
+  return 0;
+}
+
+void ldpc_decoder_set_postprocess(ldpc_decoder_t *dec, ldpc_postprocess_fn fn,
+                                  void *ctx) {
+  dec->postprocess = fn;
+  dec->postprocess_ctx = ctx;
+}
+
+const double *ldpc_decoder_posteriors(const ldpc_decoder_t *dec) {
+  return dec->post;
+}
+
+int ldpc_decoder_set_schedule(ldpc_decoder_t *dec, ldpc_schedule_t schedule) {
+  if (schedule != LDPC_SCHEDULE_FLOODING && schedule != LDPC_SCHEDULE_LAYERED)
+    return -1;
+
+  dec->schedule = schedule;
+  return 0;
+}
+
+/* ========================================================================== */
+/* Check-Node Kernels (O(d) per check: total-minus-self)                      */
+/* ========================================================================== */
+/*
+ * Each kernel processes one check node of degree d: `in` holds its d
+ * incoming V→C messages and `out` receives the d extrinsic C→V messages.
+ * Both are contiguous because the edges of a check are consecutive in CSR
+ * order; the flooding and layered schedules share these kernels.
+ */
+
+/**
+ * @brief Initial value of the sign product of a degree-d check.
  *
- * Message notation:
- *   - u[i][j] : message from variable node j → check node i (extrinsic LLR)
- *   - v[i][j] : message from check node i → variable node j (extrinsic LLR)
+ * Bit 1 is sent as +1 (LLR > 0), so a satisfied check with d edges has
+ * Π sign(x_l) = (−1)^d: the extrinsic sign is (−1)^d · Π_{l≠k} sign(x_l).
+ * Even degrees reduce to the textbook rule.
+ */
+static inline double check_sign0(int d) { return (d & 1) ? -1.0 : 1.0; }
+
+/**
+ * @brief SPA check-node update: out = sign · φ(Σ φ(|in|)).
  *
- * Decoding steps per iteration:
- *   1) Check-node update:
- *        v[i][j] = f({ LLR[j'] + u[i][j'] | j' ≠ j, H[i][j']=1 })
- *   2) Variable-node update:
- *        u[i][j] = Σ_{i'≠i} v[i'][j]
- *   3) A-posteriori LLR:
- *        L_post[j] = LLR[j] + Σ_i v[i][j]
- *      → hard decision ecc[j] = (L_post[j] >= 0) ? 1 : 0
- *   4) Parity check:
- *        If H·ecc^T = 0, stop early.
+ * The sign product and the φ-sum are accumulated once over the whole
+ * check; each extrinsic is then derived by removing the own edge:
  *
- * Finally, the information part is extracted assuming:
- *      codeword = [parity (N-K bits) | info (K bits)]
+ *     sign_e = sign_total · sign(x_e)
+ *     out[e] = sign_e · φ( S − φ(|x_e|) ),   S = Σ_l φ(|x_l|)
  *
- * @param LLR      Input channel LLRs for each code bit (length N)
- * @param ecc      Output decoded codeword bits (length N, 0/1)
- * @param inf      Output decoded information bits (length K, 0/1)
- * @param H        Parity-check matrix (M×N), entries in {0,1}
- * @param M        Number of parity-check equations (rows of H)
- * @param N        Codeword length (columns of H)
- * @param K        Information length (systematic part length)
- * @param max_iter Maximum number of SPA iterations
+ * φ(|x_e|) is staged in out[e] between the two passes, so each edge
+ * costs two φ evaluations instead of 2·(d−1).
  */
-void ldpc_decode_spa(double *LLR, int *ecc, int *inf, int **H, int M, int N,
-                     int K, int max_iter) {
-  int i, j, k, iter;
+static void check_row_spa(const double *in, double *out, int d) {
+  double prod_sign = check_sign0(d);
+  double sum_spf_val = 0.0;
+  int k;
 
-  /* ------------------------------------------------------------------ */
-  /* Build adjacency lists for check and variable nodes                 */
-  /* ------------------------------------------------------------------ */
-  int **check_node =
-      (int **)malloc(M * sizeof(int *)); /* neighbors of check i */
-  for (i = 0; i < M; i++) {
-    check_node[i] = (int *)malloc(N * sizeof(int));
+  for (k = 0; k < d; k++) {
+    double f = spf(fabs(in[k]));
+    prod_sign *= sign_val(in[k]);
+    sum_spf_val += f;
+    out[k] = f;
   }
 
-  int *deg_c = (int *)calloc(M, sizeof(int)); /* degree of each check node    */
-  int *deg_v = (int *)calloc(N, sizeof(int)); /* degree of each variable node */
+  for (k = 0; k < d; k++) {
+    out[k] = prod_sign * sign_val(in[k]) * spf(sum_spf_val - out[k]);
+  }
+}
 
-  /* Count degrees of check nodes */
-  for (i = 0; i < M; i++) {
-    for (j = 0; j < N; j++) {
-      if (H[i][j])
-        deg_c[i]++;
+/**
+ * @brief Min-Sum family check-node update.
+ *
+ *   |out| = α · max(min_{others} |in| − β, 0)
+ *
+ * (α, β) = (1, 0) gives plain Min-Sum, β = 0 gives Normalized Min-Sum and
+ * α = 1 gives Offset Min-Sum.
+ *
+ * Two-min tracking: the smallest magnitude (min1, at edge argmin) and the
+ * second smallest (min2) are found in one pass; every edge except argmin
+ * receives min1, argmin receives min2. Both are capped at LDPC_MS_MAX.
+ */
+static void check_row_min_sum(const double *in, double *out, int d,
+                              double alpha, double beta) {
+  double prod_sign = check_sign0(d);
+  double min1 = HUGE_VAL;
+  double min2 = HUGE_VAL;
+  int argmin = -1;
+  int k;
+
+  for (k = 0; k < d; k++) {
+    double ax = fabs(in[k]);
+    prod_sign *= sign_val(in[k]);
+    if (ax < min1) {
+      min2 = min1;
+      min1 = ax;
+      argmin = k;
+    } else if (ax < min2) {
+      min2 = ax;
     }
   }
+  if (min1 > LDPC_MS_MAX) /* degree 1: min2 is still HUGE_VAL */
+    min1 = LDPC_MS_MAX;
+  if (min2 > LDPC_MS_MAX)
+    min2 = LDPC_MS_MAX;
 
-  /* Count degrees of variable nodes */
-  for (j = 0; j < N; j++) {
+  double mag1 = min1 - beta;
+  double mag2 = min2 - beta;
+  if (mag1 < 0.0)
+    mag1 = 0.0;
+  if (mag2 < 0.0)
+    mag2 = 0.0;
+  mag1 *= alpha;
+  mag2 *= alpha;
+
+  for (k = 0; k < d; k++) {
+    double mag = (k == argmin) ? mag2 : mag1;
+    out[k] = prod_sign * sign_val(in[k]) * mag;
+  }
+}
+
+/**
+ * @brief Apply the selected kernel to one check node.
+ */
+static inline void check_row(const ldpc_decoder_t *dec, const double *in,
+                             double *out, int d) {
+  if (dec->kernel == LDPC_KERNEL_SPA)
+    check_row_spa(in, out, d);
+  else
+    check_row_min_sum(in, out, d, dec->alpha, dec->beta);
+}
+
+/* ========================================================================== */
+/* Schedules                                                                  */
+/* ========================================================================== */
+/**
+ * @brief One flooding iteration: all check nodes, then all variable nodes
+ *        (flooding_check() followed by flooding_variable()).
+ *
+ *   c2v[e]    = f({ v2c[e'] | e' ∈ row i, e' ≠ e })
+ *   L_post[j] = LLR[j] + Σ_{e∈col j} c2v[e]
+ *   v2c[e]    = L_post[j] − c2v[e]
+ */
+static void flooding_check(ldpc_decoder_t *dec) {
+  const int *row_ptr = dec->row_ptr;
+  double *v2c = dec->v2c;
+  double *c2v = dec->c2v;
+  int i;
+
+  for (i = 0; i < dec->M; i++) {
+    const int e0 = row_ptr[i];
+    check_row(dec, v2c + e0, c2v + e0, row_ptr[i + 1] - e0);
+  }
+}
+
+static void flooding_variable(ldpc_decoder_t *dec, const double *LLR) {
+  const int *col_ptr = dec->col_ptr;
+  const int *col_edge = dec->col_edge;
+  double *v2c = dec->v2c;
+  double *c2v = dec->c2v;
+  double *post = dec->post;
+  int j, e, s;
+
+  for (j = 0; j < dec->N; j++) {
+    const int s0 = col_ptr[j];
+    const int s1 = col_ptr[j + 1];
+
+    double sum = LLR[j];
+    for (s = s0; s < s1; s++) {
+      sum += c2v[col_edge[s]];
+    }
+
+    for (s = s0; s < s1; s++) {
+      e = col_edge[s];
+      v2c[e] = sum - c2v[e];
+    }
+
+    post[j] = sum;
+  }
+}
+
+/**
+ * @brief One layered row update over edges e0 .. e1−1.
+ */
+static void layered_row(ldpc_decoder_t *dec, int e0, int e1) {
+  const int *col_idx = dec->col_idx;
+  double *t = dec->v2c;
+  double *c2v = dec->c2v;
+  double *post = dec->post;
+  int e;
+
+  for (e = e0; e < e1; e++)
+    t[e] = post[col_idx[e]] - c2v[e];
+
+  check_row(dec, t + e0, c2v + e0, e1 - e0);
+
+  for (e = e0; e < e1; e++)
+    post[col_idx[e]] = t[e] + c2v[e];
+}
+
+/**
+ * @brief One layered (row-serial, TDMP) iteration.
+ *
+ * Check nodes are processed one after another in row order; every check
+ * immediately refreshes the posteriors of its variables, so later checks
+ * in the same iteration already see the new information:
+ *
+ *   t[e]      = L_post[j] − c2v[e]        (extrinsic input, staged in v2c)
+ *   c2v[e]    = f({ t[e'] | e' ≠ e })
+ *   L_post[j] = t[e] + c2v[e]
+ *
+ * Only c2v and L_post carry state between iterations. Rows of H are
+ * visited in their stored order, which for generate_Hmatrix() codes means
+ * Gallager row-block by row-block (rows inside one block share no
+ * variable, so a block is an exact layer).
+ */
+static void sweep_layered(ldpc_decoder_t *dec) {
+  const int *row_ptr = dec->row_ptr;
+  int i;
+
+  for (i = 0; i < dec->M; i++)
+    layered_row(dec, row_ptr[i], row_ptr[i + 1]);
+}
+
+/* ========================================================================== */
+/* Degree-Specialized Sweeps                                                  */
+/* ========================================================================== */
+/*
+ * Most rows of a Gallager or PEG code share one check degree dc and most
+ * columns one variable degree dv, but construction leaves a few odd nodes
+ * (the shipped N1024 (3,6) code has 2 empty rows and 12 weight-2
+ * columns). The sweeps below therefore dispatch per node: a row of
+ * degree dc (a column of degree dv) runs a body that takes the degree as
+ * a compile-time constant, so the per-edge loops have a fixed trip count
+ * the compiler unrolls and the messages of one node stay in registers.
+ * Every other non-empty node takes the generic loop; empty rows are
+ * skipped. The arithmetic is the generic one in the same order, so
+ * decoded frames are bit-identical.
+ *
+ * Instances exist for dc ∈ {6, 8, 12} and dv ∈ {3, 4}; codes whose
+ * dominant degrees are not in these sets use the generic sweeps. The
+ * choice is made once per context (decoder_select_sweeps()); the kernel
+ * test is hoisted out of the rows.
+ */
+#define LDPC_SPEC_MAX_DEG 12
+
+/**
+ * @brief check_row_spa() for a constant degree D (fully unrolled).
+ */
+static LDPC_ALWAYS_INLINE void check_row_spa_fixed(const double *in,
+                                                   double *out, const int D) {
+  double prod_sign = check_sign0(D);
+  double sum_spf_val = 0.0;
+  double f[LDPC_SPEC_MAX_DEG];
+  int k;
+
+  LDPC_UNROLL
+  for (k = 0; k < D; k++) {
+    f[k] = spf(fabs(in[k]));
+    prod_sign *= sign_val(in[k]);
+    sum_spf_val += f[k];
+  }
+
+  LDPC_UNROLL
+  for (k = 0; k < D; k++)
+    out[k] = prod_sign * sign_val(in[k]) * spf(sum_spf_val - f[k]);
+}
+
+/**
+ * @brief check_row_min_sum() for a constant degree D (fully unrolled,
+ *        branch-free two-min tracking with the same tie rule).
+ */
+static LDPC_ALWAYS_INLINE void check_row_min_sum_fixed(const double *in,
+                                                       double *out,
+                                                       const int D,
+                                                       double alpha,
+                                                       double beta) {
+  double prod_sign = check_sign0(D);
+  double min1 = HUGE_VAL;
+  double min2 = HUGE_VAL;
+  int argmin = -1;
+  int k;
+
+  LDPC_UNROLL
+  for (k = 0; k < D; k++) {
+    const double ax = fabs(in[k]);
+    const int lower = ax < min1;
+    prod_sign *= sign_val(in[k]);
+    min2 = lower ? min1 : (ax < min2 ? ax : min2);
+    min1 = lower ? ax : min1;
+    argmin = lower ? k : argmin;
+  }
+  min1 = (min1 < LDPC_MS_MAX) ? min1 : LDPC_MS_MAX;
+  min2 = (min2 < LDPC_MS_MAX) ? min2 : LDPC_MS_MAX;
+
+  double mag1 = min1 - beta;
+  double mag2 = min2 - beta;
+  if (mag1 < 0.0)
+    mag1 = 0.0;
+  if (mag2 < 0.0)
+    mag2 = 0.0;
+  mag1 *= alpha;
+  mag2 *= alpha;
+
+  LDPC_UNROLL
+  for (k = 0; k < D; k++)
+    out[k] = prod_sign * sign_val(in[k]) * ((k == argmin) ? mag2 : mag1);
+}
+
+static LDPC_ALWAYS_INLINE void flooding_check_fixed(ldpc_decoder_t *dec,
+                                                    const int D) {
+  const int *row_ptr = dec->row_ptr;
+  const double *v2c = dec->v2c;
+  double *c2v = dec->c2v;
+  const int M = dec->M;
+  int i;
+
+  if (dec->kernel == LDPC_KERNEL_SPA) {
     for (i = 0; i < M; i++) {
-      if (H[i][j])
-        deg_v[j]++;
+      const int e0 = row_ptr[i];
+      const int d = row_ptr[i + 1] - e0;
+      if (d == D)
+        check_row_spa_fixed(v2c + e0, c2v + e0, D);
+      else if (d > 0)
+        check_row_spa(v2c + e0, c2v + e0, d);
+    }
+  } else {
+    const double alpha = dec->alpha, beta = dec->beta;
+    for (i = 0; i < M; i++) {
+      const int e0 = row_ptr[i];
+      const int d = row_ptr[i + 1] - e0;
+      if (d == D)
+        check_row_min_sum_fixed(v2c + e0, c2v + e0, D, alpha, beta);
+      else if (d > 0)
+        check_row_min_sum(v2c + e0, c2v + e0, d, alpha, beta);
     }
   }
+}
 
-  /* Variable-node adjacency list: variable_node[j][*] = list of check indices
-   */
-  int **variable_node = (int **)malloc(N * sizeof(int *));
-  for (j = 0; j < N; j++) {
-    variable_node[j] = (int *)malloc(deg_v[j] * sizeof(int));
+static LDPC_ALWAYS_INLINE void layered_row_fixed(ldpc_decoder_t *dec, int e0,
+                                                 const int D, int spa) {
+  const int *col = dec->col_idx + e0;
+  double *c2v = dec->c2v + e0;
+  double *post = dec->post;
+  double t[LDPC_SPEC_MAX_DEG], r[LDPC_SPEC_MAX_DEG];
+  int k;
+
+  LDPC_UNROLL
+  for (k = 0; k < D; k++)
+    t[k] = post[col[k]] - c2v[k];
+
+  if (spa)
+    check_row_spa_fixed(t, r, D);
+  else
+    check_row_min_sum_fixed(t, r, D, dec->alpha, dec->beta);
+
+  LDPC_UNROLL
+  for (k = 0; k < D; k++) {
+    c2v[k] = r[k];
+    post[col[k]] = t[k] + r[k];
   }
+}
 
-  /* Fill check_node[i][*] = columns j for which H[i][j] = 1 */
-  for (i = 0; i < M; i++) {
-    int idx = 0;
-    for (j = 0; j < N; j++) {
-      if (H[i][j]) {
-        check_node[i][idx++] = j;
-      }
+static LDPC_ALWAYS_INLINE void sweep_layered_fixed(ldpc_decoder_t *dec,
+                                                   const int D) {
+  const int *row_ptr = dec->row_ptr;
+  const int M = dec->M;
+  int i;
+
+  if (dec->kernel == LDPC_KERNEL_SPA) {
+    for (i = 0; i < M; i++) {
+      const int e0 = row_ptr[i], e1 = row_ptr[i + 1];
+      if (e1 - e0 == D)
+        layered_row_fixed(dec, e0, D, 1);
+      else if (e1 > e0)
+        layered_row(dec, e0, e1);
+    }
+  } else {
+    for (i = 0; i < M; i++) {
+      const int e0 = row_ptr[i], e1 = row_ptr[i + 1];
+      if (e1 - e0 == D)
+        layered_row_fixed(dec, e0, D, 0);
+      else if (e1 > e0)
+        layered_row(dec, e0, e1);
     }
   }
+}
+
+static LDPC_ALWAYS_INLINE void flooding_variable_fixed(ldpc_decoder_t *dec,
+                                                       const double *LLR,
+                                                       const int D) {
+  const int *col_ptr = dec->col_ptr;
+  const int *col_edge = dec->col_edge;
+  double *v2c = dec->v2c;
+  const double *c2v = dec->c2v;
+  double *post = dec->post;
+  const int N = dec->N;
+  int j, k;
 
-  /* Fill variable_node[j][*] = rows i for which H[i][j] = 1 */
   for (j = 0; j < N; j++) {
-    int idx = 0;
-    for (i = 0; i < M; i++) {
-      if (H[i][j]) {
-        variable_node[j][idx++] = i;
+    const int s0 = col_ptr[j];
+    const int d = col_ptr[j + 1] - s0;
+    const int *edge = col_edge + s0;
+    double sum = LLR[j];
+
+    if (d == D) {
+      double m[LDPC_SPEC_MAX_DEG];
+      LDPC_UNROLL
+      for (k = 0; k < D; k++) {
+        m[k] = c2v[edge[k]];
+        sum += m[k];
       }
+
+      LDPC_UNROLL
+      for (k = 0; k < D; k++)
+        v2c[edge[k]] = sum - m[k];
+    } else {
+      for (k = 0; k < d; k++)
+        sum += c2v[edge[k]];
+      for (k = 0; k < d; k++)
+        v2c[edge[k]] = sum - c2v[edge[k]];
     }
+
+    post[j] = sum;
+  }
+}
+
+#define LDPC_DEFINE_CHECK_SWEEPS(D)                                            \
+  static void flooding_check_d##D(ldpc_decoder_t *dec) {                       \
+    flooding_check_fixed(dec, D);                                              \
+  }                                                                            \
+  static void sweep_layered_d##D(ldpc_decoder_t *dec) {                        \
+    sweep_layered_fixed(dec, D);                                               \
+  }
+
+#define LDPC_DEFINE_VARIABLE_SWEEP(D)                                          \
+  static void flooding_variable_d##D(ldpc_decoder_t *dec,                      \
+                                     const double *LLR) {                      \
+    flooding_variable_fixed(dec, LLR, D);                                      \
   }
 
+LDPC_DEFINE_CHECK_SWEEPS(6)
+LDPC_DEFINE_CHECK_SWEEPS(8)
+LDPC_DEFINE_CHECK_SWEEPS(12)
+LDPC_DEFINE_VARIABLE_SWEEP(3)
+LDPC_DEFINE_VARIABLE_SWEEP(4)
+
+/**
+ * @brief Most common non-zero degree of a CSR/CSC offset array (the
+ *        smaller one on ties), or 0 if every node is empty or the
+ *        histogram cannot be allocated.
+ *
+ * @param count  Receives the number of nodes with that degree.
+ */
+static int dominant_degree(const int *ptr, int n, int *count) {
+  int dmax = 0, best = 0, i;
+
+  *count = 0;
+  for (i = 0; i < n; i++)
+    if (ptr[i + 1] - ptr[i] > dmax)
+      dmax = ptr[i + 1] - ptr[i];
+  if (dmax == 0)
+    return 0;
+
+  int *hist = (int *)calloc((size_t)dmax + 1, sizeof(int));
+  if (!hist)
+    return 0;
+  for (i = 0; i < n; i++)
+    hist[ptr[i + 1] - ptr[i]]++;
+  for (i = 1; i <= dmax; i++)
+    if (hist[i] > *count) {
+      best = i;
+      *count = hist[i];
+    }
+  free(hist);
+  return best;
+}
+
+/**
+ * @brief Point the sweep hooks at the specialized bodies matching the
+ *        dominant degrees (enable != 0) or at the generic ones.
+ */
+static void decoder_select_sweeps(ldpc_decoder_t *dec, int enable) {
+  dec->sweep_check = flooding_check;
+  dec->sweep_layer = sweep_layered;
+  dec->sweep_var = flooding_variable;
+  dec->spec_c = dec->spec_v = 0;
+  if (!enable)
+    return;
+
+  switch (dec->deg_c) {
+  case 6:
+    dec->sweep_check = flooding_check_d6;
+    dec->sweep_layer = sweep_layered_d6;
+    break;
+  case 8:
+    dec->sweep_check = flooding_check_d8;
+    dec->sweep_layer = sweep_layered_d8;
+    break;
+  case 12:
+    dec->sweep_check = flooding_check_d12;
+    dec->sweep_layer = sweep_layered_d12;
+    break;
+  default:
+    break;
+  }
+  if (dec->sweep_check != flooding_check)
+    dec->spec_c = dec->deg_c;
+
+  switch (dec->deg_v) {
+  case 3:
+    dec->sweep_var = flooding_variable_d3;
+    break;
+  case 4:
+    dec->sweep_var = flooding_variable_d4;
+    break;
+  default:
+    break;
+  }
+  if (dec->sweep_var != flooding_variable)
+    dec->spec_v = dec->deg_v;
+}
+
+int ldpc_decoder_set_specialized(ldpc_decoder_t *dec, int enable) {
+  decoder_select_sweeps(dec, enable);
+  return (dec->spec_c || dec->spec_v) ? 1 : 0;
+}
+
+int ldpc_decoder_copy_config(ldpc_decoder_t *dst, const ldpc_decoder_t *src) {
+  if (dst->M != src->M || dst->N != src->N || dst->K != src->K ||
+      dst->E != src->E)
+    return -1;
+
+  dst->kernel = src->kernel;
+  dst->alpha = src->alpha;
+  dst->beta = src->beta;
+  dst->schedule = src->schedule;
+  dst->stop_unchanged = src->stop_unchanged;
+  dst->stop_syndrome = src->stop_syndrome;
+
+  /* same degrees: take the sweeps as they are; else the same choice */
+  if (dst->deg_c == src->deg_c && dst->deg_v == src->deg_v) {
+    dst->spec_c = src->spec_c;
+    dst->spec_v = src->spec_v;
+    dst->sweep_check = src->sweep_check;
+    dst->sweep_var = src->sweep_var;
+    dst->sweep_layer = src->sweep_layer;
+  } else {
+    decoder_select_sweeps(dst, src->spec_c || src->spec_v);
+  }
+
+  dst->crc = src->crc;
+  dst->postprocess = src->postprocess;
+  dst->postprocess_ctx = src->postprocess_ctx;
+  return 0;
+}
+
+/* ========================================================================== */
+/* Belief-Propagation LDPC Decoder (SPA / Min-Sum, flooding or layered)      */
+/* ========================================================================== */
+/**
+ * @brief LDPC decoding by belief propagation (LLR domain).
+ *
+ * Tanner graph:
+ *   - H: M×N parity-check matrix
+ *   - Variable nodes: N
+ *   - Check nodes   : M
+ *   - Edges         : E (ones of H, numbered in CSR order)
+ *
+ * Message notation (e = edge between check i and variable j):
+ *   - v2c[e] : message from variable node j → check node i
+ *   - c2v[e] : message from check node i → variable node j (extrinsic LLR)
+ *   - post[j]: a-posteriori LLR of variable j
+ *
+ * Decoding steps per iteration:
+ *   1) One sweep of the selected schedule (see flooding_check(),
+ *      flooding_variable() and sweep_layered(), or their degree-
+ *      specialized instances); the check-node function f is selected by
+ *      dec->kernel (SPA, MS, NMS, OMS)
+ *   2) Hard decision:
+ *        ecc[j] = (L_post[j] >= 0) ? 1 : 0
+ *   3) Parity check, maintained incrementally: the syndrome of the
+ *      channel hard decision is computed once, afterwards only the checks
+ *      of flipped bits are toggled and an unsatisfied-check counter is
+ *      kept. Stop early when it reaches 0; a channel word that already
+ *      satisfies all checks returns before the first iteration. With a CRC attached
+ *      (ldpc_decoder_set_crc()) its syndrome is kept the same way from
+ *      the flipped information bits, and the frame also stops as soon
+ *      as the CRC passes.
+ *   4) Optional abort rules (ldpc_decoder_set_stopping()): no hard-bit
+ *      change for T iterations, or no syndrome-weight improvement for S
+ *      iterations.
+ *   5) With a statistics record attached (ldpc_decoder_set_stats()), the
+ *      phases are timed and the syndrome weight is logged per iteration.
+ *   6) A failed frame is handed to the post-processing hook, if any
+ *      (ldpc_decoder_set_postprocess()); its word is only accepted after
+ *      a full parity and CRC check.
+ *
+ * Finally, the information part is extracted assuming:
+ *      codeword = [parity (N-K bits) | info (K bits)]
+ *
+ * @param dec      Decoder context built from H
+ * @param LLR      Input channel LLRs for each code bit (length N)
+ * @param ecc      Output decoded codeword bits (length N, 0/1)
+ * @param inf      Output decoded information bits (length K, 0/1)
+ * @param max_iter Maximum number of iterations
+ */
+int ldpc_decoder_decode(ldpc_decoder_t *dec, const double *LLR, int *ecc,
+                        int *inf, int max_iter) {
+  int i, j, e, s, iter;
+  const int M = dec->M;
+  const int N = dec->N;
+  const int K = dec->K;
+  const int *row_ptr = dec->row_ptr;
+  const int *col_idx = dec->col_idx;
+  double *v2c = dec->v2c;
+  double *c2v = dec->c2v;
+  const int *col_ptr = dec->col_ptr;
+  const int *row_idx = dec->row_idx;
+  double *post = dec->post;
+  unsigned char *syn = dec->syn;
+  int status = LDPC_DECODE_MAX_ITER;
+  int unsat = 0;      /* number of unsatisfied checks            */
+  int best_unsat;     /* lowest syndrome weight seen so far      */
+  int unchanged = 0;  /* iterations without any hard-bit flip    */
+  int stalled = 0;    /* iterations without syndrome improvement */
+  ldpc_frame_stats_t *st = dec->stats;
+  unsigned long long t0 = 0, t1;
+  const ldpc_crc_t *crc = dec->crc;
+  const int crc_lo = N - K;                      /* first protected bit */
+  const int crc_hi = crc ? crc_lo + crc->k : 0;  /* one past the last   */
+  uint32_t crc_syn = 0; /* CRC syndrome of ecc[crc_lo .. crc_hi-1] */
+
   /* ------------------------------------------------------------------ */
-  /* Allocate message arrays u[i][j] (V→C) and v[i][j] (C→V)            */
-  /* For simplicity, these are allocated as M×N dense matrices.         */
+  /* Channel hard decision and its syndrome (full check, once per frame) */
   /* ------------------------------------------------------------------ */
-  double **u = (double **)malloc(M * sizeof(double *));
-  double **v = (double **)malloc(M * sizeof(double *));
+  for (j = 0; j < N; j++)
+    ecc[j] = (LLR[j] >= 0.0) ? 1 : 0;
+
   for (i = 0; i < M; i++) {
-    u[i] = (double *)calloc(N, sizeof(double));
-    v[i] = (double *)calloc(N, sizeof(double));
+    unsigned char parity = 0;
+    for (e = row_ptr[i]; e < row_ptr[i + 1]; e++)
+      parity ^= (unsigned char)ecc[col_idx[e]];
+    syn[i] = parity;
+    unsat += parity;
   }
+  best_unsat = unsat;
+  if (crc)
+    crc_syn = ldpc_crc_syndrome(crc, ecc + crc_lo);
 
-  /* ================================================================== */
-  /* Iterative Sum-Product Algorithm (flooding schedule)                */
-  /* ================================================================== */
-  for (iter = 0; iter < max_iter; iter++) {
+  /* channel word already valid: no iteration (also for max_iter = 0) */
+  if (unsat == 0)
+    status = (crc && crc_syn != crc->target) ? LDPC_DECODE_CRC_FAIL
+                                             : LDPC_DECODE_OK;
+  else if (crc && crc_syn == crc->target)
+    status = LDPC_DECODE_CRC_OK;
 
-    /* ------------------------ Check node update ------------------- */
-    for (i = 0; i < M; i++) {
-      for (k = 0; k < deg_c[i]; k++) {
-
-        int j_idx = check_node[i][k];
+  if (st) {
+    st->iterations = 0;
+    st->ticks_check = st->ticks_var = st->ticks_syn = 0;
+    st->unsat_len = 0;
+    if (st->unsat && st->unsat_cap > 0)
+      st->unsat[st->unsat_len++] = unsat;
+  }
 
-        double prod_sign = 1.0;
-        double sum_spf_val = 0.0;
+  /* ------------------------------------------------------------------ */
+  /* Initialise messages from the channel LLRs                          */
+  /* ------------------------------------------------------------------ */
+  if (dec->schedule == LDPC_SCHEDULE_LAYERED) {
+    for (j = 0; j < N; j++)
+      post[j] = LLR[j];
+    for (e = 0; e < dec->E; e++)
+      c2v[e] = 0.0;
+  } else {
+    /* post as well: an early exit (valid channel word, max_iter = 0)
+     * leaves the channel LLRs as the frame's posteriors */
+    for (j = 0; j < N; j++)
+      post[j] = LLR[j];
+    for (e = 0; e < dec->E; e++)
+      v2c[e] = LLR[col_idx[e]];
+  }
 
-        /* For each neighbor variable node (except j_idx) */
-        for (j = 0; j < deg_c[i]; j++) {
-          int var = check_node[i][j];
-          if (j != k) {
-            double x = LLR[var] + u[i][var];
-            prod_sign *= sign_val(x);
-            sum_spf_val += spf(fabs(x));
-          }
-        }
+  /* ================================================================== */
+  /* Iterative belief propagation                                       */
+  /* ================================================================== */
+  for (iter = 0; status == LDPC_DECODE_MAX_ITER && iter < max_iter; iter++) {
 
-        v[i][j_idx] = prod_sign * spf(sum_spf_val);
+    if (st)
+      t0 = ldpc_ticks();
+    if (dec->schedule == LDPC_SCHEDULE_LAYERED) {
+      dec->sweep_layer(dec);
+      if (st) {
+        t1 = ldpc_ticks();
+        st->ticks_check += t1 - t0;
+        t0 = t1;
+      }
+    } else {
+      dec->sweep_check(dec);
+      if (st) {
+        t1 = ldpc_ticks();
+        st->ticks_check += t1 - t0;
+        t0 = t1;
+      }
+      dec->sweep_var(dec, LLR);
+      if (st) {
+        t1 = ldpc_ticks();
+        st->ticks_var += t1 - t0;
+        t0 = t1;
       }
     }
 
-    /* ------------------------ Variable node update ---------------- */
+    /* ------------- Tentative decision + incremental syndrome ------- */
+    /*  Only bits that flipped since the previous iteration touch the  */
+    /*  check parities: O(N + flipped·wc) instead of O(E).             */
+    int flips = 0;
     for (j = 0; j < N; j++) {
-      for (k = 0; k < deg_v[j]; k++) {
-
-        int i_idx = variable_node[j][k];
-        double sum_v = 0.0;
-
-        /* Sum messages from all checks except i_idx */
-        for (i = 0; i < deg_v[j]; i++) {
-          int cnode = variable_node[j][i];
-          if (i != k) {
-            sum_v += v[cnode][j];
-          }
+      int bit = (post[j] >= 0.0) ? 1 : 0;
+      if (bit != ecc[j]) {
+        ecc[j] = bit;
+        flips++;
+        for (s = col_ptr[j]; s < col_ptr[j + 1]; s++) {
+          i = row_idx[s];
+          syn[i] ^= 1;
+          unsat += syn[i] ? 1 : -1;
         }
-        u[i_idx][j] = sum_v;
+        if (j >= crc_lo && j < crc_hi)
+          crc_syn ^= crc->col[j - crc_lo];
       }
     }
 
-    /* ------------------------ Tentative decision ------------------ */
-    for (j = 0; j < N; j++) {
-      double sum = LLR[j];
-      for (i = 0; i < deg_v[j]; i++) {
-        sum += v[variable_node[j][i]][j];
-      }
-      ecc[j] = (sum >= 0.0) ? 1 : 0;
+    if (st) {
+      st->ticks_syn += ldpc_ticks() - t0;
+      st->iterations = iter + 1;
+      if (st->unsat && st->unsat_len < st->unsat_cap)
+        st->unsat[st->unsat_len++] = unsat;
     }
 
-    /* ------------------------ Parity check H·ecc^T ---------------- */
-    int parity_ok = 1;
-    for (i = 0; i < M; i++) {
-      int parity = 0;
-      for (k = 0; k < deg_c[i]; k++) {
-        parity ^= ecc[check_node[i][k]];
-      }
-      if (parity != 0) {
-        parity_ok = 0;
-        break;
-      }
+    /* Early stopping if all parity checks satisfied or the CRC passes */
+    if (unsat == 0) {
+      status = (crc && crc_syn != crc->target) ? LDPC_DECODE_CRC_FAIL
+                                               : LDPC_DECODE_OK;
+      break;
+    }
+    if (crc && crc_syn == crc->target) {
+      status = LDPC_DECODE_CRC_OK;
+      break;
+    }
+
+    /* -------------------- Optional abort rules -------------------- */
+    unchanged = (flips == 0) ? unchanged + 1 : 0;
+    if (unsat < best_unsat) {
+      best_unsat = unsat;
+      stalled = 0;
+    } else {
+      stalled++;
     }
 
-    /* Early stopping if all parity checks satisfied */
-    if (parity_ok) {
+    if ((dec->stop_unchanged > 0 && unchanged >= dec->stop_unchanged) ||
+        (dec->stop_syndrome > 0 && stalled >= dec->stop_syndrome)) {
+      status = LDPC_DECODE_STALLED;
       break;
     }
   }
 
+  /* ------------------------------------------------------------------ */
+  /* Failed frame: post-processing hook, accepted only if fully valid    */
+  /* ------------------------------------------------------------------ */
+  if (status < 0 && dec->postprocess &&
+      dec->postprocess(dec, LLR, ecc, dec->postprocess_ctx)) {
+    int valid = 1;
+    for (i = 0; i < M && valid; i++) {
+      unsigned char parity = 0;
+      for (e = row_ptr[i]; e < row_ptr[i + 1]; e++)
+        parity ^= (unsigned char)ecc[col_idx[e]];
+      valid = !parity;
+    }
+    if (valid && crc)
+      valid = ldpc_crc_check(crc, ecc + crc_lo);
+
+    if (valid) {
+      status = LDPC_DECODE_RECOVERED;
+      unsat = 0;
+      for (i = 0; i < M; i++)
+        syn[i] = 0;
+    } else {
+      /* back to the last hard decision (post = LLR if no iteration) */
+      for (j = 0; j < N; j++)
+        ecc[j] = (post[j] >= 0.0) ? 1 : 0;
+    }
+  }
+
   /* ------------------------------------------------------------------ */
   /* Extract information bits (systematic part)                          */
   /* Assumes: codeword layout = [parity bits (N-K) | info bits (K)]      */
@@ -238,28 +1073,117 @@ void ldpc_decode_spa(double *LLR, int *ecc, int *inf, int **H, int M, int N,
     inf[i] = ecc[i + (N - K)];
   }
 
-  /* ------------------------------------------------------------------ */
-  /* Memory cleanup                                                     */
-  /* ------------------------------------------------------------------ */
-  for (i = 0; i < M; i++) {
-    free(check_node[i]);
+  if (st) {
+    st->converged = (unsat == 0);
+    st->status = status;
+  }
+  return status;
+}
+
+/* ========================================================================== */
+/* Post-Processing: Bit Flipping on the Least Reliable Bits                   */
+/* ========================================================================== */
+/**
+ * @brief Flip ecc[j] and update the syndrome, the unsatisfied-check
+ *        count and the CRC syndrome accordingly.
+ */
+static void flip_bit(ldpc_decoder_t *dec, int *ecc, int j, int *unsat,
+                     uint32_t *crc_syn) {
+  const int crc_lo = dec->N - dec->K;
+  ecc[j] ^= 1;
+  for (int s = dec->col_ptr[j]; s < dec->col_ptr[j + 1]; s++) {
+    const int i = dec->row_idx[s];
+    dec->syn[i] ^= 1;
+    *unsat += dec->syn[i] ? 1 : -1;
   }
-  free(check_node);
+  if (dec->crc && j >= crc_lo && j < crc_lo + dec->crc->k)
+    *crc_syn ^= dec->crc->col[j - crc_lo];
+}
+
+/**
+ * @brief Chase-style search over the p least reliable bits.
+ *
+ * Reliabilities are |post[j]|; the p smallest are kept in a sorted list
+ * (O(N·p)). Gray-code order changes one bit per pattern, so each of the
+ * 2^p − 1 candidates costs O(wc) instead of a full syndrome. If no
+ * pattern is valid the last one (only bit p−1, the most reliable of the
+ * p, set) is undone, restoring ecc and dec->syn.
+ */
+int ldpc_postprocess_flip(ldpc_decoder_t *dec, const double *LLR, int *ecc,
+                          void *ctx) {
+  const int N = dec->N;
+  const ldpc_crc_t *crc = dec->crc;
+  int p = ctx ? *(const int *)ctx : LDPC_FLIP_DEFAULT_BITS;
+  int pos[LDPC_FLIP_MAX_BITS];
+  double rel[LDPC_FLIP_MAX_BITS];
+  int n = 0, i, j, k;
+
+  (void)LLR; /* the posteriors already include the channel */
+  if (p > LDPC_FLIP_MAX_BITS)
+    p = LDPC_FLIP_MAX_BITS;
+  if (p > N)
+    p = N;
+  if (p < 1)
+    return 0;
 
   for (j = 0; j < N; j++) {
-    free(variable_node[j]);
+    const double r = fabs(dec->post[j]);
+    if (n == p && r >= rel[n - 1])
+      continue;
+    k = (n < p) ? n++ : n - 1;
+    while (k > 0 && rel[k - 1] > r) {
+      rel[k] = rel[k - 1];
+      pos[k] = pos[k - 1];
+      k--;
+    }
+    rel[k] = r;
+    pos[k] = j;
   }
-  free(variable_node);
 
-  free(deg_c);
-  free(deg_v);
+  int unsat = 0;
+  for (i = 0; i < dec->M; i++)
+    unsat += dec->syn[i];
+  uint32_t crc_syn = crc ? ldpc_crc_syndrome(crc, ecc + (N - dec->K)) : 0;
 
-  for (i = 0; i < M; i++) {
-    free(u[i]);
-    free(v[i]);
+  const unsigned long patterns = 1ul << p;
+  for (unsigned long t = 1; t < patterns; t++) {
+    int b = 0;
+    while (!((t >> b) & 1ul))
+      b++;
+    flip_bit(dec, ecc, pos[b], &unsat, &crc_syn);
+    if (unsat == 0 && (!crc || crc_syn == crc->target))
+      return 1;
   }
-  free(u);
-  free(v);
+  flip_bit(dec, ecc, pos[p - 1], &unsat, &crc_syn);
+  return 0;
+}
+
+/**
+ * @brief One-shot SPA decoding (builds and releases a context per call).
+ *
+ * @param LLR      Input channel LLRs for each code bit (length N)
+ * @param ecc      Output decoded codeword bits (length N, 0/1)
+ * @param inf      Output decoded information bits (length K, 0/1)
+ * @param H        Parity-check matrix (M×N), entries in {0,1}
+ * @param M        Number of parity-check equations (rows of H)
+ * @param N        Codeword length (columns of H)
+ * @param K        Information length (systematic part length)
+ * @param max_iter Maximum number of SPA iterations
+ *
+ * @return ldpc_decoder_decode() status of the frame.
+ */
+int ldpc_decode_spa(double *LLR, int *ecc, int *inf, int **H, int M, int N,
+                    int K, int max_iter) {
+  ldpc_decoder_t *dec = ldpc_decoder_create(H, M, N, K);
+  if (!dec) {
+    fprintf(stderr, "malloc failed in ldpc_decode_spa\n");
+    exit(1);
+  }
+
+  const int status = ldpc_decoder_decode(dec, LLR, ecc, inf, max_iter);
+
+  ldpc_decoder_destroy(dec);
+  return status;
 }
 
 /* ========================================================================== */
@@ -289,49 +1213,39 @@ void ldpc_decode_spa(double *LLR, int *ecc, int *inf, int **H, int M, int N,
  */
 void compute_llr_from_pyx(double **pyx, int E, int N, double *LLR) {
   int i, k, b;
-  int logE =
-      (int)log2((double)E); /* bits per symbol, assumes E is power of 2 */
+  int logE = 0; /* bits per symbol, assumes E is a power of 2 */
+  while ((1 << (logE + 1)) <= E && logE < 30)
+    logE++;
 
   /* ------------------------------------------------------ */
-  /* Precompute bit labels for each symbol index k          */
+  /* Per symbol position: one pass over the E likelihoods,  */
+  /* each added to the label set of every bit position.     */
+  /* Bit labels are the bits of k; nothing is allocated.    */
   /* ------------------------------------------------------ */
-  int **symbol_bits = (int **)malloc(E * sizeof(int *));
-  for (k = 0; k < E; k++) {
-    symbol_bits[k] = (int *)malloc(logE * sizeof(int));
-    for (b = 0; b < logE; b++) {
-      symbol_bits[k][b] = (k >> b) & 1;
-    }
-  }
+  double p1[30], p0[30];
 
-  /* ------------------------------------------------------ */
-  /* Compute bit-wise LLR for each bit position and symbol  */
-  /* ------------------------------------------------------ */
   for (i = 0; i < N; i++) {
-    for (b = 0; b < logE; b++) {
-
-      double p1 = 0.0;
-      double p0 = 0.0;
+    for (b = 0; b < logE; b++)
+      p1[b] = p0[b] = 0.0;
 
-      for (k = 0; k < E; k++) {
-        if (symbol_bits[k][b])
-          p1 += pyx[k][i];
+    for (k = 0; k < E; k++) {
+      const double p = pyx[k][i];
+      for (b = 0; b < logE; b++) {
+        if ((k >> b) & 1)
+          p1[b] += p;
         else
-          p0 += pyx[k][i];
+          p0[b] += p;
       }
+    }
 
+    for (b = 0; b < logE; b++) {
       /* Numerical safety: avoid log(0) */
-      if (p1 <= 0.0)
-        p1 = 1e-300;
-      if (p0 <= 0.0)
-        p0 = 1e-300;
+      if (p1[b] <= 0.0)
+        p1[b] = 1e-300;
+      if (p0[b] <= 0.0)
+        p0[b] = 1e-300;
 
-      LLR[b + i * logE] = log(p1 / p0);
+      LLR[b + i * logE] = log(p1[b] / p0[b]);
     }
   }
-
-  /* cleanup */
-  for (k = 0; k < E; k++) {
-    free(symbol_bits[k]);
-  }
-  free(symbol_bits);
 }
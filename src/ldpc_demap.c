@@ -0,0 +1,260 @@
+/**
+ * @file ldpc_demap.c
+ * @brief Table-driven soft demapper for BPSK / QPSK / Gray square QAM.
+ *
+ * Every axis of a Gray square QAM is an independent Gray PAM, so the
+ * kernel works per axis on blocks of DEMAP_BLOCK symbols:
+ *
+ *   1. de-interleave the axis samples of the block into y[]
+ *   2. dist[j][s] = −(y[s] − a_j)² / (2σ²) for every level j
+ *   3. per bit: running max over the levels labelled 1 and those
+ *      labelled 0 (the label bit is a per-level constant, so the symbol
+ *      loops have no data-dependent branches)
+ *   4. max-log: LLR = max1 − max0; exact: Σ exp(dist − dmax) per label
+ *      set, LLR = log S1 − log S0. The sum of the far set underflows only
+ *      for |LLR| ≳ 85; there the max-log value is used, which differs by
+ *      less than log(L / 2) (far beyond any decoder's saturation)
+ *
+ * All symbol loops run over the full block with a compile-time trip
+ * count and vectorise; the kernel is instantiated per ISA like the batch
+ * decoder's iteration kernel.
+ */
+
+#include "ldpc_demap.h"
+#include "ldpc_util.h"
+#include "ldpc_fastmath.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define LDPC_DEMAP_X86 1
+#define LDPC_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#define DEMAP_BLOCK 64      /* symbols per kernel block          */
+#define DEMAP_MAX_DIM_BITS 4 /* bits per axis (256-QAM)           */
+
+/* ========================================================================== */
+/* Kernel                                                                     */
+/* ========================================================================== */
+static LDPC_ALWAYS_INLINE void demap_body(const ldpc_demapper_t *d,
+                                          const float *restrict iq, int nsym,
+                                          float sigma2, int maxlog,
+                                          float *restrict LLR) {
+  const int m = d->bits, L = d->levels, db = d->dim_bits;
+  const float c = 0.5f / sigma2;
+
+  float y[DEMAP_BLOCK];
+  float dist[LDPC_DEMAP_MAX_LEVELS][DEMAP_BLOCK];
+  float m1[DEMAP_MAX_DIM_BITS][DEMAP_BLOCK];
+  float m0[DEMAP_MAX_DIM_BITS][DEMAP_BLOCK];
+  float s1[DEMAP_MAX_DIM_BITS][DEMAP_BLOCK];
+  float s0[DEMAP_MAX_DIM_BITS][DEMAP_BLOCK];
+  float dmax[DEMAP_BLOCK], e[DEMAP_BLOCK];
+  int s, j, k;
+
+  for (int base = 0; base < nsym; base += DEMAP_BLOCK) {
+    const int nb = (nsym - base < DEMAP_BLOCK) ? nsym - base : DEMAP_BLOCK;
+
+    for (int ax = 0; ax < d->dims; ax++) {
+      for (s = 0; s < nb; s++)
+        y[s] = iq[2 * (size_t)(base + s) + ax];
+      for (; s < DEMAP_BLOCK; s++)
+        y[s] = 0.0f;
+
+      for (j = 0; j < L; j++) {
+        const float a = d->amp[j];
+        for (s = 0; s < DEMAP_BLOCK; s++) {
+          const float t = y[s] - a;
+          dist[j][s] = -c * t * t;
+        }
+      }
+
+      for (k = 0; k < db; k++)
+        for (s = 0; s < DEMAP_BLOCK; s++)
+          m1[k][s] = m0[k][s] = -FLT_MAX;
+      for (j = 0; j < L; j++)
+        for (k = 0; k < db; k++) {
+          float *restrict mk = ((d->label[j] >> (db - 1 - k)) & 1) ? m1[k]
+                                                                   : m0[k];
+          for (s = 0; s < DEMAP_BLOCK; s++)
+            mk[s] = (dist[j][s] > mk[s]) ? dist[j][s] : mk[s];
+        }
+
+      if (maxlog) {
+        for (k = 0; k < db; k++)
+          for (s = 0; s < DEMAP_BLOCK; s++)
+            m1[k][s] -= m0[k][s];
+      } else {
+        /* the first bit splits all levels, so its two maxima give dmax */
+        for (s = 0; s < DEMAP_BLOCK; s++)
+          dmax[s] = (m1[0][s] > m0[0][s]) ? m1[0][s] : m0[0][s];
+        for (k = 0; k < db; k++)
+          for (s = 0; s < DEMAP_BLOCK; s++)
+            s1[k][s] = s0[k][s] = 0.0f;
+        for (j = 0; j < L; j++) {
+          for (s = 0; s < DEMAP_BLOCK; s++)
+            e[s] = ldpc_fast_exp(dist[j][s] - dmax[s]);
+          for (k = 0; k < db; k++) {
+            float *restrict sk = ((d->label[j] >> (db - 1 - k)) & 1) ? s1[k]
+                                                                     : s0[k];
+            for (s = 0; s < DEMAP_BLOCK; s++)
+              sk[s] += e[s];
+          }
+        }
+        for (k = 0; k < db; k++)
+          for (s = 0; s < DEMAP_BLOCK; s++) {
+            ldpc_fbits_t ex, ml;
+            ex.f = ldpc_fast_log(s1[k][s]) - ldpc_fast_log(s0[k][s]);
+            ml.f = m1[k][s] - m0[k][s];
+            const int ok = -((s1[k][s] > 0.0f) & (s0[k][s] > 0.0f));
+            ex.i = (ex.i & ok) | (ml.i & ~ok);
+            m1[k][s] = ex.f;
+          }
+      }
+
+      float *out = LLR + (size_t)base * m + ax * db;
+      for (s = 0; s < nb; s++)
+        for (k = 0; k < db; k++)
+          out[(size_t)s * m + k] = m1[k][s];
+    }
+  }
+}
+
+#define LDPC_DEMAP_DEFINE_KERNEL(isa, attr)                                    \
+  attr static void demap_##isa(const ldpc_demapper_t *d, const float *iq,     \
+                               int nsym, float sigma2, int maxlog,             \
+                               float *LLR) {                                   \
+    demap_body(d, iq, nsym, sigma2, maxlog, LLR);                              \
+  }
+
+LDPC_DEMAP_DEFINE_KERNEL(generic, )
+
+#ifdef LDPC_DEMAP_X86
+LDPC_DEMAP_DEFINE_KERNEL(avx2, LDPC_TARGET("avx2"))
+LDPC_DEMAP_DEFINE_KERNEL(avx512f, LDPC_TARGET("avx512f"))
+#endif
+
+static ldpc_demap_fn select_kernel(const char **isa) {
+#ifdef LDPC_DEMAP_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    *isa = "avx512f";
+    return demap_avx512f;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    *isa = "avx2";
+    return demap_avx2;
+  }
+#endif
+
+  *isa = "generic";
+  return demap_generic;
+}
+
+/* ========================================================================== */
+/* Create / Destroy                                                           */
+/* ========================================================================== */
+ldpc_demapper_t *ldpc_demapper_create(ldpc_modulation_t mod) {
+  if (mod != LDPC_MOD_BPSK && mod != LDPC_MOD_QPSK && mod != LDPC_MOD_QAM16 &&
+      mod != LDPC_MOD_QAM64 && mod != LDPC_MOD_QAM256)
+    return NULL;
+
+  ldpc_demapper_t *d = (ldpc_demapper_t *)calloc(1, sizeof(ldpc_demapper_t));
+  if (!d)
+    return NULL;
+
+  const int m = (int)mod;
+  d->mod = mod;
+  d->bits = m;
+  d->dims = (m == 1) ? 1 : 2;
+  d->dim_bits = m / d->dims;
+  d->levels = 1 << d->dim_bits;
+
+  /* unit average symbol energy: dims · (L² − 1) / 3 · scale² = 1 */
+  const int L = d->levels;
+  const double scale = sqrt(3.0 / (d->dims * (double)(L * L - 1)));
+  for (int j = 0; j < L; j++) {
+    d->amp[j] = (float)((2 * j - L + 1) * scale);
+    d->label[j] = (unsigned char)(j ^ (j >> 1));
+    d->level[d->label[j]] = (unsigned char)j;
+  }
+
+  d->points = (float *)malloc(((size_t)2 << m) * sizeof(float));
+  if (!d->points) {
+    free(d);
+    return NULL;
+  }
+  const int db = d->dim_bits;
+  for (int v = 0; v < (1 << m); v++) {
+    int lab_i = (d->dims == 2) ? v >> db : v;
+    int lab_q = v & (L - 1);
+    d->points[2 * v] = d->amp[d->level[lab_i]];
+    d->points[2 * v + 1] = (d->dims == 2) ? d->amp[d->level[lab_q]] : 0.0f;
+  }
+
+  d->kernel = select_kernel(&d->isa);
+  return d;
+}
+
+void ldpc_demapper_destroy(ldpc_demapper_t *d) {
+  if (!d)
+    return;
+  free(d->points);
+  free(d);
+}
+
+/* ========================================================================== */
+/* Modulate / Demap                                                           */
+/* ========================================================================== */
+void ldpc_demap_modulate(const ldpc_demapper_t *d, const int *bits,
+                         float *iq, int nsym) {
+  const int m = d->bits;
+  for (int s = 0; s < nsym; s++) {
+    int v = 0;
+    for (int k = 0; k < m; k++)
+      v = (v << 1) | (bits[(size_t)s * m + k] & 1);
+    iq[2 * (size_t)s] = d->points[2 * v];
+    iq[2 * (size_t)s + 1] = d->points[2 * v + 1];
+  }
+}
+
+void ldpc_demap(const ldpc_demapper_t *d, const float *iq, int nsym,
+                double sigma2, ldpc_demap_mode_t mode, float *LLR) {
+  d->kernel(d, iq, nsym, (float)sigma2, mode == LDPC_DEMAP_MAXLOG, LLR);
+}
+
+int ldpc_demap_quantized(const ldpc_demapper_t *d, const float *iq, int nsym,
+                         double sigma2, ldpc_demap_mode_t mode,
+                         const ldpc_qformat_t *q, int16_t *Lq) {
+  enum { CHUNK = 4 * DEMAP_BLOCK };
+  float buf[CHUNK * 8];
+  const float scale = ldexpf(1.0f, q->frac_bits);
+  const float lmax = (float)((1 << (q->llr_bits - 1)) - 1);
+  const int m = d->bits;
+  int nsat = 0;
+
+  for (int base = 0; base < nsym; base += CHUNK) {
+    const int ns = (nsym - base < CHUNK) ? nsym - base : CHUNK;
+    d->kernel(d, iq + 2 * (size_t)base, ns, (float)sigma2,
+              mode == LDPC_DEMAP_MAXLOG, buf);
+
+    int16_t *out = Lq + (size_t)base * m;
+    for (int i = 0; i < ns * m; i++) {
+      float x = buf[i] * scale;
+      x = (x >= 0.0f) ? floorf(x + 0.5f) : -floorf(-x + 0.5f);
+      if (x > lmax) {
+        x = lmax;
+        nsat++;
+      } else if (x < -lmax) {
+        x = -lmax;
+        nsat++;
+      }
+      out[i] = (int16_t)x;
+    }
+  }
+  return nsat;
+}
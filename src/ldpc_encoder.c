@@ -12,9 +12,18 @@
  *    - c   : N-bit encoded codeword
  *
  * All operations are XOR-based (GF(2)).
+ *
+ * Two implementations are provided:
+ *   - ldpc_encode()        : reference, int-per-bit G, O(KN) scalar ANDs
+ *   - ldpc_packed_encoder  : G (or only P) packed into 64-bit words,
+ *                            row XOR selected by the set information bits
  */
 
 #include "ldpc_encoder.h"
+#include "ldpc_util.h"
+
+#include <stdlib.h>
+#include <string.h>
 
 /* ========================================================================
  *  LDPC Encoder (Generator-Matrix Based)
@@ -46,3 +55,264 @@ void ldpc_encode(int *ecc, const int *inf, int **G, int N, int K) {
     ecc[i] = acc;
   }
 }
+
+/* ========================================================================
+ *  Bit-packed Encoder
+ * ------------------------------------------------------------------------
+ *  Rows of G (or of its parity part P) are packed into uint64_t words.
+ *  A codeword is the XOR of the rows selected by the set information
+ *  bits; the kernel below XORs the rows picked by one 64-bit selection
+ *  word, walking the set bits with count-trailing-zeros.
+ * ======================================================================== */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define LDPC_ENCODER_X86 1
+#define LDPC_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+static inline int ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(x);
+#else
+  int n = 0;
+  while (!(x & 1)) {
+    x >>= 1;
+    n++;
+  }
+  return n;
+#endif
+}
+
+/* mask of the valid bits in the last word of an n-bit vector */
+static inline uint64_t tail_mask(int n) {
+  return (n % 64) ? ((1ULL << (n % 64)) - 1) : ~0ULL;
+}
+
+/**
+ * @brief acc[0..nw) ^= rows[b·stride + 0..nw) for every set bit b of sel.
+ */
+static LDPC_ALWAYS_INLINE void xor_rows_body(uint64_t *restrict acc,
+                                             const uint64_t *restrict rows,
+                                             int stride, int nw,
+                                             uint64_t sel) {
+  while (sel) {
+    const uint64_t *restrict r = rows + (size_t)ctz64(sel) * stride;
+    sel &= sel - 1;
+    for (int i = 0; i < nw; i++)
+      acc[i] ^= r[i];
+  }
+}
+
+#define LDPC_ENCODER_DEFINE_XOR(isa, attr)                                     \
+  attr static void xor_rows_##isa(uint64_t *acc, const uint64_t *rows,         \
+                                  int stride, int nw, uint64_t sel) {          \
+    xor_rows_body(acc, rows, stride, nw, sel);                                 \
+  }
+
+LDPC_ENCODER_DEFINE_XOR(generic, )
+#ifdef LDPC_ENCODER_X86
+LDPC_ENCODER_DEFINE_XOR(avx2, LDPC_TARGET("avx2"))
+LDPC_ENCODER_DEFINE_XOR(avx512f, LDPC_TARGET("avx512f"))
+#endif
+
+static ldpc_xor_rows_fn select_xor_rows(const char **isa) {
+#ifdef LDPC_ENCODER_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    *isa = "avx512f";
+    return xor_rows_avx512f;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    *isa = "avx2";
+    return xor_rows_avx2;
+  }
+#endif
+  *isa = "generic";
+  return xor_rows_generic;
+}
+
+/* ---------------------------------------------------------------------- */
+/* Pack / Unpack                                                          */
+/* ---------------------------------------------------------------------- */
+void ldpc_pack_bits(uint64_t *words, const int *bits, int n) {
+  for (int w = 0; w < LDPC_WORDS(n); w++) {
+    uint64_t v = 0;
+    int b1 = (n - w * 64 < 64) ? n - w * 64 : 64;
+    for (int b = 0; b < b1; b++)
+      v |= (uint64_t)(bits[w * 64 + b] & 1) << b;
+    words[w] = v;
+  }
+}
+
+void ldpc_unpack_bits(int *bits, const uint64_t *words, int n) {
+  for (int i = 0; i < n; i++)
+    bits[i] = (int)((words[i / 64] >> (i % 64)) & 1);
+}
+
+/* ---------------------------------------------------------------------- */
+/* Create / Destroy                                                       */
+/* ---------------------------------------------------------------------- */
+ldpc_packed_encoder_t *ldpc_packed_encoder_create(int **G, int N, int K) {
+  if (!G || K <= 0 || N <= K)
+    return NULL;
+
+  ldpc_packed_encoder_t *enc =
+      (ldpc_packed_encoder_t *)calloc(1, sizeof(ldpc_packed_encoder_t));
+  if (!enc)
+    return NULL;
+
+  enc->N = N;
+  enc->K = K;
+  enc->M = N - K;
+
+  /* systematic if the last K columns of G are the identity */
+  enc->systematic = 1;
+  for (int j = 0; j < K && enc->systematic; j++)
+    for (int i = 0; i < K; i++)
+      if (G[j][enc->M + i] != (i == j)) {
+        enc->systematic = 0;
+        break;
+      }
+
+  enc->row_bits = enc->systematic ? enc->M : N;
+  enc->row_words = LDPC_WORDS(enc->row_bits);
+  uint64_t *rows =
+      (uint64_t *)malloc((size_t)K * enc->row_words * sizeof(uint64_t));
+  if (!rows) {
+    ldpc_packed_encoder_destroy(enc);
+    return NULL;
+  }
+  enc->rows = rows;
+  enc->owns_rows = 1;
+
+  for (int j = 0; j < K; j++)
+    ldpc_pack_bits(rows + (size_t)j * enc->row_words, G[j], enc->row_bits);
+
+  enc->xor_rows = select_xor_rows(&enc->isa);
+  return enc;
+}
+
+ldpc_packed_encoder_t *ldpc_packed_encoder_borrow_rows(const uint64_t *rows,
+                                                       int N, int K,
+                                                       int systematic) {
+  if (!rows || K <= 0 || N <= K)
+    return NULL;
+
+  ldpc_packed_encoder_t *enc =
+      (ldpc_packed_encoder_t *)calloc(1, sizeof(ldpc_packed_encoder_t));
+  if (!enc)
+    return NULL;
+
+  enc->N = N;
+  enc->K = K;
+  enc->M = N - K;
+  enc->systematic = systematic ? 1 : 0;
+  enc->row_bits = enc->systematic ? enc->M : N;
+  enc->row_words = LDPC_WORDS(enc->row_bits);
+  enc->rows = rows;
+  enc->owns_rows = 0;
+
+  enc->xor_rows = select_xor_rows(&enc->isa);
+  return enc;
+}
+
+ldpc_packed_encoder_t *ldpc_packed_encoder_create_rows(const uint64_t *rows,
+                                                       int N, int K,
+                                                       int systematic) {
+  ldpc_packed_encoder_t *enc =
+      ldpc_packed_encoder_borrow_rows(rows, N, K, systematic);
+  if (!enc)
+    return NULL;
+
+  size_t bytes = (size_t)K * enc->row_words * sizeof(uint64_t);
+  uint64_t *copy = (uint64_t *)malloc(bytes);
+  if (!copy) {
+    ldpc_packed_encoder_destroy(enc);
+    return NULL;
+  }
+  memcpy(copy, rows, bytes);
+  enc->rows = copy;
+  enc->owns_rows = 1;
+  return enc;
+}
+
+void ldpc_packed_encoder_destroy(ldpc_packed_encoder_t *enc) {
+  if (!enc)
+    return;
+
+  if (enc->owns_rows)
+    free((void *)enc->rows);
+  free(enc);
+}
+
+/* ---------------------------------------------------------------------- */
+/* Encode                                                                 */
+/* ---------------------------------------------------------------------- */
+void ldpc_encode_packed(const ldpc_packed_encoder_t *enc, uint64_t *ecc,
+                        const uint64_t *inf) {
+  const int K = enc->K;
+  const int M = enc->M;
+  const int stride = enc->row_words;
+  const int kw = LDPC_WORDS(K);
+  const int nw = LDPC_WORDS(enc->N);
+
+  memset(ecc, 0, (size_t)nw * sizeof(uint64_t));
+
+  /* parity part (or full codeword): XOR of the selected rows */
+  for (int w = 0; w < kw; w++) {
+    uint64_t sel = (w == kw - 1) ? inf[w] & tail_mask(K) : inf[w];
+    enc->xor_rows(ecc, enc->rows + (size_t)w * 64 * stride, stride, stride,
+                  sel);
+  }
+
+  if (!enc->systematic)
+    return;
+
+  /* information part: c[M .. N-1] = u, shifted into place */
+  const int w0 = M / 64;
+  const int sh = M % 64;
+  for (int w = 0; w < kw; w++) {
+    uint64_t v = (w == kw - 1) ? inf[w] & tail_mask(K) : inf[w];
+    ecc[w0 + w] |= v << sh;
+    if (sh && w0 + w + 1 < nw)
+      ecc[w0 + w + 1] |= v >> (64 - sh);
+  }
+}
+
+#define LDPC_ENCODER_TILE 64 /* output words accumulated per pass */
+
+void ldpc_encode_bits(const ldpc_packed_encoder_t *enc, int *ecc,
+                      const int *inf) {
+  const int K = enc->K;
+  const int stride = enc->row_words;
+  uint64_t acc[LDPC_ENCODER_TILE];
+
+  /*
+   * The output is produced in tiles of LDPC_ENCODER_TILE words so that
+   * the accumulator stays on the stack; the selection words are rebuilt
+   * from the int input for every tile.
+   */
+  for (int t0 = 0; t0 < stride; t0 += LDPC_ENCODER_TILE) {
+    int tw = (stride - t0 < LDPC_ENCODER_TILE) ? stride - t0
+                                               : LDPC_ENCODER_TILE;
+    memset(acc, 0, (size_t)tw * sizeof(uint64_t));
+
+    for (int j0 = 0; j0 < K; j0 += 64) {
+      uint64_t sel = 0;
+      int jn = (K - j0 < 64) ? K - j0 : 64;
+      for (int b = 0; b < jn; b++)
+        sel |= (uint64_t)(inf[j0 + b] & 1) << b;
+      enc->xor_rows(acc, enc->rows + (size_t)j0 * stride + t0, stride, tw,
+                    sel);
+    }
+
+    int i1 = (t0 + tw) * 64;
+    if (i1 > enc->row_bits)
+      i1 = enc->row_bits;
+    for (int i = t0 * 64; i < i1; i++)
+      ecc[i] = (int)((acc[i / 64 - t0] >> (i % 64)) & 1);
+  }
+
+  if (enc->systematic)
+    for (int i = 0; i < K; i++)
+      ecc[enc->M + i] = inf[i];
+}
@@ -0,0 +1,331 @@
+/**
+ * @file ldpc_fixed.c
+ * @brief Fixed-point (quantized) LDPC Min-Sum decoder.
+ *
+ * Integer-only flooding decoder over the CSR/CSC edge lists of an
+ * ldpc_decoder_t. All arithmetic is on int32 accumulators with explicit
+ * saturation to the configured word lengths, so the output is fully
+ * determined by the quantization format and can serve as a bit-exact
+ * reference for hardware models.
+ *
+ * Per iteration:
+ *   1) Check node   : sign parity + min1/min2/argmin of |v2c| (two-min),
+ *                     then MS / NMS (α16 >> 4) / OMS (− β) on magnitudes
+ *   2) Variable node: post = Lq + Σ c2v            (sat. to post_bits)
+ *                     v2c  = post − c2v            (sat. to msg_bits)
+ *   3) Hard decision + parity check, early stop if H·c^T = 0
+ *
+ * Message storage is int8_t or int16_t depending on msg_bits; the decoder
+ * core is written once and specialised for both element types.
+ */
+
+#include "ldpc_fixed.h"
+#include "ldpc_util.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* Helpers: saturation and typed message access                              */
+/* ========================================================================== */
+static inline int32_t sat_count(int32_t x, int32_t max,
+                                unsigned long long *cnt) {
+  if (x > max) {
+    (*cnt)++;
+    return max;
+  }
+  if (x < -max) {
+    (*cnt)++;
+    return -max;
+  }
+  return x;
+}
+
+static LDPC_ALWAYS_INLINE int32_t msg_load(const void *p, int e,
+                                           const int wide) {
+  return wide ? ((const int16_t *)p)[e] : ((const int8_t *)p)[e];
+}
+
+static LDPC_ALWAYS_INLINE void msg_store(void *p, int e, int32_t x,
+                                         const int wide) {
+  if (wide)
+    ((int16_t *)p)[e] = (int16_t)x;
+  else
+    ((int8_t *)p)[e] = (int8_t)x;
+}
+
+/* ========================================================================== */
+/* Create / Destroy / Configure                                               */
+/* ========================================================================== */
+ldpc_fixed_t *ldpc_fixed_create(const ldpc_decoder_t *graph,
+                                const ldpc_qformat_t *q) {
+  if (!graph || !q)
+    return NULL;
+  if (q->llr_bits < 2 || q->llr_bits > 16 || q->msg_bits < 2 ||
+      q->msg_bits > 16 || q->post_bits < q->msg_bits || q->post_bits > 24 ||
+      q->frac_bits < 0 || q->frac_bits >= q->llr_bits)
+    return NULL;
+
+  ldpc_fixed_t *fx = (ldpc_fixed_t *)calloc(1, sizeof(ldpc_fixed_t));
+  if (!fx)
+    return NULL;
+
+  fx->graph = graph;
+  fx->q = *q;
+  fx->llr_max = (1 << (q->llr_bits - 1)) - 1;
+  fx->msg_max = (1 << (q->msg_bits - 1)) - 1;
+  fx->post_max = (1 << (q->post_bits - 1)) - 1;
+  fx->kernel = LDPC_KERNEL_MIN_SUM;
+  fx->alpha16 = 16;
+  fx->beta_q = 0;
+  fx->wide = (q->msg_bits > 8);
+
+  size_t msg_size = fx->wide ? sizeof(int16_t) : sizeof(int8_t);
+  fx->v2c = malloc(((size_t)graph->E + 1) * msg_size);
+  fx->c2v = malloc(((size_t)graph->E + 1) * msg_size);
+  fx->post = (int32_t *)malloc(((size_t)graph->N + 1) * sizeof(int32_t));
+  if (!fx->v2c || !fx->c2v || !fx->post) {
+    ldpc_fixed_destroy(fx);
+    return NULL;
+  }
+
+  return fx;
+}
+
+void ldpc_fixed_destroy(ldpc_fixed_t *fx) {
+  if (!fx)
+    return;
+
+  free(fx->v2c);
+  free(fx->c2v);
+  free(fx->post);
+  free(fx);
+}
+
+int ldpc_fixed_set_kernel(ldpc_fixed_t *fx, ldpc_kernel_t kernel,
+                          double param) {
+  switch (kernel) {
+  case LDPC_KERNEL_MIN_SUM:
+    fx->alpha16 = 16;
+    fx->beta_q = 0;
+    break;
+  case LDPC_KERNEL_NMS: {
+    if (!(param > 0.0 && param <= 1.0))
+      return -1;
+    int a = (int)floor(param * 16.0 + 0.5);
+    fx->alpha16 = (a < 1) ? 1 : a;
+    fx->beta_q = 0;
+    break;
+  }
+  case LDPC_KERNEL_OMS:
+    if (!(param >= 0.0))
+      return -1;
+    fx->alpha16 = 16;
+    fx->beta_q = (int)floor(ldexp(param, fx->q.frac_bits) + 0.5);
+    break;
+  default:
+    return -1; /* SPA has no fixed-point kernel */
+  }
+
+  fx->kernel = kernel;
+  return 0;
+}
+
+void ldpc_fixed_reset_counters(ldpc_fixed_t *fx) {
+  memset(&fx->counters, 0, sizeof(fx->counters));
+}
+
+/* ========================================================================== */
+/* Channel LLR Quantization                                                   */
+/* ========================================================================== */
+/**
+ * @brief q = clamp(round(LLR · 2^frac_bits), ±llr_max), half away from zero.
+ */
+int ldpc_fixed_quantize(ldpc_fixed_t *fx, const double *LLR, int16_t *Lq,
+                        int n) {
+  const double scale = ldexp(1.0, fx->q.frac_bits);
+  const double lmax = (double)fx->llr_max;
+  int i, nsat = 0;
+
+  for (i = 0; i < n; i++) {
+    double x = LLR[i] * scale;
+    x = (x >= 0.0) ? floor(x + 0.5) : -floor(-x + 0.5);
+    if (x > lmax) {
+      x = lmax;
+      nsat++;
+    } else if (x < -lmax) {
+      x = -lmax;
+      nsat++;
+    }
+    Lq[i] = (int16_t)x;
+  }
+
+  fx->counters.llr_sat += (unsigned long long)nsat;
+  return nsat;
+}
+
+/* ========================================================================== */
+/* Fixed-Point Min-Sum Decoder Core                                           */
+/* ========================================================================== */
+/**
+ * @brief 1 if ecc satisfies every parity check of the graph.
+ */
+static int fixed_parity_ok(const ldpc_decoder_t *g, const int *ecc) {
+  const int *row_ptr = g->row_ptr;
+  const int *col_idx = g->col_idx;
+  int i, e;
+
+  for (i = 0; i < g->M; i++) {
+    int parity = 0;
+    for (e = row_ptr[i]; e < row_ptr[i + 1]; e++)
+      parity ^= ecc[col_idx[e]];
+    if (parity != 0)
+      return 0;
+  }
+  return 1;
+}
+
+/**
+ * @brief Decoder body shared by the int8_t and int16_t message layouts.
+ *
+ * `wide` is a literal at both call sites, so each instantiation accesses
+ * its message arrays with a single fixed element type.
+ */
+static LDPC_ALWAYS_INLINE int fixed_decode_body(ldpc_fixed_t *fx,
+                                                const int16_t *Lq, int *ecc,
+                                                int max_iter, const int wide) {
+  const ldpc_decoder_t *g = fx->graph;
+  const int M = g->M;
+  const int N = g->N;
+  const int *row_ptr = g->row_ptr;
+  const int *col_idx = g->col_idx;
+  const int *col_ptr = g->col_ptr;
+  const int *col_edge = g->col_edge;
+  const int32_t msg_max = fx->msg_max;
+  const int32_t post_max = fx->post_max;
+  const int32_t alpha16 = fx->alpha16;
+  const int32_t beta_q = fx->beta_q;
+  void *v2c = fx->v2c;
+  void *c2v = fx->c2v;
+  int32_t *post = fx->post;
+  ldpc_fixed_counters_t *cnt = &fx->counters;
+  int i, j, e, s, iter;
+
+  /* ------------------------------------------------------------------ */
+  /* Channel hard decision: a valid word needs no iteration (and is     */
+  /* the output for max_iter = 0), as in ldpc_decoder_decode()          */
+  /* ------------------------------------------------------------------ */
+  for (j = 0; j < N; j++) {
+    post[j] = Lq[j];
+    ecc[j] = (Lq[j] >= 0) ? 1 : 0;
+  }
+  int parity_ok = fixed_parity_ok(g, ecc);
+  if (parity_ok || max_iter < 1)
+    return parity_ok;
+
+  /* ------------------------------------------------------------------ */
+  /* Initialise V→C messages with the (message-width) channel LLRs      */
+  /* ------------------------------------------------------------------ */
+  for (e = 0; e < g->E; e++)
+    msg_store(v2c, e, sat_count(Lq[col_idx[e]], msg_max, &cnt->v2c_sat),
+              wide);
+
+  for (iter = 0; iter < max_iter; iter++) {
+
+    /* ------------------------ Check node update ------------------- */
+    for (i = 0; i < M; i++) {
+      const int e0 = row_ptr[i];
+      const int e1 = row_ptr[i + 1];
+      int32_t min1 = INT32_MAX;
+      int32_t min2 = INT32_MAX;
+      int argmin = -1;
+      int sign = (e1 - e0) & 1; /* (−1)^d, bit 1 ↔ positive LLR */
+
+      for (e = e0; e < e1; e++) {
+        int32_t x = msg_load(v2c, e, wide);
+        int32_t ax = (x < 0) ? -x : x;
+        sign ^= (x < 0);
+        if (ax < min1) {
+          min2 = min1;
+          min1 = ax;
+          argmin = e;
+        } else if (ax < min2) {
+          min2 = ax;
+        }
+      }
+
+      /* a degree-1 row has no second input (min2 unset): saturate it,
+       * which also keeps the NMS product below within int32 */
+      if (min1 > msg_max)
+        min1 = msg_max;
+      if (min2 > msg_max)
+        min2 = msg_max;
+
+      /* MS / NMS / OMS on the two candidate magnitudes */
+      int32_t mag1 = ((min1 - beta_q) > 0) ? (min1 - beta_q) : 0;
+      int32_t mag2 = ((min2 - beta_q) > 0) ? (min2 - beta_q) : 0;
+      mag1 = (mag1 * alpha16) >> 4;
+      mag2 = (mag2 * alpha16) >> 4;
+
+      for (e = e0; e < e1; e++) {
+        int32_t x = msg_load(v2c, e, wide);
+        int32_t mag = (e == argmin) ? mag2 : mag1;
+        msg_store(c2v, e, (sign ^ (x < 0)) ? -mag : mag, wide);
+      }
+    }
+
+    /* -------------- Variable node update + tentative decision ------ */
+    for (j = 0; j < N; j++) {
+      const int s0 = col_ptr[j];
+      const int s1 = col_ptr[j + 1];
+
+      int32_t sum = Lq[j];
+      for (s = s0; s < s1; s++)
+        sum += msg_load(c2v, col_edge[s], wide);
+      sum = sat_count(sum, post_max, &cnt->post_sat);
+      post[j] = sum;
+
+      for (s = s0; s < s1; s++) {
+        e = col_edge[s];
+        int32_t x = sum - msg_load(c2v, e, wide);
+        msg_store(v2c, e, sat_count(x, msg_max, &cnt->v2c_sat), wide);
+      }
+
+      ecc[j] = (sum >= 0) ? 1 : 0;
+    }
+
+    /* ------------------------ Parity check H·ecc^T ---------------- */
+    parity_ok = fixed_parity_ok(g, ecc);
+    if (parity_ok)
+      break;
+  }
+
+  return parity_ok;
+}
+
+static int fixed_decode_i8(ldpc_fixed_t *fx, const int16_t *Lq, int *ecc,
+                           int max_iter) {
+  return fixed_decode_body(fx, Lq, ecc, max_iter, 0);
+}
+
+static int fixed_decode_i16(ldpc_fixed_t *fx, const int16_t *Lq, int *ecc,
+                            int max_iter) {
+  return fixed_decode_body(fx, Lq, ecc, max_iter, 1);
+}
+
+int ldpc_fixed_decode(ldpc_fixed_t *fx, const int16_t *Lq, int *ecc,
+                      int *inf, int max_iter) {
+  const int N = fx->graph->N;
+  const int K = fx->graph->K;
+  int i;
+
+  int parity_ok = fx->wide ? fixed_decode_i16(fx, Lq, ecc, max_iter)
+                           : fixed_decode_i8(fx, Lq, ecc, max_iter);
+
+  /* systematic tail: codeword = [parity (N-K) | info (K)] */
+  for (i = 0; i < K; i++)
+    inf[i] = ecc[i + (N - K)];
+
+  return parity_ok ? LDPC_DECODE_OK : LDPC_DECODE_MAX_ITER;
+}
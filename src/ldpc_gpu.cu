@@ -0,0 +1,516 @@
+/**
+ * @file ldpc_gpu.cu
+ * @brief CUDA backend of the batch decoder (built with `make CUDA=1`).
+ *
+ * Device layout: for a pitch of F frames (max_frames rounded up to the
+ * block width), per-edge and per-variable arrays are frame-interleaved,
+ *
+ *      v2c[e * F + f], c2v[e * F + f], llr[j * F + f], hard[j * F + f]
+ *
+ * and every node kernel runs one thread per (node, frame): threadIdx.x
+ * walks frames, blockIdx.y walks nodes (grid-strided when the graph has
+ * more than 65535 nodes). Frame-major host LLRs are transposed through a
+ * shared-memory tile on the device, so both PCIe copies stay contiguous.
+ *
+ * One iteration is four launches on the buffer set's stream:
+ *
+ *   check → variable → syndrome (flag per frame) → retire
+ *
+ * retire clears the active flag of every frame with a zero syndrome and
+ * decrements a device-side live counter; all node kernels exit at once
+ * for retired frames and as soon as the counter reaches zero. A syndrome
+ * and retire pass on the channel hard decision runs before the first
+ * iteration, so valid channel words report LDPC_DECODE_OK even for
+ * max_iter = 0.
+ */
+
+#include "ldpc_gpu.h"
+
+#include <cuda_runtime.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GPU_THREADS 64 /* frames per block (node kernels) */
+#define GPU_TILE 32    /* transpose tile                  */
+#define GPU_MAX_GRID_Y 65535
+
+/* ========================================================================== */
+/* Device Kernels                                                             */
+/* ========================================================================== */
+/* φ(x) = −log(tanh(x/2)), clipped as spf_f() in ldpc_batch.c */
+__device__ static float spf_d(float x) {
+  x = fminf(fmaxf(x, 1e-7f), 30.0f);
+  return -logf(tanhf(0.5f * x));
+}
+
+/* frame-major in[f * N + j] → llr[j * F + f], initial hard decision */
+__global__ static void k_load(const float *in, float *llr,
+                              unsigned char *hard, int N, int F,
+                              int nframes) {
+  __shared__ float tile[GPU_TILE][GPU_TILE + 1];
+  const int j0 = blockIdx.x * GPU_TILE;
+  const int f0 = blockIdx.y * GPU_TILE;
+
+  for (int r = threadIdx.y; r < GPU_TILE; r += blockDim.y) {
+    int f = f0 + r, j = j0 + threadIdx.x;
+    tile[r][threadIdx.x] =
+        (f < nframes && j < N) ? in[(size_t)f * N + j] : 0.0f;
+  }
+  __syncthreads();
+  for (int r = threadIdx.y; r < GPU_TILE; r += blockDim.y) {
+    int j = j0 + r, f = f0 + threadIdx.x;
+    if (j < N && f < F) {
+      float x = tile[threadIdx.x][r];
+      llr[(size_t)j * F + f] = x;
+      hard[(size_t)j * F + f] = (x >= 0.0f);
+    }
+  }
+}
+
+/* hard[j * F + f] → frame-major out[f * N + j] */
+__global__ static void k_store(const unsigned char *hard, unsigned char *out,
+                               int N, int F, int nframes) {
+  __shared__ unsigned char tile[GPU_TILE][GPU_TILE + 1];
+  const int j0 = blockIdx.x * GPU_TILE;
+  const int f0 = blockIdx.y * GPU_TILE;
+
+  for (int r = threadIdx.y; r < GPU_TILE; r += blockDim.y) {
+    int j = j0 + r, f = f0 + threadIdx.x;
+    tile[r][threadIdx.x] = (j < N && f < F) ? hard[(size_t)j * F + f] : 0;
+  }
+  __syncthreads();
+  for (int r = threadIdx.y; r < GPU_TILE; r += blockDim.y) {
+    int f = f0 + r, j = j0 + threadIdx.x;
+    if (f < nframes && j < N)
+      out[(size_t)f * N + j] = tile[threadIdx.x][r];
+  }
+}
+
+__global__ static void k_reset(unsigned char *active, unsigned char *unsat,
+                               int *live, int F, int nframes) {
+  int f = blockIdx.x * blockDim.x + threadIdx.x;
+  if (f < F) {
+    active[f] = (f < nframes);
+    unsat[f] = 0;
+  }
+  if (f == 0)
+    *live = nframes;
+}
+
+/* v2c = channel LLR on every edge of variable j */
+__global__ static void k_init(const int *col_ptr, const int *col_edge,
+                              const float *llr, float *v2c, int N, int F) {
+  const int f = blockIdx.x * blockDim.x + threadIdx.x;
+  if (f >= F)
+    return;
+  for (int j = blockIdx.y; j < N; j += gridDim.y) {
+    float x = llr[(size_t)j * F + f];
+    for (int s = col_ptr[j]; s < col_ptr[j + 1]; s++)
+      v2c[(size_t)col_edge[s] * F + f] = x;
+  }
+}
+
+__global__ static void k_check(const int *row_ptr, const float *v2c,
+                               float *c2v, const unsigned char *active,
+                               const int *live, int M, int F, int kernel,
+                               float alpha, float beta) {
+  const int f = blockIdx.x * blockDim.x + threadIdx.x;
+  if (f >= F || *live == 0 || !active[f])
+    return;
+
+  for (int i = blockIdx.y; i < M; i += gridDim.y) {
+    const int e0 = row_ptr[i];
+    const int e1 = row_ptr[i + 1];
+    /* (−1)^d: see check_sign0() in ldpc_decoder.c */
+    float sgn = ((e1 - e0) & 1) ? -1.0f : 1.0f;
+
+    if (kernel == LDPC_KERNEL_SPA) {
+      float acc = 0.0f;
+      for (int e = e0; e < e1; e++) {
+        float x = v2c[(size_t)e * F + f];
+        float p = spf_d(fabsf(x));
+        c2v[(size_t)e * F + f] = p;
+        acc += p;
+        if (x < 0.0f)
+          sgn = -sgn;
+      }
+      for (int e = e0; e < e1; e++) {
+        float x = v2c[(size_t)e * F + f];
+        float sx = (x < 0.0f) ? -sgn : sgn;
+        c2v[(size_t)e * F + f] = sx * spf_d(acc - c2v[(size_t)e * F + f]);
+      }
+    } else {
+      float min1 = HUGE_VALF, min2 = HUGE_VALF;
+      for (int e = e0; e < e1; e++) {
+        float x = v2c[(size_t)e * F + f];
+        float ax = fabsf(x);
+        min2 = fminf(min2, fmaxf(min1, ax));
+        min1 = fminf(min1, ax);
+        if (x < 0.0f)
+          sgn = -sgn;
+      }
+      /* capped as in ldpc_batch.c: min2 stays inf on a degree-1 row;
+       * the raw min1 still identifies the argmin edge */
+      const float cap = (float)LDPC_MS_MAX;
+      const float mag1 = alpha * fmaxf(fminf(min1, cap) - beta, 0.0f);
+      const float mag2 = alpha * fmaxf(fminf(min2, cap) - beta, 0.0f);
+      for (int e = e0; e < e1; e++) {
+        float x = v2c[(size_t)e * F + f];
+        float mag = (fabsf(x) == min1) ? mag2 : mag1;
+        c2v[(size_t)e * F + f] = ((x < 0.0f) ? -sgn : sgn) * mag;
+      }
+    }
+  }
+}
+
+__global__ static void k_variable(const int *col_ptr, const int *col_edge,
+                                  const float *llr, float *v2c,
+                                  const float *c2v, unsigned char *hard,
+                                  const unsigned char *active,
+                                  const int *live, int N, int F) {
+  const int f = blockIdx.x * blockDim.x + threadIdx.x;
+  if (f >= F || *live == 0 || !active[f])
+    return;
+
+  for (int j = blockIdx.y; j < N; j += gridDim.y) {
+    const int s0 = col_ptr[j];
+    const int s1 = col_ptr[j + 1];
+    float acc = llr[(size_t)j * F + f];
+    for (int s = s0; s < s1; s++)
+      acc += c2v[(size_t)col_edge[s] * F + f];
+    for (int s = s0; s < s1; s++) {
+      size_t e = (size_t)col_edge[s] * F + f;
+      v2c[e] = acc - c2v[e];
+    }
+    hard[(size_t)j * F + f] = (acc >= 0.0f);
+  }
+}
+
+/* unsat[f] = 1 if any check of frame f fails (same-value stores only) */
+__global__ static void k_syndrome(const int *row_ptr, const int *col_idx,
+                                  const unsigned char *hard,
+                                  unsigned char *unsat,
+                                  const unsigned char *active,
+                                  const int *live, int M, int F) {
+  const int f = blockIdx.x * blockDim.x + threadIdx.x;
+  if (f >= F || *live == 0 || !active[f])
+    return;
+
+  for (int i = blockIdx.y; i < M; i += gridDim.y) {
+    unsigned char par = 0;
+    for (int e = row_ptr[i]; e < row_ptr[i + 1]; e++)
+      par ^= hard[(size_t)col_idx[e] * F + f];
+    if (par)
+      unsat[f] = 1;
+  }
+}
+
+__global__ static void k_retire(unsigned char *active, unsigned char *unsat,
+                                int *live, int F) {
+  const int f = blockIdx.x * blockDim.x + threadIdx.x;
+  if (f >= F)
+    return;
+  if (active[f] && !unsat[f]) {
+    active[f] = 0;
+    atomicSub(live, 1);
+  }
+  unsat[f] = 0;
+}
+
+__global__ static void k_status(const unsigned char *active, int *status,
+                                int nframes) {
+  const int f = blockIdx.x * blockDim.x + threadIdx.x;
+  if (f < nframes)
+    status[f] = active[f] ? LDPC_DECODE_MAX_ITER : LDPC_DECODE_OK;
+}
+
+/* ========================================================================== */
+/* Host Context                                                               */
+/* ========================================================================== */
+typedef struct {
+  cudaStream_t stream;
+  float *h_in;           /* pinned [max_frames][N] */
+  unsigned char *h_out;  /* pinned [max_frames][N] */
+  int *h_status;         /* pinned [max_frames]    */
+  float *d_in;           /* [max_frames][N]        */
+  unsigned char *d_out;  /* [max_frames][N]        */
+  int *d_status;         /* [max_frames]           */
+  float *llr, *v2c, *c2v; /* [N][F], [E][F], [E][F] */
+  unsigned char *hard;   /* [N][F]                 */
+  unsigned char *active; /* [F] frame not converged */
+  unsigned char *unsat;  /* [F] syndrome non-zero   */
+  int *live;             /* active frames           */
+  int nframes;
+} gpu_set_t;
+
+struct ldpc_gpu {
+  const ldpc_decoder_t *graph;
+  int device;
+  int max_frames;
+  int F; /* frame pitch: max_frames rounded up to GPU_THREADS */
+
+  int *row_ptr, *col_idx, *col_ptr, *col_edge; /* device copies */
+
+  ldpc_kernel_t kernel;
+  float alpha, beta;
+
+  gpu_set_t set[2];
+  int next;     /* set used by the next submit */
+  int inflight; /* submitted, not collected (0..2) */
+  char name[256];
+};
+
+#define CU(call)                                                               \
+  do {                                                                         \
+    if ((call) != cudaSuccess)                                                 \
+      goto fail;                                                               \
+  } while (0)
+
+extern "C" int ldpc_gpu_device_count(void) {
+  int n = 0;
+  if (cudaGetDeviceCount(&n) != cudaSuccess)
+    return 0;
+  return n;
+}
+
+static int upload(int **dst, const int *src, size_t n) {
+  if (cudaMalloc((void **)dst, n * sizeof(int)) != cudaSuccess)
+    return -1;
+  return cudaMemcpy(*dst, src, n * sizeof(int), cudaMemcpyHostToDevice) ==
+                 cudaSuccess
+             ? 0
+             : -1;
+}
+
+extern "C" ldpc_gpu_t *ldpc_gpu_create(const ldpc_decoder_t *graph,
+                                       int max_frames, int device) {
+  if (!graph || max_frames < 1 || device < 0 ||
+      device >= ldpc_gpu_device_count())
+    return NULL;
+  if (cudaSetDevice(device) != cudaSuccess)
+    return NULL;
+
+  ldpc_gpu_t *g = (ldpc_gpu_t *)calloc(1, sizeof(ldpc_gpu_t));
+  if (!g)
+    return NULL;
+
+  const size_t N = graph->N, M = graph->M, E = graph->E;
+  g->graph = graph;
+  g->device = device;
+  g->max_frames = max_frames;
+  g->F = (max_frames + GPU_THREADS - 1) / GPU_THREADS * GPU_THREADS;
+  g->kernel = graph->kernel;
+  g->alpha = (float)graph->alpha;
+  g->beta = (float)graph->beta;
+
+  cudaDeviceProp prop;
+  if (cudaGetDeviceProperties(&prop, device) == cudaSuccess)
+    snprintf(g->name, sizeof(g->name), "%s", prop.name);
+
+  if (upload(&g->row_ptr, graph->row_ptr, M + 1) ||
+      upload(&g->col_idx, graph->col_idx, E) ||
+      upload(&g->col_ptr, graph->col_ptr, N + 1) ||
+      upload(&g->col_edge, graph->col_edge, E))
+    goto fail;
+
+  for (int k = 0; k < 2; k++) {
+    gpu_set_t *s = &g->set[k];
+    const size_t F = g->F, fr = (size_t)max_frames;
+    CU(cudaStreamCreateWithFlags(&s->stream, cudaStreamNonBlocking));
+    CU(cudaMallocHost((void **)&s->h_in, fr * N * sizeof(float)));
+    CU(cudaMallocHost((void **)&s->h_out, fr * N));
+    CU(cudaMallocHost((void **)&s->h_status, fr * sizeof(int)));
+    CU(cudaMalloc((void **)&s->d_in, fr * N * sizeof(float)));
+    CU(cudaMalloc((void **)&s->d_out, fr * N));
+    CU(cudaMalloc((void **)&s->d_status, fr * sizeof(int)));
+    CU(cudaMalloc((void **)&s->llr, N * F * sizeof(float)));
+    CU(cudaMalloc((void **)&s->v2c, E * F * sizeof(float)));
+    CU(cudaMalloc((void **)&s->c2v, E * F * sizeof(float)));
+    CU(cudaMalloc((void **)&s->hard, N * F));
+    CU(cudaMalloc((void **)&s->active, F));
+    CU(cudaMalloc((void **)&s->unsat, F));
+    CU(cudaMalloc((void **)&s->live, sizeof(int)));
+  }
+  return g;
+
+fail:
+  ldpc_gpu_destroy(g);
+  return NULL;
+}
+
+extern "C" void ldpc_gpu_destroy(ldpc_gpu_t *g) {
+  if (!g)
+    return;
+
+  cudaSetDevice(g->device);
+  for (int k = 0; k < 2; k++) {
+    gpu_set_t *s = &g->set[k];
+    if (s->stream) {
+      cudaStreamSynchronize(s->stream);
+      cudaStreamDestroy(s->stream);
+    }
+    cudaFreeHost(s->h_in);
+    cudaFreeHost(s->h_out);
+    cudaFreeHost(s->h_status);
+    cudaFree(s->d_in);
+    cudaFree(s->d_out);
+    cudaFree(s->d_status);
+    cudaFree(s->llr);
+    cudaFree(s->v2c);
+    cudaFree(s->c2v);
+    cudaFree(s->hard);
+    cudaFree(s->active);
+    cudaFree(s->unsat);
+    cudaFree(s->live);
+  }
+  cudaFree(g->row_ptr);
+  cudaFree(g->col_idx);
+  cudaFree(g->col_ptr);
+  cudaFree(g->col_edge);
+  free(g);
+}
+
+extern "C" int ldpc_gpu_set_kernel(ldpc_gpu_t *g, ldpc_kernel_t kernel,
+                                   double param) {
+  switch (kernel) {
+  case LDPC_KERNEL_SPA:
+  case LDPC_KERNEL_MIN_SUM:
+    g->alpha = 1.0f;
+    g->beta = 0.0f;
+    break;
+  case LDPC_KERNEL_NMS:
+    if (!(param > 0.0 && param <= 1.0))
+      return -1;
+    g->alpha = (float)param;
+    g->beta = 0.0f;
+    break;
+  case LDPC_KERNEL_OMS:
+    if (!(param >= 0.0))
+      return -1;
+    g->alpha = 1.0f;
+    g->beta = (float)param;
+    break;
+  default:
+    return -1;
+  }
+
+  g->kernel = kernel;
+  return 0;
+}
+
+extern "C" const char *ldpc_gpu_name(const ldpc_gpu_t *g) { return g->name; }
+
+extern "C" int ldpc_gpu_max_frames(const ldpc_gpu_t *g) {
+  return g->max_frames;
+}
+
+extern "C" float *ldpc_gpu_input(ldpc_gpu_t *g) {
+  return (g->inflight < 2) ? g->set[g->next].h_in : NULL;
+}
+
+/* ========================================================================== */
+/* Submit / Collect                                                           */
+/* ========================================================================== */
+extern "C" int ldpc_gpu_submit(ldpc_gpu_t *g, const float *LLR, int nframes,
+                               int max_iter) {
+  if (nframes < 1 || nframes > g->max_frames || max_iter < 0 ||
+      g->inflight == 2)
+    return -1;
+  if (cudaSetDevice(g->device) != cudaSuccess)
+    return -1;
+
+  const ldpc_decoder_t *gr = g->graph;
+  const int N = gr->N, M = gr->M, F = g->F;
+  gpu_set_t *s = &g->set[g->next];
+  cudaStream_t st = s->stream;
+
+  if (LLR && LLR != s->h_in)
+    memcpy(s->h_in, LLR, (size_t)nframes * N * sizeof(float));
+  s->nframes = nframes;
+
+  const dim3 tblk(GPU_TILE, 8);
+  const dim3 tgrid((N + GPU_TILE - 1) / GPU_TILE, F / GPU_TILE);
+  const dim3 blk(GPU_THREADS);
+  const dim3 vgrid(F / GPU_THREADS, N < GPU_MAX_GRID_Y ? N : GPU_MAX_GRID_Y);
+  const dim3 cgrid(F / GPU_THREADS, M < GPU_MAX_GRID_Y ? M : GPU_MAX_GRID_Y);
+  const dim3 fgrid(F / GPU_THREADS);
+
+  CU(cudaMemcpyAsync(s->d_in, s->h_in, (size_t)nframes * N * sizeof(float),
+                     cudaMemcpyHostToDevice, st));
+  k_load<<<tgrid, tblk, 0, st>>>(s->d_in, s->llr, s->hard, N, F, nframes);
+  k_reset<<<fgrid, blk, 0, st>>>(s->active, s->unsat, s->live, F, nframes);
+  k_init<<<vgrid, blk, 0, st>>>(g->col_ptr, g->col_edge, s->llr, s->v2c, N,
+                                F);
+  /* frames whose channel word is already valid retire before iterating */
+  k_syndrome<<<cgrid, blk, 0, st>>>(g->row_ptr, g->col_idx, s->hard,
+                                    s->unsat, s->active, s->live, M, F);
+  k_retire<<<fgrid, blk, 0, st>>>(s->active, s->unsat, s->live, F);
+
+  for (int it = 0; it < max_iter; it++) {
+    k_check<<<cgrid, blk, 0, st>>>(g->row_ptr, s->v2c, s->c2v, s->active,
+                                   s->live, M, F, g->kernel, g->alpha,
+                                   g->beta);
+    k_variable<<<vgrid, blk, 0, st>>>(g->col_ptr, g->col_edge, s->llr,
+                                      s->v2c, s->c2v, s->hard, s->active,
+                                      s->live, N, F);
+    k_syndrome<<<cgrid, blk, 0, st>>>(g->row_ptr, g->col_idx, s->hard,
+                                      s->unsat, s->active, s->live, M, F);
+    k_retire<<<fgrid, blk, 0, st>>>(s->active, s->unsat, s->live, F);
+  }
+
+  k_store<<<tgrid, tblk, 0, st>>>(s->hard, s->d_out, N, F, nframes);
+  k_status<<<fgrid, blk, 0, st>>>(s->active, s->d_status, nframes);
+  CU(cudaGetLastError());
+  CU(cudaMemcpyAsync(s->h_out, s->d_out, (size_t)nframes * N,
+                     cudaMemcpyDeviceToHost, st));
+  CU(cudaMemcpyAsync(s->h_status, s->d_status, nframes * sizeof(int),
+                     cudaMemcpyDeviceToHost, st));
+
+  g->next ^= 1;
+  g->inflight++;
+  return 0;
+
+fail:
+  return -1;
+}
+
+extern "C" int ldpc_gpu_collect(ldpc_gpu_t *g, int *ecc, int *inf,
+                                int *status) {
+  if (g->inflight == 0)
+    return -1;
+
+  /* oldest batch: the set before `next` when two are in flight */
+  gpu_set_t *s = &g->set[(g->inflight == 2) ? g->next : g->next ^ 1];
+  const int N = g->graph->N, K = g->graph->K;
+  int converged = 0;
+
+  g->inflight--;
+  if (cudaSetDevice(g->device) != cudaSuccess ||
+      cudaStreamSynchronize(s->stream) != cudaSuccess)
+    return -1;
+
+  for (int f = 0; f < s->nframes; f++) {
+    const unsigned char *h = s->h_out + (size_t)f * N;
+    if (ecc)
+      for (int j = 0; j < N; j++)
+        ecc[(size_t)f * N + j] = h[j];
+    /* systematic tail: codeword = [parity (N-K) | info (K)] */
+    if (inf)
+      for (int j = 0; j < K; j++)
+        inf[(size_t)f * K + j] = h[j + (N - K)];
+    if (status)
+      status[f] = s->h_status[f];
+    converged += (s->h_status[f] == LDPC_DECODE_OK);
+  }
+  return converged;
+}
+
+extern "C" int ldpc_gpu_decode(ldpc_gpu_t *g, const float *LLR, int nframes,
+                               int *ecc, int *inf, int *status,
+                               int max_iter) {
+  if (g->inflight || ldpc_gpu_submit(g, LLR, nframes, max_iter))
+    return -1;
+  return ldpc_gpu_collect(g, ecc, inf, status);
+}
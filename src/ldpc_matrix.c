@@ -19,11 +19,14 @@
  * simulation.
  */
 
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#include "ldpc_analysis.h"
 #include "ldpc_matrix.h"
+#include "ldpc_util.h"
 
 /* ========================================================================== */
 /* 1. Gallager Regular LDPC Parity-Check Matrix Generation                    */
@@ -46,7 +49,21 @@
  * This yields a sparse, regular LDPC code with controllable 4-cycle behavior.
  */
 /* ========================================================================== */
-void generate_Hmatrix(int **H, int N, int wc, int wr) {
+/* random index in [0, n): stdlib rand() or a caller-owned SplitMix64 state */
+typedef int (*rand_index_fn)(void *ctx, int n);
+
+static int rand_index_stdlib(void *ctx, int n) {
+  (void)ctx;
+  return rand() % n;
+}
+
+static int rand_index_splitmix(void *ctx, int n) {
+  const uint64_t z = ldpc_splitmix64((uint64_t *)ctx);
+  return (int)((z >> 32) % (uint64_t)n);
+}
+
+static void gallager_fill(int **H, int N, int wc, int wr, rand_index_fn draw,
+                          void *ctx) {
   int i, j, k;
   int M = (N * wc) / wr;   /* number of check equations */
   int block_rows = M / wc; /* rows per Gallager block   */
@@ -77,7 +94,7 @@ void generate_Hmatrix(int **H, int N, int wc, int wr) {
 
     /* Fisher-Yates shuffle */
     for (j = 0; j < N; j++) {
-      int r = rand() % N;
+      int r = draw(ctx, N);
       int tmp = perm[j];
       perm[j] = perm[r];
       perm[r] = tmp;
@@ -92,6 +109,22 @@ void generate_Hmatrix(int **H, int N, int wc, int wr) {
   free(perm);
 }
 
+void generate_Hmatrix(int **H, int N, int wc, int wr) {
+  gallager_fill(H, N, wc, wr, rand_index_stdlib, NULL);
+}
+
+void generate_Hmatrix_seeded(int **H, int N, int wc, int wr,
+                             uint64_t *rng_state) {
+  gallager_fill(H, N, wc, wr, rand_index_splitmix, rng_state);
+}
+
+uint64_t ldpc_candidate_seed(uint64_t seed, long long idx) {
+  uint64_t z = seed ^ (0x9E3779B97F4A7C15ULL * (uint64_t)(idx + 1));
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
 /* ========================================================================== */
 /* 2. Systematic Generator Matrix Construction (G from H)                     */
 /* -------------------------------------------------------------------------- */
@@ -125,45 +158,106 @@ void generate_Hmatrix(int **H, int N, int wc, int wr) {
  *     to maintain the H·G^T = 0 constraint
  */
 /* ========================================================================== */
+/*
+ * X is stored bit-packed: one row of M+N bits in ceil((M+N)/64) uint64_t
+ * words, so a row operation is a word-wise XOR and X takes N(M+N)/8
+ * bytes. Pivot search order, row swaps and column swaps (mirrored into
+ * H in step 3) are exactly those of the element-wise formulation, so the
+ * resulting H and G do not depend on the representation.
+ *
+ * Row elimination for one pivot is independent across rows and runs in
+ * parallel when compiled with OpenMP (make OPENMP=1).
+ *
+ * Two invariants keep the work down without changing the result:
+ *   - in step 2 every row has zeros left of column j except the pivot
+ *     rows of earlier columns, and the pivot row j is zero left of j, so
+ *     the XOR starts at the word holding column j;
+ *   - in step 3 rows ≥ M are zero on the H^T block, and rows < M affect
+ *     neither later pivot decisions nor G, so only rows ≥ M (from column
+ *     M on) are eliminated.
+ */
+#define GF2_WORDS(n) (((n) + 63) / 64)
+
+static inline int gf2_get(const uint64_t *row, int c) {
+  return (int)((row[c >> 6] >> (c & 63)) & 1);
+}
+
+static inline void gf2_flip(uint64_t *row, int c) {
+  row[c >> 6] ^= 1ULL << (c & 63);
+}
+
+static void gf2_swap_rows(uint64_t *X, int W, int a, int b) {
+  uint64_t *ra = X + (size_t)a * W;
+  uint64_t *rb = X + (size_t)b * W;
+  for (int w = 0; w < W; w++) {
+    uint64_t t = ra[w];
+    ra[w] = rb[w];
+    rb[w] = t;
+  }
+}
+
+static void gf2_swap_cols(uint64_t *X, int W, int rows, int a, int b) {
+  for (int i = 0; i < rows; i++) {
+    uint64_t *r = X + (size_t)i * W;
+    if (gf2_get(r, a) != gf2_get(r, b)) {
+      gf2_flip(r, a);
+      gf2_flip(r, b);
+    }
+  }
+}
+
+/* rows[i0..i1) with bit c set, except prow, ^= prow (words w0..W) */
+static void gf2_eliminate(uint64_t *X, int W, int i0, int i1, int prow,
+                          int c, int w0) {
+  const uint64_t *restrict p = X + (size_t)prow * W;
+  int i;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for (i = i0; i < i1; i++) {
+    uint64_t *restrict r = X + (size_t)i * W;
+    if (i != prow && gf2_get(r, c))
+      for (int w = w0; w < W; w++)
+        r[w] ^= p[w];
+  }
+}
+
 void generate_Gmatrix(int **H, int **G, int N, int wc, int wr) {
   int M = (N * wc) / wr;
+  int C = M + N; /* columns of X */
+  int W = GF2_WORDS(C);
 
   int i, j, k, l;
 
-  /* X is the augmented matrix: [H^T | I] */
-  int **X = (int **)malloc(N * sizeof(int *));
-  for (i = 0; i < N; i++)
-    X[i] = (int *)malloc((M + N) * sizeof(int));
-
-  int *row_buf = (int *)malloc((M + N) * sizeof(int));
-  int *col_buf = (int *)malloc(N * sizeof(int));
+  /* X is the augmented matrix: [H^T | I], N rows of W words */
+  uint64_t *X = (uint64_t *)calloc((size_t)N * W, sizeof(uint64_t));
   int *Hcol_buf = (int *)malloc(M * sizeof(int));
 
-  if (!X || !row_buf || !col_buf || !Hcol_buf) {
+  if (!X || !Hcol_buf) {
     fprintf(stderr, "malloc failed in generate_Gmatrix\n");
     exit(1);
   }
 
   /* --------------------- Step 1: Build [H^T | I] ------------------------ */
   for (i = 0; i < N; i++) {
+    uint64_t *row = X + (size_t)i * W;
     for (j = 0; j < M; j++)
-      X[i][j] = H[j][i]; /* left block */
-    for (j = M; j < M + N; j++)
-      X[i][j] = (i == (j - M)) ? 1 : 0; /* right block = I */
+      if (H[j][i])
+        gf2_flip(row, j); /* left block */
+    gf2_flip(row, M + i); /* right block = I */
   }
 
   /* -------- Step 2: Gaussian elimination on left block (H^T part only) --- */
   for (j = 0; j < M; j++) {
 
     /* If pivot missing → row swap OR column swap within X */
-    if (X[j][j] == 0) {
+    if (!gf2_get(X + (size_t)j * W, j)) {
 
       int pivot_found = 0;
       for (i = j + 1; i < N; i++) {
-        if (X[i][j] == 1) {
-          memcpy(row_buf, X[i], (M + N) * sizeof(int));
-          memcpy(X[i], X[j], (M + N) * sizeof(int));
-          memcpy(X[j], row_buf, (M + N) * sizeof(int));
+        if (gf2_get(X + (size_t)i * W, j)) {
+          gf2_swap_rows(X, W, i, j);
           pivot_found = 1;
           break;
         }
@@ -171,13 +265,9 @@ void generate_Gmatrix(int **H, int **G, int N, int wc, int wr) {
 
       /* If pivot still not found → swap columns inside X */
       if (!pivot_found) {
-        for (k = M + N - 1; k > j; k--) {
-          if (X[j][k] == 1) {
-            for (l = 0; l < N; l++) {
-              col_buf[l] = X[l][k];
-              X[l][k] = X[l][j];
-              X[l][j] = col_buf[l];
-            }
+        for (k = C - 1; k > j; k--) {
+          if (gf2_get(X + (size_t)j * W, k)) {
+            gf2_swap_cols(X, W, N, k, j);
             break;
           }
         }
@@ -185,25 +275,20 @@ void generate_Gmatrix(int **H, int **G, int N, int wc, int wr) {
     }
 
     /* Row elimination (GF(2)) */
-    for (i = 0; i < N; i++)
-      if (i != j && X[i][j] == 1)
-        for (k = 0; k < M + N; k++)
-          X[i][k] ^= X[j][k];
+    gf2_eliminate(X, W, 0, N, j, j, j >> 6);
   }
 
   /* ------------- Step 3: Elimination on right block with H updates ------- */
-  for (j = 2 * M; j < M + N; j++) {
+  for (j = 2 * M; j < C; j++) {
 
     int pivot_row = j - M;
 
-    if (X[pivot_row][j] == 0) {
+    if (!gf2_get(X + (size_t)pivot_row * W, j)) {
 
       int found = 0;
       for (i = pivot_row + 1; i < N; i++) {
-        if (X[i][j] == 1) {
-          memcpy(row_buf, X[i], (M + N) * sizeof(int));
-          memcpy(X[i], X[pivot_row], (M + N) * sizeof(int));
-          memcpy(X[pivot_row], row_buf, (M + N) * sizeof(int));
+        if (gf2_get(X + (size_t)i * W, j)) {
+          gf2_swap_rows(X, W, i, pivot_row);
           found = 1;
           break;
         }
@@ -211,15 +296,11 @@ void generate_Gmatrix(int **H, int **G, int N, int wc, int wr) {
 
       /* Still missing pivot → swap columns → update H accordingly */
       if (!found) {
-        for (k = M + N - 1; k > M - 1; k--) {
-          if (X[pivot_row][k] == 1) {
-
-            /* swap columns in X */
-            for (l = 0; l < N; l++) {
-              col_buf[l] = X[l][k];
-              X[l][k] = X[l][j];
-              X[l][j] = col_buf[l];
-            }
+        for (k = C - 1; k > M - 1; k--) {
+          if (gf2_get(X + (size_t)pivot_row * W, k)) {
+
+            /* swap columns in X (rows < M are no longer used) */
+            gf2_swap_cols(X + (size_t)M * W, W, N - M, k, j);
 
             /* mirror swap inside H (only H columns affected) */
             for (l = 0; l < M; l++) {
@@ -235,23 +316,16 @@ void generate_Gmatrix(int **H, int **G, int N, int wc, int wr) {
     }
 
     /* eliminate other rows */
-    for (i = 0; i < N; i++)
-      if (i != pivot_row && X[i][j] == 1)
-        for (k = 0; k < M + N; k++)
-          X[i][k] ^= X[pivot_row][k];
+    gf2_eliminate(X, W, M, N, pivot_row, j, M >> 6);
   }
 
   /* ----------------------- Step 4: Extract G (K×N) ----------------------- */
   for (i = M; i < N; i++)
-    for (j = M; j < M + N; j++)
-      G[i - M][j - M] = X[i][j];
+    for (j = M; j < C; j++)
+      G[i - M][j - M] = gf2_get(X + (size_t)i * W, j);
 
   /* cleanup */
-  for (i = 0; i < N; i++)
-    free(X[i]);
   free(X);
-  free(row_buf);
-  free(col_buf);
   free(Hcol_buf);
 }
 
@@ -262,61 +336,33 @@ void generate_Gmatrix(int **H, int **G, int N, int wc, int wr) {
  * A 4-cycle exists when two variable nodes share ≥2 check nodes.
  * Short cycles harm message-passing performance (SPA/BP).
  *
- * This function:
- *   - Builds adjacency lists of check nodes for each variable
- *   - Counts the number of pairs of columns sharing ≥2 rows
- *   - Counts multiplicities using nC2 = shared! / (2!(shared-2)!)
+ * Counting is delegated to ldpc_count_cycles4() (ldpc_analysis.h), which
+ * sums C(t, 2) over all pairs of checks sharing t variables in about
+ * O(N · wc² · wr) and works for any column/row degrees. The result equals
+ * the column-pair count Σ C(shared, 2).
  *
  * A good LDPC code strives to minimize such 4-cycles.
  */
 /* ========================================================================== */
-static int factorial(int n) {
-  int f = 1;
-  for (int i = 1; i <= n; i++)
-    f *= i;
-  return f;
+int count_floop(int **H, int N, int wc, int wr) {
+  return count_floop_limit(H, N, wc, wr, -1);
 }
 
-int count_floop(int **H, int N, int wc, int wr) {
+int count_floop_limit(int **H, int N, int wc, int wr, int limit) {
   int M = (N * wc) / wr;
 
-  /* store row positions of '1's for each column */
-  int **var_nodes = (int **)malloc(N * sizeof(int *));
-  for (int i = 0; i < N; i++)
-    var_nodes[i] = (int *)malloc(wc * sizeof(int));
-
-  /* build adjacency list: var_nodes[j][*] = rows where H[row][j] = 1 */
-  for (int j = 0; j < N; j++) {
-    int idx = 0;
-    for (int i = 0; i < M; i++) {
-      if (H[i][j])
-        var_nodes[j][idx++] = i;
-      if (idx == wc)
-        break;
-    }
+  ldpc_graph_t *g = ldpc_graph_create(H, M, N);
+  if (!g) {
+    fprintf(stderr, "malloc failed in count_floop\n");
+    exit(1);
   }
 
-  int floop = 0;
-
-  /* Count column pairs sharing ≥2 check nodes (4-cycles) */
-  for (int i = 0; i < N - 1; i++) {
-    for (int j = i + 1; j < N; j++) {
-
-      int shared = 0;
-      for (int k = 0; k < wc; k++)
-        for (int l = 0; l < wc; l++)
-          if (var_nodes[i][k] == var_nodes[j][l])
-            shared++;
+  long long floop = ldpc_count_cycles4(g, limit, NULL, NULL);
+  ldpc_graph_destroy(g);
 
-      if (shared >= 2)
-        floop += factorial(shared) / (2 * factorial(shared - 2));
-    }
+  if (floop < 0) {
+    fprintf(stderr, "malloc failed in count_floop\n");
+    exit(1);
   }
-
-  /* cleanup */
-  for (int i = 0; i < N; i++)
-    free(var_nodes[i]);
-  free(var_nodes);
-
-  return floop;
+  return (floop > 2147483647LL) ? 2147483647 : (int)floop;
 }
@@ -0,0 +1,633 @@
+/**
+ * @file ldpc_peg.c
+ * @brief Progressive Edge-Growth construction with optional ACE tie-break.
+ *
+ * The partial graph is kept as
+ *   - per variable: a fixed slot array of var_deg[v] check indices
+ *   - per check   : a singly linked list of variables (edge pool)
+ *
+ * One BFS per placed edge, expanding check levels:
+ *
+ *   level 0 : checks already adjacent to v
+ *   level l : checks first reached through variables adjacent to level l−1
+ *
+ * A check at level l closes a cycle of length 2(l + 1) with the new edge.
+ * Visited marks are stamps, so nothing is cleared between searches.
+ *
+ * With caps and a target girth, the checks beyond the girth horizon may
+ * all be full late in the construction. Before accepting a short cycle,
+ * one edge (u, c) of such a far check c is moved to an open check c'
+ * where it closes no short cycle either, which frees the slot of c for v
+ * while every check keeps its cap (peg_swap()).
+ */
+
+#include "ldpc_peg.h"
+#include "ldpc_util.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* far full checks sampled per edge before giving up on the girth */
+#define PEG_SWAP_TRIES 64
+
+/* ========================================================================== */
+/* Helpers                                                                    */
+/* ========================================================================== */
+typedef struct {
+  int M, N;
+  const int *var_deg;
+  const int *chk_cap; /* NULL: no cap */
+  int ace;
+  int target_girth;
+  uint64_t rng;
+
+  /* partial graph */
+  int *var_ptr;  /* [N+1] slot offsets          */
+  int *var_adj;  /* [E] checks of each variable */
+  int *var_fill; /* [N] edges placed so far     */
+  int *chk_deg;  /* [M] current check degrees   */
+  int *chk_head; /* [M] edge list heads         */
+  int *edge_next;
+  int *edge_var;
+  int n_edges;
+
+  /* checks bucketed by current degree: by_deg[bstart[d] .. bstart[d+1]) */
+  int *by_deg; /* [M]   */
+  int *pos;    /* [M]   index of each check in by_deg */
+  int *bstart; /* [N+2] */
+
+  /* BFS state */
+  int *chk_stamp; /* [M] */
+  int *var_stamp; /* [N] */
+  int stamp;
+  int *chk_level; /* [M] level of reached checks       */
+  int *chk_ace;   /* [M] best path ACE to the check     */
+  int *var_ace;   /* [N] best path ACE to the variable  */
+  int *frontier;  /* [N] variables of the current level */
+  int *next;      /* [N] */
+  int *reached;   /* [M] reached checks in level order  */
+
+  /* edge moves (peg_swap): second BFS state and the open checks */
+  int max_cap;
+  int *probe_chk; /* [M] */
+  int *probe_var; /* [N] */
+  int probe_stamp;
+  int *probe_front; /* [N] */
+  int *probe_next;  /* [N] */
+  int *open;        /* [M] checks below their cap */
+  int *chk_vars;    /* [N] variables of the check being freed */
+} peg_t;
+
+static int peg_full(const peg_t *P, int c) {
+  return P->chk_cap && P->chk_deg[c] >= P->chk_cap[c];
+}
+
+/* move c to the end of bucket d, then shrink the bucket by one */
+static void peg_bucket_inc(peg_t *P, int c) {
+  const int d = P->chk_deg[c];
+  const int last = P->bstart[d + 1] - 1;
+  const int o = P->by_deg[last];
+  P->by_deg[P->pos[c]] = o;
+  P->pos[o] = P->pos[c];
+  P->by_deg[last] = c;
+  P->pos[c] = last;
+  P->bstart[d + 1]--;
+  P->chk_deg[c] = d + 1;
+}
+
+/* move c to the start of bucket d, then grow bucket d − 1 by one */
+static void peg_bucket_dec(peg_t *P, int c) {
+  const int d = P->chk_deg[c];
+  const int first = P->bstart[d];
+  const int o = P->by_deg[first];
+  P->by_deg[P->pos[c]] = o;
+  P->pos[o] = P->pos[c];
+  P->by_deg[first] = c;
+  P->pos[c] = first;
+  P->bstart[d]++;
+  P->chk_deg[c] = d - 1;
+}
+
+static void peg_add_edge(peg_t *P, int v, int c) {
+  P->var_adj[P->var_ptr[v] + P->var_fill[v]++] = c;
+  P->edge_var[P->n_edges] = v;
+  P->edge_next[P->n_edges] = P->chk_head[c];
+  P->chk_head[c] = P->n_edges++;
+  peg_bucket_inc(P, c);
+}
+
+/* reattach the edge (u, from) to check `to` */
+static void peg_move_edge(peg_t *P, int u, int from, int to) {
+  int *slot = P->var_adj + P->var_ptr[u];
+  while (*slot != from)
+    slot++;
+  *slot = to;
+
+  int *link = &P->chk_head[from];
+  while (P->edge_var[*link] != u)
+    link = &P->edge_next[*link];
+  const int e = *link;
+  *link = P->edge_next[e];
+  P->edge_next[e] = P->chk_head[to];
+  P->chk_head[to] = e;
+
+  peg_bucket_dec(P, from);
+  peg_bucket_inc(P, to);
+}
+
+/**
+ * @brief Lowest-degree check outside the current BFS (stamp), optionally
+ *        skipping checks at their cap; -1 if there is none.
+ *
+ * Within the lowest usable bucket the scan starts at a random offset, so
+ * ties are spread over the bucket without visiting all of it.
+ */
+static int peg_pick_unreached(peg_t *P, int use_caps) {
+  for (int d = 0; P->bstart[d] < P->M; d++) {
+    const int lo = P->bstart[d], n = P->bstart[d + 1] - lo;
+    if (n <= 0)
+      continue;
+    const int r = (int)(ldpc_splitmix64(&P->rng) % (uint64_t)n);
+    for (int i = 0; i < n; i++) {
+      const int c = P->by_deg[lo + (r + i) % n];
+      if (P->chk_stamp[c] != P->stamp && !(use_caps && peg_full(P, c)))
+        return c;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief Pick among reached checks of the deepest level (≥ 1) that still
+ *        has a check below its cap; if every reached check is full, the
+ *        caps are ignored on the deepest level. Lowest degree first, then
+ *        largest ACE, then random.
+ */
+static int peg_pick_reached(peg_t *P, int n_reached) {
+  int ignore_caps = 0;
+
+  for (;;) {
+    int i = n_reached - 1;
+    while (i >= 0) {
+      const int level = P->chk_level[P->reached[i]];
+      if (level == 0)
+        break;
+
+      int best = -1, n_best = 0;
+      for (; i >= 0 && P->chk_level[P->reached[i]] == level; i--) {
+        const int c = P->reached[i];
+        if (!ignore_caps && peg_full(P, c))
+          continue;
+        if (best < 0 || P->chk_deg[c] < P->chk_deg[best] ||
+            (P->chk_deg[c] == P->chk_deg[best] && P->ace &&
+             P->chk_ace[c] > P->chk_ace[best])) {
+          best = c;
+          n_best = 1;
+        } else if (P->chk_deg[c] == P->chk_deg[best] &&
+                   (!P->ace || P->chk_ace[c] == P->chk_ace[best])) {
+          /* equal: reservoir sampling keeps a uniform choice */
+          if (ldpc_splitmix64(&P->rng) % (uint64_t)++n_best == 0)
+            best = c;
+        }
+      }
+      if (best >= 0)
+        return best;
+      if (ignore_caps)
+        break;
+    }
+    if (ignore_caps || !P->chk_cap)
+      return -1;
+    ignore_caps = 1;
+  }
+}
+
+/* 1 if x already has an edge to t other than (x, skip) */
+static int peg_adjacent(const peg_t *P, int x, int t, int skip) {
+  const int *adj = P->var_adj + P->var_ptr[x];
+  for (int k = 0; k < P->var_fill[x]; k++)
+    if (adj[k] == t && t != skip)
+      return 1;
+  return 0;
+}
+
+/**
+ * @brief 1 if a new edge (x, t) would close a cycle shorter than g, i.e.
+ *        t lies within g/2 − 1 check levels of x. The edge (x, skip) is
+ *        treated as absent (skip = −1: none). A second edge (x, t) is
+ *        rejected for every g, including g ≤ 2.
+ *
+ * Uses its own stamps, so the BFS state of peg_search() is left intact.
+ */
+static int peg_probe(peg_t *P, int x, int t, int skip, int g) {
+  int n_front = 1;
+
+  if (peg_adjacent(P, x, t, skip))
+    return 1;
+
+  P->probe_stamp++;
+  P->probe_var[x] = P->probe_stamp;
+  P->probe_front[0] = x;
+
+  for (int level = 0; 2 * (level + 1) < g && n_front > 0; level++) {
+    const int deeper = 2 * (level + 2) < g;
+    int n_next = 0;
+    for (int i = 0; i < n_front; i++) {
+      const int u = P->probe_front[i];
+      for (int k = 0; k < P->var_fill[u]; k++) {
+        const int c = P->var_adj[P->var_ptr[u] + k];
+        if (u == x && c == skip)
+          continue;
+        if (c == t)
+          return 1;
+        if (P->probe_chk[c] == P->probe_stamp)
+          continue;
+        P->probe_chk[c] = P->probe_stamp;
+        if (!deeper)
+          continue;
+        for (int e = P->chk_head[c]; e >= 0; e = P->edge_next[e]) {
+          const int w = P->edge_var[e];
+          if (P->probe_var[w] == P->probe_stamp)
+            continue;
+          P->probe_var[w] = P->probe_stamp;
+          P->probe_next[n_next++] = w;
+        }
+      }
+    }
+    int *tmp = P->probe_front;
+    P->probe_front = P->probe_next;
+    P->probe_next = tmp;
+    n_front = n_next;
+  }
+  return 0;
+}
+
+/**
+ * @brief Free a check for v without breaking its cap or closing a cycle
+ *        shorter than g; -1 if no such move is found.
+ *
+ * Samples full checks c not adjacent to v that the BFS of v did not
+ * reach within the levels closing cycles shorter than g. For each variable u of c and
+ * each open check c', the edge (u, c) moves to c' if (u, c') closes no
+ * cycle shorter than g without (u, c), and (v, c) none after the move;
+ * otherwise the move is undone. On success the returned c has exactly
+ * one free slot, which the caller fills with v.
+ */
+static int peg_swap(peg_t *P, int v, int g) {
+  int n_open = 0;
+
+  for (int d = 0; d < P->max_cap && P->bstart[d] < P->M; d++)
+    for (int i = P->bstart[d]; i < P->bstart[d + 1]; i++)
+      if (!peg_full(P, P->by_deg[i]))
+        P->open[n_open++] = P->by_deg[i];
+  if (n_open == 0)
+    return -1;
+
+  for (int t = 0; t < PEG_SWAP_TRIES; t++) {
+    const int c = (int)(ldpc_splitmix64(&P->rng) % (uint64_t)P->M);
+    if (!peg_full(P, c) ||
+        (P->chk_stamp[c] == P->stamp && 2 * (P->chk_level[c] + 1) < g) ||
+        peg_adjacent(P, v, c, -1))
+      continue;
+
+    /* the moves reorder the edge list of c: walk a copy */
+    int n_vars = 0;
+    for (int e = P->chk_head[c]; e >= 0; e = P->edge_next[e])
+      P->chk_vars[n_vars++] = P->edge_var[e];
+
+    const int r = (int)(ldpc_splitmix64(&P->rng) % (uint64_t)n_open);
+    for (int j = 0; j < n_vars; j++) {
+      const int u = P->chk_vars[j];
+      for (int i = 0; i < n_open; i++) {
+        const int c2 = P->open[(r + i) % n_open];
+        if (peg_probe(P, u, c2, c, g))
+          continue;
+        peg_move_edge(P, u, c, c2);
+        if (!peg_probe(P, v, c, -1, g))
+          return c;
+        peg_move_edge(P, u, c2, c);
+      }
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief peg_pick_reached(), unless an edge move (peg_swap()) frees a
+ *        check closing a longer cycle: the target girth first, then
+ *        every shorter girth down to the one of the reached candidate.
+ */
+static int peg_pick_far(peg_t *P, int v, int n_reached) {
+  const int c = peg_pick_reached(P, n_reached);
+  if (!P->chk_cap || P->target_girth <= 0)
+    return c;
+
+  const int have = (c >= 0) ? 2 * (P->chk_level[c] + 1) : 0;
+  for (int g = P->target_girth; g > have; g -= 2) {
+    const int s = peg_swap(P, v, g);
+    if (s >= 0)
+      return s;
+  }
+  return c;
+}
+
+/**
+ * @brief Choose the check for the next edge of v.
+ */
+static int peg_search(peg_t *P, int v) {
+  const int M = P->M;
+  const int *deg = P->var_deg;
+  int n_front = 1, n_reached = 0, level = 0;
+  int i, k, c;
+
+  P->stamp++;
+
+  /* first edge: nothing to avoid */
+  if (P->var_fill[v] == 0) {
+    c = peg_pick_unreached(P, 1);
+    return (c >= 0) ? c : peg_pick_unreached(P, 0);
+  }
+
+  P->var_stamp[v] = P->stamp;
+  P->var_ace[v] = deg[v] - 2;
+  P->frontier[0] = v;
+
+  for (;;) {
+    /* checks of the next level */
+    const int level_start = n_reached;
+    int n_next = 0;
+
+    for (i = 0; i < n_front; i++) {
+      const int u = P->frontier[i];
+      for (k = 0; k < P->var_fill[u]; k++) {
+        c = P->var_adj[P->var_ptr[u] + k];
+        if (P->chk_stamp[c] == P->stamp) {
+          if (P->chk_level[c] == level && P->var_ace[u] > P->chk_ace[c])
+            P->chk_ace[c] = P->var_ace[u];
+          continue;
+        }
+        P->chk_stamp[c] = P->stamp;
+        P->chk_level[c] = level;
+        P->chk_ace[c] = P->var_ace[u];
+        P->reached[n_reached++] = c;
+      }
+    }
+
+    /* unreached checks exist and the search saturated or reached the
+     * girth horizon → an unreached check closes no short cycle */
+    const int grew = n_reached > level_start;
+    const int horizon =
+        P->target_girth > 0 && 2 * (level + 2) >= P->target_girth;
+    if (n_reached < M && (!grew || horizon)) {
+      c = peg_pick_unreached(P, 1);
+      if (c < 0) /* all unreached are full */
+        c = peg_pick_far(P, v, n_reached);
+      if (c < 0)
+        c = peg_pick_unreached(P, 0);
+      return c;
+    }
+
+    /* all checks reached: farthest level (never the ones adjacent to v) */
+    if (n_reached == M)
+      return peg_pick_far(P, v, n_reached);
+
+    /* variables behind the new checks */
+    for (i = level_start; i < n_reached; i++) {
+      c = P->reached[i];
+      for (int e = P->chk_head[c]; e >= 0; e = P->edge_next[e]) {
+        const int u = P->edge_var[e];
+        if (P->var_stamp[u] == P->stamp)
+          continue;
+        P->var_stamp[u] = P->stamp;
+        P->var_ace[u] = P->chk_ace[c] + deg[u] - 2;
+        P->next[n_next++] = u;
+      }
+    }
+
+    int *t = P->frontier;
+    P->frontier = P->next;
+    P->next = t;
+    n_front = n_next;
+    level++;
+  }
+}
+
+static void peg_free(peg_t *P) {
+  free(P->var_ptr);
+  free(P->var_adj);
+  free(P->var_fill);
+  free(P->chk_deg);
+  free(P->chk_head);
+  free(P->edge_next);
+  free(P->edge_var);
+  free(P->chk_stamp);
+  free(P->var_stamp);
+  free(P->chk_level);
+  free(P->chk_ace);
+  free(P->var_ace);
+  free(P->frontier);
+  free(P->next);
+  free(P->reached);
+  free(P->by_deg);
+  free(P->pos);
+  free(P->bstart);
+  free(P->probe_chk);
+  free(P->probe_var);
+  free(P->probe_front);
+  free(P->probe_next);
+  free(P->open);
+  free(P->chk_vars);
+}
+
+/* ========================================================================== */
+/* PEG Construction                                                           */
+/* ========================================================================== */
+static int cmp_deg_idx(const void *a, const void *b) {
+  const int *x = (const int *)a, *y = (const int *)b;
+  return (x[0] != y[0]) ? x[0] - y[0] : x[1] - y[1];
+}
+
+ldpc_graph_t *ldpc_peg_construct(const ldpc_peg_params_t *p) {
+  const int M = p ? p->M : 0;
+  const int N = p ? p->N : 0;
+  int i, j;
+
+  if (!p || M <= 0 || N <= 0)
+    return NULL;
+
+  peg_t P;
+  memset(&P, 0, sizeof(P));
+  P.M = M;
+  P.N = N;
+  P.chk_cap = p->chk_deg;
+  P.ace = p->ace;
+  P.target_girth = p->target_girth;
+  P.rng = p->seed;
+
+  int *degs = (int *)malloc(N * sizeof(int));
+  int *order = (int *)malloc(2 * N * sizeof(int));
+  ldpc_graph_t *g = NULL;
+  if (!degs || !order)
+    goto done;
+  for (j = 0; j < N; j++) {
+    degs[j] = p->var_deg ? p->var_deg[j] : p->wc;
+    if (degs[j] < 1 || degs[j] > M)
+      goto done;
+  }
+  P.var_deg = degs;
+
+  P.var_ptr = (int *)malloc((N + 1) * sizeof(int));
+  if (!P.var_ptr)
+    goto done;
+  P.var_ptr[0] = 0;
+  for (j = 0; j < N; j++)
+    P.var_ptr[j + 1] = P.var_ptr[j] + degs[j];
+  const int E = P.var_ptr[N];
+
+  P.var_adj = (int *)malloc(((size_t)E + 1) * sizeof(int));
+  P.var_fill = (int *)calloc(N, sizeof(int));
+  P.chk_deg = (int *)calloc(M, sizeof(int));
+  P.chk_head = (int *)malloc(M * sizeof(int));
+  P.edge_next = (int *)malloc(((size_t)E + 1) * sizeof(int));
+  P.edge_var = (int *)malloc(((size_t)E + 1) * sizeof(int));
+  P.chk_stamp = (int *)calloc(M, sizeof(int));
+  P.var_stamp = (int *)calloc(N, sizeof(int));
+  P.chk_level = (int *)malloc(M * sizeof(int));
+  P.chk_ace = (int *)malloc(M * sizeof(int));
+  P.var_ace = (int *)malloc(N * sizeof(int));
+  P.frontier = (int *)malloc(N * sizeof(int));
+  P.next = (int *)malloc(N * sizeof(int));
+  P.reached = (int *)malloc(M * sizeof(int));
+  P.by_deg = (int *)malloc(M * sizeof(int));
+  P.pos = (int *)malloc(M * sizeof(int));
+  P.bstart = (int *)malloc((N + 2) * sizeof(int));
+  P.probe_chk = (int *)calloc(M, sizeof(int));
+  P.probe_var = (int *)calloc(N, sizeof(int));
+  P.probe_front = (int *)malloc(N * sizeof(int));
+  P.probe_next = (int *)malloc(N * sizeof(int));
+  P.open = (int *)malloc(M * sizeof(int));
+  P.chk_vars = (int *)malloc(N * sizeof(int));
+  if (!P.var_adj || !P.var_fill || !P.chk_deg || !P.chk_head ||
+      !P.edge_next || !P.edge_var || !P.chk_stamp || !P.var_stamp ||
+      !P.chk_level || !P.chk_ace || !P.var_ace || !P.frontier || !P.next ||
+      !P.reached || !P.by_deg || !P.pos || !P.bstart || !P.probe_chk ||
+      !P.probe_var || !P.probe_front || !P.probe_next || !P.open ||
+      !P.chk_vars)
+    goto done;
+  for (i = 0; i < M && p->chk_deg; i++)
+    if (p->chk_deg[i] > P.max_cap)
+      P.max_cap = p->chk_deg[i];
+  for (i = 0; i < M; i++) {
+    P.chk_head[i] = -1;
+    P.by_deg[i] = i;
+    P.pos[i] = i;
+  }
+  P.bstart[0] = 0; /* all checks start in bucket 0 */
+  for (i = 1; i < N + 2; i++)
+    P.bstart[i] = M;
+
+  /* variables by increasing degree */
+  for (j = 0; j < N; j++) {
+    order[2 * j] = degs[j];
+    order[2 * j + 1] = j;
+  }
+  qsort(order, N, 2 * sizeof(int), cmp_deg_idx);
+
+  for (int n = 0; n < N; n++) {
+    const int v = order[2 * n + 1];
+    for (int k = 0; k < degs[v]; k++) {
+      const int c = peg_search(&P, v);
+      if (c < 0)
+        goto done;
+      peg_add_edge(&P, v, c);
+    }
+  }
+
+  /* ---------------- Export as CSR/CSC (sorted indices) ---------------- */
+  g = (ldpc_graph_t *)calloc(1, sizeof(ldpc_graph_t));
+  if (!g)
+    goto done;
+  g->M = M;
+  g->N = N;
+  g->E = E;
+  g->row_ptr = (int *)calloc(M + 1, sizeof(int));
+  g->col_ptr = (int *)calloc(N + 1, sizeof(int));
+  g->col_idx = (int *)malloc(((size_t)E + 1) * sizeof(int));
+  g->row_idx = (int *)malloc(((size_t)E + 1) * sizeof(int));
+  if (!g->row_ptr || !g->col_ptr || !g->col_idx || !g->row_idx) {
+    ldpc_graph_destroy(g);
+    g = NULL;
+    goto done;
+  }
+
+  for (i = 0; i < M; i++)
+    g->row_ptr[i + 1] = g->row_ptr[i] + P.chk_deg[i];
+  for (j = 0; j < N; j++)
+    g->col_ptr[j + 1] = g->col_ptr[j] + degs[j];
+
+  /* rows: variables in increasing order (walk columns in order) */
+  memset(P.chk_deg, 0, M * sizeof(int));
+  for (j = 0; j < N; j++)
+    for (int k = 0; k < degs[j]; k++) {
+      const int c = P.var_adj[P.var_ptr[j] + k];
+      g->col_idx[g->row_ptr[c] + P.chk_deg[c]++] = j;
+    }
+  /* columns: checks in increasing order (walk rows in order) */
+  memset(P.var_fill, 0, N * sizeof(int));
+  for (i = 0; i < M; i++)
+    for (int e = g->row_ptr[i]; e < g->row_ptr[i + 1]; e++) {
+      const int v = g->col_idx[e];
+      g->row_idx[g->col_ptr[v] + P.var_fill[v]++] = i;
+    }
+
+done:
+  peg_free(&P);
+  free(degs);
+  free(order);
+  return g;
+}
+
+/* ========================================================================== */
+/* Dense Wrapper                                                              */
+/* ========================================================================== */
+int generate_Hmatrix_peg(int **H, int N, int wc, int wr, const int *degs,
+                         int ace, uint64_t seed) {
+  const int M = (N * wc) / wr;
+  int i, j;
+
+  if (M <= 0 || wc <= 0)
+    return -1;
+
+  int *cap = NULL;
+  if (!degs) {
+    cap = (int *)malloc(M * sizeof(int));
+    if (!cap)
+      return -1;
+    for (i = 0; i < M; i++)
+      cap[i] = wr;
+  }
+
+  ldpc_peg_params_t p;
+  memset(&p, 0, sizeof(p));
+  p.M = M;
+  p.N = N;
+  p.var_deg = degs;
+  p.wc = wc;
+  p.chk_deg = cap;
+  p.ace = ace;
+  p.seed = seed;
+
+  ldpc_graph_t *g = ldpc_peg_construct(&p);
+  free(cap);
+  if (!g)
+    return -1;
+
+  for (i = 0; i < M; i++) {
+    for (j = 0; j < N; j++)
+      H[i][j] = 0;
+    for (int e = g->row_ptr[i]; e < g->row_ptr[i + 1]; e++)
+      H[i][g->col_idx[e]] = 1;
+  }
+
+  ldpc_graph_destroy(g);
+  return 0;
+}
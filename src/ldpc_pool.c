@@ -0,0 +1,393 @@
+/**
+ * @file ldpc_pool.c
+ * @brief Decoder worker pool over lock-free bounded MPMC queues.
+ *
+ * Queue: Vyukov's bounded MPMC ring. Every cell carries a sequence number
+ * that tells producers and consumers whether it is free for position p
+ * (seq == p) or holds the item of position p (seq == p + 1); positions
+ * are claimed with one CAS on the head or tail counter.
+ *
+ * Frame slots:
+ *   - in order: frame `seq` uses slot seq mod depth, so the collector
+ *     finds the next result directly; a slot is reused once delivered
+ *   - completion order: free slots circulate through a queue and done
+ *     slots are handed to the collector through the completion queue
+ *
+ * Sleeping: a thread that finds no work announces itself in a sleeper
+ * counter (seq_cst), re-checks under the pool mutex and waits on a
+ * condition variable. Producers publish first and then read the counter,
+ * so the mutex is only touched when somebody is actually asleep.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ldpc_pool.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CACHE_LINE 64
+
+/* ========================================================================== */
+/* Bounded MPMC Queue                                                         */
+/* ========================================================================== */
+typedef struct {
+  size_t seq;
+  int val;
+} cell_t;
+
+typedef struct {
+  cell_t *cells;
+  size_t mask;
+  char pad0[CACHE_LINE];
+  size_t tail; /* next enqueue position */
+  char pad1[CACHE_LINE];
+  size_t head; /* next dequeue position */
+  char pad2[CACHE_LINE];
+} mpmc_t;
+
+static int mpmc_init(mpmc_t *q, size_t cap) { /* cap: power of two */
+  q->cells = (cell_t *)malloc(cap * sizeof(cell_t));
+  if (!q->cells)
+    return -1;
+  for (size_t i = 0; i < cap; i++)
+    q->cells[i].seq = i;
+  q->mask = cap - 1;
+  q->tail = q->head = 0;
+  return 0;
+}
+
+static int mpmc_push(mpmc_t *q, int v) {
+  size_t pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+  for (;;) {
+    cell_t *c = &q->cells[pos & q->mask];
+    size_t seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+    intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&q->tail, &pos, pos + 1, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        c->val = v;
+        __atomic_store_n(&c->seq, pos + 1, __ATOMIC_RELEASE);
+        return 0;
+      }
+    } else if (diff < 0) {
+      return -1; /* full */
+    } else {
+      pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+static int mpmc_pop(mpmc_t *q, int *v) {
+  size_t pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+  for (;;) {
+    cell_t *c = &q->cells[pos & q->mask];
+    size_t seq = __atomic_load_n(&c->seq, __ATOMIC_ACQUIRE);
+    intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+    if (diff == 0) {
+      if (__atomic_compare_exchange_n(&q->head, &pos, pos + 1, 1,
+                                      __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+        *v = c->val;
+        __atomic_store_n(&c->seq, pos + q->mask + 1, __ATOMIC_RELEASE);
+        return 1;
+      }
+    } else if (diff < 0) {
+      return 0; /* empty */
+    } else {
+      pos = __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    }
+  }
+}
+
+/* ========================================================================== */
+/* Pool State                                                                 */
+/* ========================================================================== */
+enum { SLOT_FREE = 0, SLOT_QUEUED = 1, SLOT_DONE = 2 };
+
+typedef struct {
+  double *LLR; /* [N] */
+  int *ecc;    /* [N] */
+  int *inf;    /* [K] */
+  long long seq;
+  void *user;
+  int status;
+  int state; /* SLOT_* (atomic) */
+} slot_t;
+
+typedef struct {
+  ldpc_pool_t *pool;
+  int index;
+  pthread_t thread;
+  ldpc_decoder_t *dec;
+  mpmc_t queue;
+} worker_t;
+
+struct ldpc_pool {
+  const ldpc_decoder_t *graph;
+  int n_workers, in_order, max_iter;
+  size_t depth;
+
+  slot_t *slots;
+  worker_t *workers;
+  int started; /* threads running */
+  mpmc_t free_q; /* completion order: free slots */
+  mpmc_t done_q; /* completion order: done slots */
+
+  long long submitted; /* written by the submitter */
+  long long delivered; /* written by the collector */
+  unsigned long long steals;
+  int stop;
+
+  pthread_mutex_t lock;
+  pthread_cond_t work_cv; /* idle workers */
+  pthread_cond_t done_cv; /* waiting collector */
+  int sleepers, waiters;
+};
+
+static void wake(ldpc_pool_t *pool, int *count, pthread_cond_t *cv) {
+  __atomic_thread_fence(__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(count, __ATOMIC_SEQ_CST)) {
+    pthread_mutex_lock(&pool->lock);
+    pthread_cond_broadcast(cv);
+    pthread_mutex_unlock(&pool->lock);
+  }
+}
+
+/* own queue first, then steal round-robin from the others */
+static int take_job(worker_t *w, int *idx) {
+  ldpc_pool_t *pool = w->pool;
+  if (mpmc_pop(&w->queue, idx))
+    return 1;
+  for (int k = 1; k < pool->n_workers; k++) {
+    worker_t *v = &pool->workers[(w->index + k) % pool->n_workers];
+    if (mpmc_pop(&v->queue, idx)) {
+      __atomic_fetch_add(&pool->steals, 1, __ATOMIC_RELAXED);
+      return 1;
+    }
+  }
+  return 0;
+}
+
+static void *worker_main(void *arg) {
+  worker_t *w = (worker_t *)arg;
+  ldpc_pool_t *pool = w->pool;
+  int idx;
+
+  for (;;) {
+    if (!take_job(w, &idx)) {
+      pthread_mutex_lock(&pool->lock);
+      __atomic_fetch_add(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+      int got = take_job(w, &idx);
+      while (!got && !__atomic_load_n(&pool->stop, __ATOMIC_ACQUIRE)) {
+        pthread_cond_wait(&pool->work_cv, &pool->lock);
+        got = take_job(w, &idx);
+      }
+      __atomic_fetch_sub(&pool->sleepers, 1, __ATOMIC_SEQ_CST);
+      pthread_mutex_unlock(&pool->lock);
+      if (!got)
+        break; /* stopping */
+    }
+
+    slot_t *s = &pool->slots[idx];
+    s->status =
+        ldpc_decoder_decode(w->dec, s->LLR, s->ecc, s->inf, pool->max_iter);
+    __atomic_store_n(&s->state, SLOT_DONE, __ATOMIC_RELEASE);
+    if (!pool->in_order)
+      mpmc_push(&pool->done_q, idx); /* never full: depth cells */
+    wake(pool, &pool->waiters, &pool->done_cv);
+  }
+  return NULL;
+}
+
+/* ========================================================================== */
+/* Create / Destroy                                                           */
+/* ========================================================================== */
+ldpc_pool_t *ldpc_pool_create(const ldpc_decoder_t *graph, int n_workers,
+                              int depth, int in_order, int max_iter) {
+  if (!graph || n_workers < 1 || depth < 1 || max_iter < 1)
+    return NULL;
+
+  ldpc_pool_t *pool = (ldpc_pool_t *)calloc(1, sizeof(ldpc_pool_t));
+  if (!pool)
+    return NULL;
+
+  size_t cap = 1;
+  while (cap < (size_t)depth)
+    cap <<= 1;
+
+  pool->graph = graph;
+  pool->n_workers = n_workers;
+  pool->in_order = in_order != 0;
+  pool->max_iter = max_iter;
+  pool->depth = cap;
+  pthread_mutex_init(&pool->lock, NULL);
+  pthread_cond_init(&pool->work_cv, NULL);
+  pthread_cond_init(&pool->done_cv, NULL);
+
+  const int N = graph->N, K = graph->K;
+  pool->slots = (slot_t *)calloc(cap, sizeof(slot_t));
+  pool->workers = (worker_t *)calloc(n_workers, sizeof(worker_t));
+  if (!pool->slots || !pool->workers || mpmc_init(&pool->free_q, cap) ||
+      mpmc_init(&pool->done_q, cap))
+    goto fail;
+
+  for (size_t i = 0; i < cap; i++) {
+    slot_t *s = &pool->slots[i];
+    s->LLR = (double *)malloc(N * sizeof(double));
+    s->ecc = (int *)malloc(N * sizeof(int));
+    s->inf = (int *)malloc((K > 0 ? K : 1) * sizeof(int));
+    if (!s->LLR || !s->ecc || !s->inf)
+      goto fail;
+    mpmc_push(&pool->free_q, (int)i);
+  }
+
+  for (int t = 0; t < n_workers; t++) {
+    worker_t *w = &pool->workers[t];
+    w->pool = pool;
+    w->index = t;
+    w->dec = ldpc_decoder_create_csr(graph->M, N, K, graph->E,
+                                     graph->row_ptr, graph->col_idx,
+                                     graph->col_ptr, graph->row_idx,
+                                     graph->col_edge);
+    if (!w->dec || mpmc_init(&w->queue, cap) ||
+        ldpc_decoder_copy_config(w->dec, graph))
+      goto fail;
+  }
+
+  for (int t = 0; t < n_workers; t++) {
+    if (pthread_create(&pool->workers[t].thread, NULL, worker_main,
+                       &pool->workers[t]))
+      goto fail;
+    pool->started++;
+  }
+  return pool;
+
+fail:
+  ldpc_pool_destroy(pool);
+  return NULL;
+}
+
+void ldpc_pool_destroy(ldpc_pool_t *pool) {
+  if (!pool)
+    return;
+
+  pthread_mutex_lock(&pool->lock);
+  __atomic_store_n(&pool->stop, 1, __ATOMIC_RELEASE);
+  pthread_cond_broadcast(&pool->work_cv);
+  pthread_mutex_unlock(&pool->lock);
+  for (int t = 0; t < pool->started; t++)
+    pthread_join(pool->workers[t].thread, NULL);
+
+  if (pool->workers) {
+    for (int t = 0; t < pool->n_workers; t++) {
+      ldpc_decoder_destroy(pool->workers[t].dec);
+      free(pool->workers[t].queue.cells);
+    }
+  }
+  if (pool->slots) {
+    for (size_t i = 0; i < pool->depth; i++) {
+      free(pool->slots[i].LLR);
+      free(pool->slots[i].ecc);
+      free(pool->slots[i].inf);
+    }
+  }
+  free(pool->free_q.cells);
+  free(pool->done_q.cells);
+  free(pool->slots);
+  free(pool->workers);
+  pthread_mutex_destroy(&pool->lock);
+  pthread_cond_destroy(&pool->work_cv);
+  pthread_cond_destroy(&pool->done_cv);
+  free(pool);
+}
+
+/* ========================================================================== */
+/* Submit / Collect                                                           */
+/* ========================================================================== */
+long long ldpc_pool_submit(ldpc_pool_t *pool, const double *LLR, void *user) {
+  const long long seq = pool->submitted;
+  int idx;
+
+  if (pool->in_order) {
+    idx = (int)((size_t)seq & (pool->depth - 1));
+    if (__atomic_load_n(&pool->slots[idx].state, __ATOMIC_ACQUIRE) !=
+        SLOT_FREE)
+      return -1;
+  } else if (!mpmc_pop(&pool->free_q, &idx)) {
+    return -1;
+  }
+
+  slot_t *s = &pool->slots[idx];
+  memcpy(s->LLR, LLR, pool->graph->N * sizeof(double));
+  s->seq = seq;
+  s->user = user;
+  __atomic_store_n(&s->state, SLOT_QUEUED, __ATOMIC_RELAXED);
+
+  /* never full: each queue has a cell per slot */
+  mpmc_push(&pool->workers[seq % pool->n_workers].queue, idx);
+  __atomic_store_n(&pool->submitted, seq + 1, __ATOMIC_RELEASE);
+  wake(pool, &pool->sleepers, &pool->work_cv);
+  return seq;
+}
+
+int ldpc_pool_poll(ldpc_pool_t *pool, ldpc_pool_result_t *res, int *ecc,
+                   int *inf) {
+  int idx;
+
+  if (pool->in_order) {
+    if (pool->delivered == __atomic_load_n(&pool->submitted, __ATOMIC_ACQUIRE))
+      return 0;
+    idx = (int)((size_t)pool->delivered & (pool->depth - 1));
+    if (__atomic_load_n(&pool->slots[idx].state, __ATOMIC_ACQUIRE) !=
+        SLOT_DONE)
+      return 0;
+  } else if (!mpmc_pop(&pool->done_q, &idx)) {
+    return 0;
+  }
+
+  slot_t *s = &pool->slots[idx];
+  res->seq = s->seq;
+  res->user = s->user;
+  res->status = s->status;
+  if (ecc)
+    memcpy(ecc, s->ecc, pool->graph->N * sizeof(int));
+  if (inf)
+    memcpy(inf, s->inf, pool->graph->K * sizeof(int));
+
+  __atomic_store_n(&s->state, SLOT_FREE, __ATOMIC_RELEASE);
+  if (!pool->in_order)
+    mpmc_push(&pool->free_q, idx);
+  __atomic_store_n(&pool->delivered, pool->delivered + 1, __ATOMIC_RELEASE);
+  return 1;
+}
+
+int ldpc_pool_wait(ldpc_pool_t *pool, ldpc_pool_result_t *res, int *ecc,
+                   int *inf) {
+  for (;;) {
+    if (ldpc_pool_poll(pool, res, ecc, inf))
+      return 1;
+    if (ldpc_pool_pending(pool) == 0)
+      return 0;
+
+    pthread_mutex_lock(&pool->lock);
+    __atomic_fetch_add(&pool->waiters, 1, __ATOMIC_SEQ_CST);
+    int got = ldpc_pool_poll(pool, res, ecc, inf);
+    if (!got)
+      pthread_cond_wait(&pool->done_cv, &pool->lock);
+    __atomic_fetch_sub(&pool->waiters, 1, __ATOMIC_SEQ_CST);
+    pthread_mutex_unlock(&pool->lock);
+    if (got)
+      return 1;
+  }
+}
+
+long long ldpc_pool_pending(const ldpc_pool_t *pool) {
+  return __atomic_load_n(&pool->submitted, __ATOMIC_ACQUIRE) -
+         __atomic_load_n(&pool->delivered, __ATOMIC_ACQUIRE);
+}
+
+unsigned long long ldpc_pool_steals(const ldpc_pool_t *pool) {
+  return __atomic_load_n(&pool->steals, __ATOMIC_RELAXED);
+}
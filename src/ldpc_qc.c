@@ -0,0 +1,774 @@
+/**
+ * @file ldpc_qc.c
+ * @brief QC-LDPC base-matrix handling, structured encoder and Z-block
+ *        layered decoder.
+ *
+ * Circulant access: block (i, j) with shift s connects check i·Z + r to
+ * variable j·Z + (r + s) mod Z. Reading a block "through" its circulant is
+ * therefore a rotation by s, done as two contiguous runs:
+ *
+ *     r in [0, Z−s)  ←  v[s .. Z−1]
+ *     r in [Z−s, Z)  ←  v[0 .. s−1]
+ *
+ * All per-block loops below run over these runs or over plain Z-vectors.
+ */
+
+#include "ldpc_qc.h"
+#include "ldpc_util.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* Helpers                                                                    */
+/* ========================================================================== */
+static int mod_z(int x, int Z) {
+  x %= Z;
+  return (x < 0) ? x + Z : x;
+}
+
+/* dst[r] ^= src[(r + s) mod Z] */
+static void rot_xor(int *dst, const int *src, int s, int Z) {
+  int r;
+  for (r = 0; r < Z - s; r++)
+    dst[r] ^= src[r + s];
+  for (; r < Z; r++)
+    dst[r] ^= src[r + s - Z];
+}
+
+static void reverse_int(int *v, int n) {
+  for (int a = 0, b = n - 1; a < b; a++, b--) {
+    int t = v[a];
+    v[a] = v[b];
+    v[b] = t;
+  }
+}
+
+/* v[r] ← v[(r − y) mod Z] in place (three reversals) */
+static void rotate_right(int *v, int y, int Z) {
+  if (y == 0)
+    return;
+  reverse_int(v, Z);
+  reverse_int(v, y);
+  reverse_int(v + y, Z - y);
+}
+
+/* ========================================================================== */
+/* Code Construction                                                          */
+/* ========================================================================== */
+/* detect the dual-diagonal parity structure required by ldpc_qc_encode() */
+static void qc_detect_structure(ldpc_qc_code_t *qc) {
+  const int mb = qc->mb, nb = qc->nb, Z = qc->Z;
+  int i, j;
+
+  qc->encodable = 0;
+  qc->p0_shift = -1;
+
+  /* columns 1 .. mb-1: identities in rows j-1, j only */
+  for (j = 1; j < mb; j++)
+    for (i = 0; i < mb; i++) {
+      const int s = qc->shift[i * nb + j];
+      const int want = (i == j - 1 || i == j) ? 0 : -1;
+      if (s != want)
+        return;
+    }
+
+  /* column 0: shifts with odd multiplicity must leave exactly one */
+  int *cnt = (int *)calloc(Z, sizeof(int));
+  if (!cnt)
+    return;
+  for (i = 0; i < mb; i++) {
+    const int s = qc->shift[i * nb];
+    if (s >= 0)
+      cnt[s] ^= 1;
+  }
+  int n_odd = 0, y = -1;
+  for (int s = 0; s < Z; s++)
+    if (cnt[s]) {
+      n_odd++;
+      y = s;
+    }
+  free(cnt);
+
+  if (n_odd == 1) {
+    qc->encodable = 1;
+    qc->p0_shift = y;
+  }
+}
+
+ldpc_qc_code_t *ldpc_qc_create(int mb, int nb, int Z, const int *shift) {
+  int i, j;
+
+  if (mb < 1 || nb <= mb || Z < 1 || !shift)
+    return NULL;
+  for (i = 0; i < mb * nb; i++)
+    if (shift[i] < -1 || shift[i] >= Z)
+      return NULL;
+
+  ldpc_qc_code_t *qc = (ldpc_qc_code_t *)calloc(1, sizeof(ldpc_qc_code_t));
+  if (!qc)
+    return NULL;
+
+  qc->mb = mb;
+  qc->nb = nb;
+  qc->Z = Z;
+  qc->M = mb * Z;
+  qc->N = nb * Z;
+  qc->K = qc->N - qc->M;
+
+  qc->shift = (int *)malloc((size_t)mb * nb * sizeof(int));
+  qc->row_ptr = (int *)calloc(mb + 1, sizeof(int));
+  qc->blk_col = (int *)malloc(((size_t)mb * nb) * sizeof(int));
+  qc->blk_shift = (int *)malloc(((size_t)mb * nb) * sizeof(int));
+  if (!qc->shift || !qc->row_ptr || !qc->blk_col || !qc->blk_shift) {
+    ldpc_qc_destroy(qc);
+    return NULL;
+  }
+  memcpy(qc->shift, shift, (size_t)mb * nb * sizeof(int));
+
+  for (i = 0; i < mb; i++) {
+    for (j = 0; j < nb; j++) {
+      const int s = shift[i * nb + j];
+      if (s < 0)
+        continue;
+      qc->blk_col[qc->n_blocks] = j;
+      qc->blk_shift[qc->n_blocks] = s;
+      qc->n_blocks++;
+    }
+    qc->row_ptr[i + 1] = qc->n_blocks;
+    if (qc->row_ptr[i + 1] - qc->row_ptr[i] > qc->max_row_deg)
+      qc->max_row_deg = qc->row_ptr[i + 1] - qc->row_ptr[i];
+  }
+
+  qc_detect_structure(qc);
+  return qc;
+}
+
+void ldpc_qc_destroy(ldpc_qc_code_t *qc) {
+  if (!qc)
+    return;
+
+  free(qc->shift);
+  free(qc->row_ptr);
+  free(qc->blk_col);
+  free(qc->blk_shift);
+  free(qc);
+}
+
+/* number of 4-cycles the entry (a, c) would close with placed entries */
+static int qc_new_cycles4(const int *S, int mb, int nb, int Z, int a, int c) {
+  int n = 0;
+  for (int b = 0; b < mb; b++) {
+    if (b == a || S[b * nb + c] < 0)
+      continue;
+    for (int d = 0; d < nb; d++) {
+      if (d == c || S[a * nb + d] < 0 || S[b * nb + d] < 0)
+        continue;
+      if (mod_z(S[a * nb + c] - S[b * nb + c] + S[b * nb + d] - S[a * nb + d],
+                Z) == 0)
+        n++;
+    }
+  }
+  return n;
+}
+
+ldpc_qc_code_t *ldpc_qc_generate(int mb, int nb, int Z, int wc,
+                                 uint64_t seed) {
+  const int tries = 64; /* shift draws per entry */
+  uint64_t rng = seed;
+  int i, j, k;
+
+  if (mb < 3 || nb <= mb || Z < 2 || wc < 1 || wc > mb)
+    return NULL;
+
+  int *S = (int *)malloc((size_t)mb * nb * sizeof(int));
+  int *row_deg = (int *)calloc(mb, sizeof(int));
+  if (!S || !row_deg) {
+    free(S);
+    free(row_deg);
+    return NULL;
+  }
+  for (i = 0; i < mb * nb; i++)
+    S[i] = -1;
+
+  /* parity part: weight-3 column 0 + dual diagonal */
+  S[0 * nb + 0] = 1;
+  S[(mb / 2) * nb + 0] = 0;
+  S[(mb - 1) * nb + 0] = 1;
+  for (j = 1; j < mb; j++) {
+    S[(j - 1) * nb + j] = 0;
+    S[j * nb + j] = 0;
+  }
+  for (i = 0; i < mb; i++)
+    for (j = 0; j < mb; j++)
+      row_deg[i] += (S[i * nb + j] >= 0);
+
+  /* information columns */
+  for (j = mb; j < nb; j++) {
+    for (k = 0; k < wc; k++) {
+      /* least-loaded free row, random tie-break */
+      int a = -1, n_tie = 0;
+      for (i = 0; i < mb; i++) {
+        if (S[i * nb + j] >= 0)
+          continue;
+        if (a < 0 || row_deg[i] < row_deg[a]) {
+          a = i;
+          n_tie = 1;
+        } else if (row_deg[i] == row_deg[a] &&
+                   ldpc_splitmix64(&rng) % (uint64_t)++n_tie == 0) {
+          a = i;
+        }
+      }
+
+      /* shift closing the fewest 4-cycles (first zero wins) */
+      int best_s = 0, best_n = -1;
+      for (int t = 0; t < tries; t++) {
+        S[a * nb + j] = (int)(ldpc_splitmix64(&rng) % (uint64_t)Z);
+        const int n = qc_new_cycles4(S, mb, nb, Z, a, j);
+        if (best_n < 0 || n < best_n) {
+          best_n = n;
+          best_s = S[a * nb + j];
+        }
+        if (n == 0)
+          break;
+      }
+      S[a * nb + j] = best_s;
+      row_deg[a]++;
+    }
+  }
+
+  ldpc_qc_code_t *qc = ldpc_qc_create(mb, nb, Z, S);
+  free(S);
+  free(row_deg);
+  return qc;
+}
+
+/* ========================================================================== */
+/* Base Matrix I/O                                                            */
+/* ========================================================================== */
+/* next integer, skipping whitespace and '#' comment lines */
+static int read_int(FILE *fp, int *x) {
+  int c;
+  for (;;) {
+    c = fgetc(fp);
+    if (c == '#') {
+      while (c != '\n' && c != EOF)
+        c = fgetc(fp);
+    }
+    if (c == EOF)
+      return -1;
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r' && c != ',')
+      break;
+  }
+  ungetc(c, fp);
+  return (fscanf(fp, "%d", x) == 1) ? 0 : -1;
+}
+
+ldpc_qc_code_t *ldpc_qc_load(const char *path) {
+  FILE *fp = fopen(path, "r");
+  int mb, nb, Z;
+
+  if (!fp)
+    return NULL;
+  if (read_int(fp, &mb) || read_int(fp, &nb) || read_int(fp, &Z) ||
+      mb < 1 || nb <= mb || Z < 1) {
+    fclose(fp);
+    return NULL;
+  }
+
+  int *S = (int *)malloc((size_t)mb * nb * sizeof(int));
+  if (!S) {
+    fclose(fp);
+    return NULL;
+  }
+  for (int i = 0; i < mb * nb; i++)
+    if (read_int(fp, &S[i])) {
+      free(S);
+      fclose(fp);
+      return NULL;
+    }
+  fclose(fp);
+
+  ldpc_qc_code_t *qc = ldpc_qc_create(mb, nb, Z, S);
+  free(S);
+  return qc;
+}
+
+int ldpc_qc_save(const ldpc_qc_code_t *qc, const char *path) {
+  FILE *fp = fopen(path, "w");
+  if (!fp)
+    return -1;
+
+  fprintf(fp, "# QC-LDPC base matrix: mb nb Z, then mb rows of nb "
+              "circulant shifts (-1 = zero block)\n");
+  fprintf(fp, "%d %d %d\n", qc->mb, qc->nb, qc->Z);
+  for (int i = 0; i < qc->mb; i++) {
+    for (int j = 0; j < qc->nb; j++)
+      fprintf(fp, (j + 1 < qc->nb) ? "%d " : "%d\n", qc->shift[i * qc->nb + j]);
+  }
+
+  return (fclose(fp) == 0) ? 0 : -1;
+}
+
+/* ========================================================================== */
+/* Expansion                                                                  */
+/* ========================================================================== */
+void ldpc_qc_expand(const ldpc_qc_code_t *qc, int **H) {
+  const int Z = qc->Z;
+
+  for (int i = 0; i < qc->M; i++)
+    memset(H[i], 0, qc->N * sizeof(int));
+
+  for (int i = 0; i < qc->mb; i++)
+    for (int b = qc->row_ptr[i]; b < qc->row_ptr[i + 1]; b++) {
+      const int j = qc->blk_col[b], s = qc->blk_shift[b];
+      for (int r = 0; r < Z; r++)
+        H[i * Z + r][j * Z + (r + s) % Z] = 1;
+    }
+}
+
+ldpc_graph_t *ldpc_qc_graph(const ldpc_qc_code_t *qc) {
+  const int Z = qc->Z, M = qc->M, N = qc->N;
+  const int E = qc->n_blocks * Z;
+  int i, j, r, b;
+
+  ldpc_graph_t *g = (ldpc_graph_t *)calloc(1, sizeof(ldpc_graph_t));
+  if (!g)
+    return NULL;
+  g->M = M;
+  g->N = N;
+  g->E = E;
+  g->row_ptr = (int *)calloc(M + 1, sizeof(int));
+  g->col_ptr = (int *)calloc(N + 1, sizeof(int));
+  g->col_idx = (int *)malloc(((size_t)E + 1) * sizeof(int));
+  g->row_idx = (int *)malloc(((size_t)E + 1) * sizeof(int));
+  int *fill = (int *)malloc((N + 1) * sizeof(int));
+  if (!g->row_ptr || !g->col_ptr || !g->col_idx || !g->row_idx || !fill) {
+    free(fill);
+    ldpc_graph_destroy(g);
+    return NULL;
+  }
+
+  /* every check of base row i / variable of base column j has the
+   * degree of that base row / column */
+  for (i = 0; i < qc->mb; i++)
+    for (r = 0; r < Z; r++)
+      g->row_ptr[i * Z + r + 1] = qc->row_ptr[i + 1] - qc->row_ptr[i];
+  for (b = 0; b < qc->n_blocks; b++)
+    for (r = 0; r < Z; r++)
+      g->col_ptr[qc->blk_col[b] * Z + r + 1]++;
+  for (i = 0; i < M; i++)
+    g->row_ptr[i + 1] += g->row_ptr[i];
+  for (j = 0; j < N; j++)
+    g->col_ptr[j + 1] += g->col_ptr[j];
+
+  /* CSR: base columns ascending inside a row → variables ascending */
+  memcpy(fill, g->col_ptr, N * sizeof(int));
+  for (i = 0; i < qc->mb; i++)
+    for (r = 0; r < Z; r++) {
+      const int c = i * Z + r;
+      int e = g->row_ptr[c];
+      for (b = qc->row_ptr[i]; b < qc->row_ptr[i + 1]; b++) {
+        const int v = qc->blk_col[b] * Z + (r + qc->blk_shift[b]) % Z;
+        g->col_idx[e++] = v;
+        g->row_idx[fill[v]++] = c; /* checks visited in ascending order */
+      }
+    }
+  free(fill);
+
+  return g;
+}
+
+/* ========================================================================== */
+/* Structured Encoder                                                         */
+/* ========================================================================== */
+int ldpc_qc_encode(const ldpc_qc_code_t *qc, int *ecc, const int *inf) {
+  const int Z = qc->Z, mb = qc->mb, M = qc->M;
+  int i, b;
+
+  if (!qc->encodable)
+    return -1;
+
+  memcpy(ecc + M, inf, qc->K * sizeof(int));
+  memset(ecc, 0, M * sizeof(int));
+
+  /* p0 = P^{-y} Σ_i λ_i (parity blocks of all rows cancel pairwise) */
+  int *p0 = ecc;
+  for (b = 0; b < qc->n_blocks; b++)
+    if (qc->blk_col[b] >= mb)
+      rot_xor(p0, ecc + qc->blk_col[b] * Z, qc->blk_shift[b], Z);
+  rotate_right(p0, qc->p0_shift, Z);
+
+  /* row i: λ_i + P^{s(i,0)} p0 + p_i + p_{i+1} = 0 (no p_i for row 0) */
+  for (i = 0; i < mb - 1; i++) {
+    int *pn = ecc + (i + 1) * Z;
+    for (b = qc->row_ptr[i]; b < qc->row_ptr[i + 1]; b++) {
+      const int j = qc->blk_col[b];
+      if (j >= mb)
+        rot_xor(pn, ecc + j * Z, qc->blk_shift[b], Z);
+      else if (j == 0)
+        rot_xor(pn, p0, qc->blk_shift[b], Z);
+    }
+    if (i > 0)
+      rot_xor(pn, ecc + i * Z, 0, Z);
+  }
+
+  return 0;
+}
+
+/* ========================================================================== */
+/* Z-Block Layered Decoder                                                    */
+/* -------------------------------------------------------------------------- */
+/*
+ * Every Z-vector is processed in chunks of QC_LANES lanes with a
+ * compile-time inner trip count, so the loops vectorise at -O2 (the
+ * decoder workspaces are padded to Zp = QC_LANES · ⌈Z / QC_LANES⌉; padding
+ * lanes are computed but never stored back). Loads and stores through a
+ * circulant cover two contiguous runs of runtime length, handled as whole
+ * chunks plus a short scalar tail.
+ */
+/* ========================================================================== */
+#define QC_LANES 16
+
+/* φ(x) = −log(tanh(x/2)), same clipping as the batch decoder */
+static inline float qc_spf(float x) {
+  if (x < 1e-7f)
+    x = 1e-7f;
+  else if (x > 30.0f)
+    x = 30.0f;
+
+  return -logf(tanhf(0.5f * x));
+}
+
+ldpc_qc_decoder_t *ldpc_qc_decoder_create(const ldpc_qc_code_t *qc) {
+  if (!qc)
+    return NULL;
+
+  ldpc_qc_decoder_t *dec =
+      (ldpc_qc_decoder_t *)calloc(1, sizeof(ldpc_qc_decoder_t));
+  if (!dec)
+    return NULL;
+
+  const int Zp = (qc->Z + QC_LANES - 1) / QC_LANES * QC_LANES;
+  const size_t d = (size_t)(qc->max_row_deg > 0 ? qc->max_row_deg : 1);
+
+  dec->code = qc;
+  dec->Zp = Zp;
+  dec->kernel = LDPC_KERNEL_SPA;
+  dec->alpha = 1.0f;
+  dec->beta = 0.0f;
+  dec->c2v = (float *)calloc((size_t)qc->n_blocks * Zp + 1, sizeof(float));
+  dec->post = (float *)malloc(qc->N * sizeof(float));
+  dec->t = (float *)calloc(d * Zp, sizeof(float)); /* padding stays 0 */
+  dec->f = (float *)malloc(d * Zp * sizeof(float));
+  dec->acc1 = (float *)malloc(Zp * sizeof(float));
+  dec->acc2 = (float *)malloc(Zp * sizeof(float));
+  dec->sgn = (float *)malloc(Zp * sizeof(float));
+  dec->syn = (unsigned char *)malloc(Zp);
+  dec->hard = (unsigned char *)malloc(qc->N);
+  if (!dec->c2v || !dec->post || !dec->t || !dec->f || !dec->acc1 ||
+      !dec->acc2 || !dec->sgn || !dec->syn || !dec->hard) {
+    ldpc_qc_decoder_destroy(dec);
+    return NULL;
+  }
+
+  return dec;
+}
+
+void ldpc_qc_decoder_destroy(ldpc_qc_decoder_t *dec) {
+  if (!dec)
+    return;
+
+  free(dec->c2v);
+  free(dec->post);
+  free(dec->t);
+  free(dec->f);
+  free(dec->acc1);
+  free(dec->acc2);
+  free(dec->sgn);
+  free(dec->syn);
+  free(dec->hard);
+  free(dec);
+}
+
+int ldpc_qc_decoder_set_kernel(ldpc_qc_decoder_t *dec, ldpc_kernel_t kernel,
+                               double param) {
+  switch (kernel) {
+  case LDPC_KERNEL_SPA:
+  case LDPC_KERNEL_MIN_SUM:
+    dec->alpha = 1.0f;
+    dec->beta = 0.0f;
+    break;
+  case LDPC_KERNEL_NMS:
+    if (!(param > 0.0 && param <= 1.0))
+      return -1;
+    dec->alpha = (float)param;
+    dec->beta = 0.0f;
+    break;
+  case LDPC_KERNEL_OMS:
+    if (!(param >= 0.0))
+      return -1;
+    dec->alpha = 1.0f;
+    dec->beta = (float)param;
+    break;
+  default:
+    return -1;
+  }
+
+  dec->kernel = kernel;
+  return 0;
+}
+
+/* ------------------------------------------------------------------------ */
+/* Rotated load / store runs                                                */
+/* ------------------------------------------------------------------------ */
+/* t[r] = p[r] − c[r], r < n */
+static LDPC_ALWAYS_INLINE void run_sub(float *restrict t,
+                                       const float *restrict p,
+                                       const float *restrict c, int n) {
+  for (; n >= QC_LANES; n -= QC_LANES, t += QC_LANES, p += QC_LANES,
+                        c += QC_LANES)
+    for (int l = 0; l < QC_LANES; l++)
+      t[l] = p[l] - c[l];
+  for (int l = 0; l < n; l++)
+    t[l] = p[l] - c[l];
+}
+
+/* p[r] = t[r] + c[r], r < n */
+static LDPC_ALWAYS_INLINE void run_add(float *restrict p,
+                                       const float *restrict t,
+                                       const float *restrict c, int n) {
+  for (; n >= QC_LANES; n -= QC_LANES, p += QC_LANES, t += QC_LANES,
+                        c += QC_LANES)
+    for (int l = 0; l < QC_LANES; l++)
+      p[l] = t[l] + c[l];
+  for (int l = 0; l < n; l++)
+    p[l] = t[l] + c[l];
+}
+
+/* q[r] ^= h[r], r < n */
+static LDPC_ALWAYS_INLINE void run_xor(unsigned char *restrict q,
+                                       const unsigned char *restrict h,
+                                       int n) {
+  for (; n >= QC_LANES; n -= QC_LANES, q += QC_LANES, h += QC_LANES)
+    for (int l = 0; l < QC_LANES; l++)
+      q[l] ^= h[l];
+  for (int l = 0; l < n; l++)
+    q[l] ^= h[l];
+}
+
+/* t[r] = post[(r + s) mod Z] − c2v[r] */
+static void qc_load_block(float *t, const float *post, const float *c2v,
+                          int s, int Z) {
+  run_sub(t, post + s, c2v, Z - s);
+  run_sub(t + Z - s, post, c2v + Z - s, s);
+}
+
+/* post[(r + s) mod Z] = t[r] + c2v[r] */
+static void qc_store_block(float *post, const float *t, const float *c2v,
+                           int s, int Z) {
+  run_add(post + s, t, c2v, Z - s);
+  run_add(post, t + Z - s, c2v + Z - s, s);
+}
+
+/* ------------------------------------------------------------------------ */
+/* Check-node kernels on one layer                                          */
+/* ------------------------------------------------------------------------ */
+/*
+ * Layer update t[k][·] → c2v[k][·] for the d blocks of a base row.
+ *
+ * With bit 1 ↔ LLR > 0, a satisfied check of degree d has sign product
+ * (−1)^d, so the extrinsic sign is (−1)^d · Π_{l≠k} sign(t_l): the sign
+ * accumulator starts at (−1)^d (see check_sign0() in ldpc_decoder.c).
+ * As in the batch decoder, the argmin block is recognised lane-wise by
+ * |t| == min1, so no index array is needed.
+ */
+/* one chunk of QC_LANES lanes per call; restrict lets every loop vectorise */
+static LDPC_ALWAYS_INLINE void lanes_fill(float *restrict x, float v) {
+  for (int l = 0; l < QC_LANES; l++)
+    x[l] = v;
+}
+
+static LDPC_ALWAYS_INLINE void lanes_ms_scan(const float *restrict t,
+                                             float *restrict m1,
+                                             float *restrict m2,
+                                             float *restrict sg) {
+  for (int l = 0; l < QC_LANES; l++) {
+    const float a = fabsf(t[l]);
+    const float hi = (m1[l] > a) ? m1[l] : a;
+    m2[l] = (m2[l] < hi) ? m2[l] : hi;
+    m1[l] = (m1[l] < a) ? m1[l] : a;
+    sg[l] *= (t[l] < 0.0f) ? -1.0f : 1.0f;
+  }
+}
+
+/* magnitudes capped at LDPC_MS_MAX: m2 stays inf on a degree-1 row */
+static LDPC_ALWAYS_INLINE void lanes_ms_mag(float *restrict mag1,
+                                            float *restrict m2,
+                                            const float *restrict m1,
+                                            float alpha, float beta) {
+  const float cap = (float)LDPC_MS_MAX;
+  for (int l = 0; l < QC_LANES; l++) {
+    const float c1 = (m1[l] < cap) ? m1[l] : cap;
+    const float c2 = (m2[l] < cap) ? m2[l] : cap;
+    const float a1 = c1 - beta, a2 = c2 - beta;
+    mag1[l] = alpha * (a1 > 0.0f ? a1 : 0.0f);
+    m2[l] = alpha * (a2 > 0.0f ? a2 : 0.0f);
+  }
+}
+
+static LDPC_ALWAYS_INLINE void lanes_ms_out(float *restrict out,
+                                            const float *restrict t,
+                                            const float *restrict sg,
+                                            const float *restrict m1,
+                                            const float *restrict mag1,
+                                            const float *restrict mag2) {
+  for (int l = 0; l < QC_LANES; l++) {
+    const float x = t[l], a1 = mag1[l], a2 = mag2[l], sx = sg[l];
+    const float mag = (fabsf(x) == m1[l]) ? a2 : a1;
+    out[l] = ((x < 0.0f) ? -sx : sx) * mag;
+  }
+}
+
+static void qc_layer_min_sum(ldpc_qc_decoder_t *dec, int d, float *c2v) {
+  const int Zp = dec->Zp;
+  float *m1 = dec->acc1, *m2 = dec->acc2, *sg = dec->sgn;
+  float *mag1 = dec->f; /* magnitude for every block but the argmin */
+  const float sg0 = (d & 1) ? -1.0f : 1.0f;
+  int k, r;
+
+  for (r = 0; r < Zp; r += QC_LANES) {
+    lanes_fill(m1 + r, HUGE_VALF);
+    lanes_fill(m2 + r, HUGE_VALF);
+    lanes_fill(sg + r, sg0);
+  }
+  for (k = 0; k < d; k++) {
+    const float *t = dec->t + (size_t)k * Zp;
+    for (r = 0; r < Zp; r += QC_LANES)
+      lanes_ms_scan(t + r, m1 + r, m2 + r, sg + r);
+  }
+  for (r = 0; r < Zp; r += QC_LANES)
+    lanes_ms_mag(mag1 + r, m2 + r, m1 + r, dec->alpha, dec->beta);
+  for (k = 0; k < d; k++) {
+    const float *t = dec->t + (size_t)k * Zp;
+    float *out = c2v + (size_t)k * Zp;
+    for (r = 0; r < Zp; r += QC_LANES)
+      lanes_ms_out(out + r, t + r, sg + r, m1 + r, mag1 + r, m2 + r);
+  }
+}
+
+static void qc_layer_spa(ldpc_qc_decoder_t *dec, int d, float *c2v) {
+  const int Zp = dec->Zp;
+  float *restrict sum = dec->acc1;
+  float *restrict sg = dec->sgn;
+  const float sg0 = (d & 1) ? -1.0f : 1.0f;
+  int k, r;
+
+  for (r = 0; r < Zp; r += QC_LANES) {
+    lanes_fill(sum + r, 0.0f);
+    lanes_fill(sg + r, sg0);
+  }
+
+  /* φ is a libm call per value; only the surrounding loops are cheap */
+  for (k = 0; k < d; k++) {
+    const float *restrict t = dec->t + (size_t)k * Zp;
+    float *restrict f = dec->f + (size_t)k * Zp;
+    for (r = 0; r < Zp; r++) {
+      f[r] = qc_spf(fabsf(t[r]));
+      sum[r] += f[r];
+      sg[r] *= (t[r] < 0.0f) ? -1.0f : 1.0f;
+    }
+  }
+
+  for (k = 0; k < d; k++) {
+    const float *restrict t = dec->t + (size_t)k * Zp;
+    const float *restrict f = dec->f + (size_t)k * Zp;
+    float *restrict out = c2v + (size_t)k * Zp;
+    for (r = 0; r < Zp; r++) {
+      const float sx = (t[r] < 0.0f) ? -sg[r] : sg[r];
+      out[r] = sx * qc_spf(sum[r] - f[r]);
+    }
+  }
+}
+
+/* hard decisions and syndrome check; returns 1 when H·c^T = 0 */
+static int qc_syndrome_ok(ldpc_qc_decoder_t *dec) {
+  const ldpc_qc_code_t *qc = dec->code;
+  const int Z = qc->Z, N = qc->N;
+  const float *restrict post = dec->post;
+  unsigned char *restrict hard = dec->hard;
+  unsigned char *restrict q = dec->syn;
+
+  for (int j = 0; j < N; j++)
+    hard[j] = (post[j] >= 0.0f);
+
+  for (int i = 0; i < qc->mb; i++) {
+    memset(q, 0, Z);
+    for (int b = qc->row_ptr[i]; b < qc->row_ptr[i + 1]; b++) {
+      const unsigned char *h = hard + qc->blk_col[b] * Z;
+      const int s = qc->blk_shift[b];
+      run_xor(q, h + s, Z - s);
+      run_xor(q + Z - s, h, s);
+    }
+    for (int r = 0; r < Z; r++)
+      if (q[r])
+        return 0;
+  }
+  return 1;
+}
+
+int ldpc_qc_decode(ldpc_qc_decoder_t *dec, const double *LLR, int *ecc,
+                   int *inf, int max_iter) {
+  const ldpc_qc_code_t *qc = dec->code;
+  const int Z = qc->Z, Zp = dec->Zp;
+  int status = LDPC_DECODE_MAX_ITER;
+  int j;
+
+  for (j = 0; j < qc->N; j++)
+    dec->post[j] = (float)LLR[j];
+  memset(dec->c2v, 0, (size_t)qc->n_blocks * Zp * sizeof(float));
+
+  if (qc_syndrome_ok(dec)) {
+    status = LDPC_DECODE_OK;
+  } else {
+    for (int it = 0; it < max_iter; it++) {
+      for (int i = 0; i < qc->mb; i++) {
+        const int b0 = qc->row_ptr[i];
+        const int d = qc->row_ptr[i + 1] - b0;
+        float *c2v = dec->c2v + (size_t)b0 * Zp;
+        int k;
+
+        /* V→C of this layer: rotated posteriors minus old C→V */
+        for (k = 0; k < d; k++)
+          qc_load_block(dec->t + (size_t)k * Zp,
+                        dec->post + qc->blk_col[b0 + k] * Z,
+                        c2v + (size_t)k * Zp, qc->blk_shift[b0 + k], Z);
+
+        if (dec->kernel == LDPC_KERNEL_SPA)
+          qc_layer_spa(dec, d, c2v);
+        else
+          qc_layer_min_sum(dec, d, c2v);
+
+        /* new posteriors, rotated back */
+        for (k = 0; k < d; k++)
+          qc_store_block(dec->post + qc->blk_col[b0 + k] * Z,
+                         dec->t + (size_t)k * Zp, c2v + (size_t)k * Zp,
+                         qc->blk_shift[b0 + k], Z);
+      }
+
+      if (qc_syndrome_ok(dec)) {
+        status = LDPC_DECODE_OK;
+        break;
+      }
+    }
+  }
+
+  for (j = 0; j < qc->N; j++)
+    ecc[j] = dec->hard[j];
+  for (j = 0; j < qc->K; j++)
+    inf[j] = ecc[qc->M + j];
+
+  return status;
+}
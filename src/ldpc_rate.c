@@ -0,0 +1,143 @@
+/**
+ * @file ldpc_rate.c
+ * @brief Puncturing order and rate-matching gathers / scatters.
+ */
+
+#include "ldpc_rate.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static int gcd(int a, int b) {
+  while (b) {
+    int t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/* ========================================================================== */
+/* Create / Destroy                                                           */
+/* ========================================================================== */
+ldpc_rate_t *ldpc_rate_create(const ldpc_decoder_t *graph) {
+  if (!graph || graph->K < 1 || graph->K > graph->N)
+    return NULL;
+
+  const int N = graph->N, K = graph->K, P = N - K;
+  ldpc_rate_t *r = (ldpc_rate_t *)calloc(1, sizeof(ldpc_rate_t));
+  unsigned char *hit = (unsigned char *)calloc(graph->M + 1, 1);
+  unsigned char *taken = (unsigned char *)calloc(P + 1, 1);
+  if (!r || !hit || !taken || !(r->rank = (int *)malloc(N * sizeof(int)))) {
+    free(hit);
+    free(taken);
+    ldpc_rate_destroy(r);
+    return NULL;
+  }
+  r->N = N;
+  r->K = K;
+  for (int j = 0; j < N; j++)
+    r->rank[j] = N;
+
+  /* spread visiting order: stride ≈ 0.618·P, coprime with P */
+  int stride = (int)(0.618 * P);
+  if (stride < 1)
+    stride = 1;
+  while (P > 1 && gcd(stride, P) != 1)
+    stride--;
+
+  int next = 0;
+  /* pass 1: no check of j has a punctured neighbour yet */
+  for (int t = 0; t < P; t++) {
+    const int j = (int)(((long long)t * stride) % P);
+    int clean = 1;
+    for (int s = graph->col_ptr[j]; s < graph->col_ptr[j + 1]; s++)
+      clean &= !hit[graph->row_idx[s]];
+    if (!clean)
+      continue;
+    for (int s = graph->col_ptr[j]; s < graph->col_ptr[j + 1]; s++)
+      hit[graph->row_idx[s]] = 1;
+    taken[j] = 1;
+    r->rank[j] = next++;
+  }
+  r->n_safe = next;
+
+  /* pass 2: the rest, same order */
+  for (int t = 0; t < P; t++) {
+    const int j = (int)(((long long)t * stride) % P);
+    if (!taken[j])
+      r->rank[j] = next++;
+  }
+
+  free(hit);
+  free(taken);
+  return r;
+}
+
+void ldpc_rate_destroy(ldpc_rate_t *r) {
+  if (!r)
+    return;
+  free(r->rank);
+  free(r);
+}
+
+/* ========================================================================== */
+/* Rate Selection                                                             */
+/* ========================================================================== */
+int ldpc_rate_set(ldpc_rate_t *r, int n_punct, int n_short) {
+  if (n_punct < 0 || n_punct > r->N - r->K || n_short < 0 ||
+      n_short > r->K - 1)
+    return -1;
+  r->n_punct = n_punct;
+  r->n_short = n_short;
+  return 0;
+}
+
+int ldpc_rate_select(ldpc_rate_t *r, int k, int n) {
+  if (k < 1 || k > r->K)
+    return -1;
+  const int S = r->K - k;
+  return ldpc_rate_set(r, (r->N - S) - n, S);
+}
+
+int ldpc_rate_info_length(const ldpc_rate_t *r) { return r->K - r->n_short; }
+
+int ldpc_rate_tx_length(const ldpc_rate_t *r) {
+  return r->N - r->n_punct - r->n_short;
+}
+
+/* ========================================================================== */
+/* Gathers / Scatters                                                         */
+/* ========================================================================== */
+void ldpc_rate_expand_info(const ldpc_rate_t *r, const int *info, int *inf) {
+  const int k = r->K - r->n_short;
+  memcpy(inf, info, k * sizeof(int));
+  memset(inf + k, 0, r->n_short * sizeof(int));
+}
+
+void ldpc_rate_puncture(const ldpc_rate_t *r, const int *code, int *tx) {
+  const int P = r->N - r->K;
+  const int end = r->N - r->n_short; /* shortened tail excluded */
+  int n = 0;
+
+  for (int j = 0; j < P; j++)
+    if (r->rank[j] >= r->n_punct)
+      tx[n++] = code[j];
+  memcpy(tx + n, code + P, (end - P) * sizeof(int));
+}
+
+#define LDPC_RATE_DEFINE_DEPUNCTURE(name, T)                                   \
+  void name(const ldpc_rate_t *r, const T *rx, T *LLR) {                       \
+    const int P = r->N - r->K;                                                 \
+    const int end = r->N - r->n_short;                                         \
+    int n = 0;                                                                 \
+                                                                               \
+    for (int j = 0; j < P; j++)                                                \
+      LLR[j] = (r->rank[j] >= r->n_punct) ? rx[n++] : (T)0;                    \
+    memcpy(LLR + P, rx + n, (end - P) * sizeof(T));                            \
+    for (int j = end; j < r->N; j++)                                           \
+      LLR[j] = (T)(-LDPC_RATE_LLR_KNOWN);                                      \
+  }
+
+LDPC_RATE_DEFINE_DEPUNCTURE(ldpc_rate_depuncture, double)
+LDPC_RATE_DEFINE_DEPUNCTURE(ldpc_rate_depuncture_float, float)
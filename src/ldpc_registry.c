@@ -0,0 +1,393 @@
+/**
+ * @file ldpc_registry.c
+ * @brief Code registry: ID formatting / parsing, in-memory hash table,
+ *        on-disk code.bin cache and build-on-miss.
+ *
+ * Lookups, disk loads and builds all run under one registry lock: a
+ * build is a one-time cost per code and process, later lookups are a hash
+ * probe. Built and converted code files are written to a temporary name
+ * unique to the process and renamed, so concurrent processes sharing a
+ * matrices directory never map a partial file or write into each other's
+ * temporary.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* mkdir(), getpid() under -std=c99 */
+
+#include "ldpc_registry.h"
+
+#include <inttypes.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+#include "ldpc_matrix.h"
+#include "ldpc_peg.h"
+#include "ldpc_qc.h"
+#include "ldpc_util.h"
+
+#define REGISTRY_BUCKETS 64
+
+typedef struct registry_entry {
+  ldpc_code_t code;
+  ldpc_codefile_t *cf; /* owned mapping behind code.cf */
+  struct registry_entry *next;
+} registry_entry_t;
+
+struct ldpc_registry {
+  char root[256];
+  int build;
+  pthread_mutex_t lock;
+  registry_entry_t *bucket[REGISTRY_BUCKETS];
+};
+
+static void make_dir(const char *d) {
+#ifdef _WIN32
+  _mkdir(d);
+#else
+  mkdir(d, 0755);
+#endif
+}
+
+static int file_exists(const char *path) {
+  FILE *fp = fopen(path, "rb");
+  if (fp)
+    fclose(fp);
+  return fp != NULL;
+}
+
+/* "<path>.<pid>.<n>.tmp": same directory (so rename() is atomic), unique
+ * per process and per call within it */
+static int temp_path(char *buf, size_t size, const char *path) {
+  static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+  static unsigned serial = 0;
+
+  pthread_mutex_lock(&lock);
+  const unsigned n = serial++;
+  pthread_mutex_unlock(&lock);
+  const int len =
+      snprintf(buf, size, "%s.%ld.%u.tmp", path, (long)getpid(), n);
+  return (len > 0 && (size_t)len < size) ? 0 : -1;
+}
+
+/*
+ * Move a finished temporary into place. Where rename() does not replace
+ * an existing file (Windows), a concurrent writer that got there first
+ * counts as success: both files hold the same code.
+ */
+static int commit_temp(const char *tmp, const char *path) {
+  if (rename(tmp, path) == 0)
+    return 0;
+  remove(tmp);
+  return file_exists(path) ? 0 : -1;
+}
+
+/* ============================================================================
+ *  Keys and IDs
+ * ============================================================================
+ */
+/* QC: the lifting gene_hg --qc accepts (ldpc_qc_generate() base shape) */
+static int qc_key_valid(const ldpc_code_key_t *k) {
+  const int M = (k->N * k->wc) / k->wr;
+  return k->Z >= 2 && k->N % k->Z == 0 && M % k->Z == 0 && M / k->Z >= 3 &&
+         k->wc <= M / k->Z;
+}
+
+static int key_valid(const ldpc_code_key_t *k) {
+  if (!k || k->N <= 0 || k->wc <= 0 || k->wr <= k->wc ||
+      (long long)k->N * k->wc / k->wr <= 0)
+    return 0;
+  switch (k->construction) {
+  case LDPC_CONSTRUCT_GALLAGER:
+  case LDPC_CONSTRUCT_PEG:
+  case LDPC_CONSTRUCT_PEG_ACE:
+    return k->Z == 0;
+  case LDPC_CONSTRUCT_QC:
+    return qc_key_valid(k);
+  default:
+    return 0;
+  }
+}
+
+static int key_equal(const ldpc_code_key_t *a, const ldpc_code_key_t *b) {
+  return a->N == b->N && a->wc == b->wc && a->wr == b->wr &&
+         a->seed == b->seed && a->construction == b->construction &&
+         a->Z == b->Z;
+}
+
+static unsigned key_hash(const ldpc_code_key_t *k) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  const uint64_t v[6] = {(uint64_t)k->N, (uint64_t)k->wc, (uint64_t)k->wr,
+                         k->seed, (uint64_t)k->construction, (uint64_t)k->Z};
+  for (int i = 0; i < 6; i++)
+    h = (h ^ v[i]) * 0x100000001b3ULL;
+  return (unsigned)((h ^ (h >> 32)) % REGISTRY_BUCKETS);
+}
+
+int ldpc_code_id(const ldpc_code_key_t *key, char *buf, int size) {
+  if (!key_valid(key) || !buf || size <= 0)
+    return -1;
+
+  int n = snprintf(buf, size, "N%d_wc%d_wr%d", key->N, key->wc, key->wr);
+  if (n > 0 && n < size && key->seed)
+    n += snprintf(buf + n, size - n, "_s%" PRIu64, key->seed);
+  if (n > 0 && n < size && key->construction == LDPC_CONSTRUCT_PEG)
+    n += snprintf(buf + n, size - n, "_peg");
+  if (n > 0 && n < size && key->construction == LDPC_CONSTRUCT_PEG_ACE)
+    n += snprintf(buf + n, size - n, "_ace");
+  if (n > 0 && n < size && key->construction == LDPC_CONSTRUCT_QC)
+    n += snprintf(buf + n, size - n, "_qc%d", key->Z);
+  return (n > 0 && n < size) ? 0 : -1;
+}
+
+int ldpc_code_parse_id(const char *id, ldpc_code_key_t *key) {
+  if (!id || !key)
+    return -1;
+
+  /* accept "matrices/<ID>" and a trailing '/' */
+  char name[128];
+  size_t len = strlen(id);
+  while (len > 0 && id[len - 1] == '/')
+    len--;
+  size_t start = len;
+  while (start > 0 && id[start - 1] != '/')
+    start--;
+  if (len - start >= sizeof(name))
+    return -1;
+  memcpy(name, id + start, len - start);
+  name[len - start] = '\0';
+
+  memset(key, 0, sizeof(*key));
+  int used = 0;
+  if (sscanf(name, "N%d_wc%d_wr%d%n", &key->N, &key->wc, &key->wr, &used) !=
+      3)
+    return -1;
+
+  const char *p = name + used;
+  if (!strncmp(p, "_s", 2) && p[2] >= '0' && p[2] <= '9') {
+    char *end;
+    key->seed = strtoull(p + 2, &end, 10);
+    p = end;
+  }
+  if (!strcmp(p, "_peg")) {
+    key->construction = LDPC_CONSTRUCT_PEG;
+    p += 4;
+  } else if (!strcmp(p, "_ace")) {
+    key->construction = LDPC_CONSTRUCT_PEG_ACE;
+    p += 4;
+  } else if (!strncmp(p, "_qc", 3) && p[3] >= '1' && p[3] <= '9') {
+    char *end;
+    key->construction = LDPC_CONSTRUCT_QC;
+    key->Z = (int)strtol(p + 3, &end, 10);
+    p = end;
+  }
+  return (*p == '\0' && key_valid(key)) ? 0 : -1;
+}
+
+/* ============================================================================
+ *  Build on miss
+ * ============================================================================
+ */
+/* write the QC base matrix of candidate rng next to code.bin */
+static int registry_build_qc(const ldpc_code_key_t *k, int M, int **H,
+                             uint64_t rng, const char *dir) {
+  ldpc_qc_code_t *qc =
+      ldpc_qc_generate(M / k->Z, k->N / k->Z, k->Z, k->wc, rng);
+  if (!qc)
+    return -1;
+  ldpc_qc_expand(qc, H);
+
+  char path_base[560], tmp[640];
+  int rc = -1;
+  snprintf(path_base, sizeof(path_base), "%s/base.txt", dir);
+  if (temp_path(tmp, sizeof(tmp), path_base) == 0) {
+    if (ldpc_qc_save(qc, tmp) == 0)
+      rc = commit_temp(tmp, path_base);
+    else
+      remove(tmp);
+  }
+  ldpc_qc_destroy(qc);
+  return rc;
+}
+
+/* candidate 0 of gene_hg --seed S, written to path_bin; 0 on success */
+static int registry_build(const ldpc_code_key_t *k, const char *dir,
+                          const char *path_bin) {
+  const int N = k->N, M = (N * k->wc) / k->wr, K = N - M;
+
+  if (k->construction == LDPC_CONSTRUCT_GALLAGER && N % k->wr)
+    return -1; /* Gallager blocks need wr | N */
+
+  int **H = ldpc_alloc_matrix_int(M, N);
+  int **G = ldpc_alloc_matrix_int(K, N);
+  int rc = -1;
+  if (!H || !G)
+    goto done;
+
+  uint64_t rng = ldpc_candidate_seed(k->seed, 0);
+  if (k->construction == LDPC_CONSTRUCT_PEG ||
+      k->construction == LDPC_CONSTRUCT_PEG_ACE) {
+    if (generate_Hmatrix_peg(H, N, k->wc, k->wr, NULL,
+                             k->construction == LDPC_CONSTRUCT_PEG_ACE, rng))
+      goto done;
+  } else if (k->construction == LDPC_CONSTRUCT_QC) {
+    if (registry_build_qc(k, M, H, rng, dir))
+      goto done;
+  } else {
+    generate_Hmatrix_seeded(H, N, k->wc, k->wr, &rng);
+  }
+  generate_Gmatrix(H, G, N, k->wc, k->wr); /* may permute H's columns */
+
+  char tmp[640];
+  if (temp_path(tmp, sizeof(tmp), path_bin))
+    goto done;
+  if (ldpc_codefile_write(tmp, H, G, M, N, k->wc, k->wr) == 0)
+    rc = commit_temp(tmp, path_bin);
+  else
+    remove(tmp);
+
+done:
+  ldpc_free_matrix_int(H, M);
+  ldpc_free_matrix_int(G, K);
+  return rc;
+}
+
+/* memory miss: disk, CSV conversion, then build */
+static ldpc_codefile_t *registry_load(ldpc_registry_t *reg,
+                                      const ldpc_code_key_t *k,
+                                      const char *id) {
+  char dir[512], path_bin[560], path_H[560], path_G[560];
+  snprintf(dir, sizeof(dir), "%s/%s", reg->root, id);
+  snprintf(path_bin, sizeof(path_bin), "%s/code.bin", dir);
+  snprintf(path_H, sizeof(path_H), "%s/H.csv", dir);
+  snprintf(path_G, sizeof(path_G), "%s/G.csv", dir);
+
+  const int M = (k->N * k->wc) / k->wr;
+
+  if (!file_exists(path_bin)) {
+    if (file_exists(path_H)) {
+      char tmp[640];
+      if (temp_path(tmp, sizeof(tmp), path_bin))
+        return NULL;
+      if (ldpc_codefile_from_csv(tmp, path_H, path_G, M, k->N, k->wc,
+                                 k->wr)) {
+        remove(tmp);
+        return NULL;
+      }
+      if (commit_temp(tmp, path_bin))
+        return NULL;
+    } else {
+      if (!reg->build)
+        return NULL;
+      make_dir(reg->root);
+      make_dir(dir);
+      if (registry_build(k, dir, path_bin))
+        return NULL;
+    }
+  }
+
+  ldpc_codefile_t *cf = ldpc_codefile_open(path_bin);
+  if (cf && (cf->N != k->N || cf->M != M)) {
+    ldpc_codefile_close(cf);
+    return NULL;
+  }
+  return cf;
+}
+
+/* ============================================================================
+ *  Registry
+ * ============================================================================
+ */
+ldpc_registry_t *ldpc_registry_create(const char *root, int build) {
+  if (!root || strlen(root) >= sizeof(((ldpc_registry_t *)0)->root))
+    return NULL;
+
+  ldpc_registry_t *reg = (ldpc_registry_t *)calloc(1, sizeof(ldpc_registry_t));
+  if (!reg)
+    return NULL;
+
+  strcpy(reg->root, root);
+  reg->build = build;
+  pthread_mutex_init(&reg->lock, NULL);
+  return reg;
+}
+
+void ldpc_registry_destroy(ldpc_registry_t *reg) {
+  if (!reg)
+    return;
+
+  for (int b = 0; b < REGISTRY_BUCKETS; b++) {
+    registry_entry_t *e = reg->bucket[b];
+    while (e) {
+      registry_entry_t *next = e->next;
+      ldpc_codefile_close(e->cf);
+      free(e);
+      e = next;
+    }
+  }
+  pthread_mutex_destroy(&reg->lock);
+  free(reg);
+}
+
+const ldpc_code_t *ldpc_registry_get(ldpc_registry_t *reg,
+                                     const ldpc_code_key_t *key) {
+  char id[64];
+  if (!reg || ldpc_code_id(key, id, sizeof(id)))
+    return NULL;
+
+  const unsigned b = key_hash(key);
+  const ldpc_code_t *found = NULL;
+
+  pthread_mutex_lock(&reg->lock);
+  for (registry_entry_t *e = reg->bucket[b]; e; e = e->next)
+    if (key_equal(&e->code.key, key)) {
+      found = &e->code;
+      break;
+    }
+
+  if (!found) {
+    registry_entry_t *e = (registry_entry_t *)calloc(1, sizeof(*e));
+    ldpc_codefile_t *cf = e ? registry_load(reg, key, id) : NULL;
+    if (cf) {
+      e->cf = cf;
+      e->code.key = *key;
+      strcpy(e->code.id, id);
+      e->code.N = cf->N;
+      e->code.M = cf->M;
+      e->code.K = cf->K;
+      e->code.cf = cf;
+      e->next = reg->bucket[b];
+      reg->bucket[b] = e;
+      found = &e->code;
+    } else {
+      free(e);
+    }
+  }
+  pthread_mutex_unlock(&reg->lock);
+  return found;
+}
+
+const ldpc_code_t *ldpc_registry_get_id(ldpc_registry_t *reg, const char *id) {
+  ldpc_code_key_t key;
+  if (ldpc_code_parse_id(id, &key))
+    return NULL;
+  return ldpc_registry_get(reg, &key);
+}
+
+ldpc_decoder_t *ldpc_code_decoder(const ldpc_code_t *code) {
+  return code ? ldpc_codefile_decoder(code->cf) : NULL;
+}
+
+ldpc_packed_encoder_t *ldpc_code_encoder(const ldpc_code_t *code) {
+  return code ? ldpc_codefile_encoder(code->cf) : NULL;
+}
@@ -0,0 +1,394 @@
+/**
+ * @file ldpc_sparse_encoder.c
+ * @brief Richardson–Urbanke style encoder: greedy approximate lower
+ *        triangulation of H_p plus a small dense gap system.
+ *
+ * Preprocessing
+ *   1) CSR copy of H and, for the parity columns 0..M-1, a CSC view.
+ *   2) Greedy triangulation. cnt[i] is the number of unresolved parity
+ *      bits in row i. Rows reaching cnt = 1 are queued; popping one makes
+ *      its last unresolved bit a pivot. With an empty queue, a bit of a
+ *      minimum-cnt row is declared a gap variable instead. Resolving a bit
+ *      decrements cnt of every row it touches.
+ *   3) Rows never used as pivot are the residual checks. Back-substituting
+ *      with u = 0 and gap = e_k gives column k of Φ (r × g); Gaussian
+ *      elimination of [Φ | I_r] yields row operations T and pivot columns
+ *      with T·Φ in reduced row echelon form.
+ *
+ * Encoding
+ *   back-substitute (gap = 0) → residual syndrome s → x = RREF solve of s
+ *   → back-substitute (gap = x).
+ */
+
+#include "ldpc_sparse_encoder.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* Helpers                                                                    */
+/* ========================================================================== */
+static inline int parity64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+  return __builtin_parityll(x);
+#else
+  x ^= x >> 32;
+  x ^= x >> 16;
+  x ^= x >> 8;
+  x ^= x >> 4;
+  x ^= x >> 2;
+  x ^= x >> 1;
+  return (int)(x & 1);
+#endif
+}
+
+/**
+ * @brief Solve the pivot bits in schedule order from the already set
+ *        information and gap bits of ecc.
+ */
+static void back_substitute(const ldpc_sparse_encoder_t *enc, int *ecc) {
+  for (int k = 0; k < enc->n_piv; k++) {
+    const int i = enc->piv_row[k];
+    const int c = enc->piv_col[k];
+    int v = 0;
+    for (int e = enc->row_ptr[i]; e < enc->row_ptr[i + 1]; e++)
+      v ^= ecc[enc->col_idx[e]];
+    /* ecc[c] is still 0 here: the XOR above covers the other bits only */
+    ecc[c] = v;
+  }
+}
+
+/* residual syndrome of ecc, packed into enc->syn */
+static void residual_syndrome(const ldpc_sparse_encoder_t *enc,
+                              const int *ecc, uint64_t *syn) {
+  memset(syn, 0, (size_t)enc->res_words * sizeof(uint64_t));
+  for (int r = 0; r < enc->n_res; r++) {
+    const int i = enc->res_row[r];
+    int v = 0;
+    for (int e = enc->row_ptr[i]; e < enc->row_ptr[i + 1]; e++)
+      v ^= ecc[enc->col_idx[e]];
+    syn[r / 64] |= (uint64_t)v << (r % 64);
+  }
+}
+
+/* clear all parity positions, set gap bits from x */
+static void reset_parity(const ldpc_sparse_encoder_t *enc, int *ecc,
+                         const int *x) {
+  memset(ecc, 0, (size_t)enc->M * sizeof(int));
+  if (x)
+    for (int k = 0; k < enc->n_gap; k++)
+      ecc[enc->gap_col[k]] = x[k];
+}
+
+/* ========================================================================== */
+/* Greedy Approximate Lower Triangulation                                     */
+/* ========================================================================== */
+static int triangulate(ldpc_sparse_encoder_t *enc) {
+  const int M = enc->M;
+  int *pc_ptr = (int *)calloc(M + 1, sizeof(int)); /* CSC of H_p */
+  int *pc_row = (int *)malloc(((size_t)enc->row_ptr[M] + 1) * sizeof(int));
+  int *cnt = (int *)calloc(M + 1, sizeof(int));
+  int *queue = (int *)malloc((M + 1) * sizeof(int));
+  unsigned char *resolved = (unsigned char *)calloc(M + 1, 1);
+  unsigned char *used = (unsigned char *)calloc(M + 1, 1);
+  int rc = -1;
+  int i, j, e;
+
+  if (!pc_ptr || !pc_row || !cnt || !queue || !resolved || !used)
+    goto done;
+
+  for (i = 0; i < M; i++)
+    for (e = enc->row_ptr[i]; e < enc->row_ptr[i + 1]; e++)
+      if (enc->col_idx[e] < M) {
+        pc_ptr[enc->col_idx[e] + 1]++;
+        cnt[i]++;
+      }
+  for (j = 0; j < M; j++)
+    pc_ptr[j + 1] += pc_ptr[j];
+  {
+    int *fill = queue; /* reuse as fill pointers before the queue starts */
+    for (j = 0; j < M; j++)
+      fill[j] = pc_ptr[j];
+    for (i = 0; i < M; i++)
+      for (e = enc->row_ptr[i]; e < enc->row_ptr[i + 1]; e++)
+        if (enc->col_idx[e] < M)
+          pc_row[fill[enc->col_idx[e]]++] = i;
+  }
+
+  int head = 0, tail = 0;
+  for (i = 0; i < M; i++)
+    if (cnt[i] == 1)
+      queue[tail++] = i;
+
+  int n_resolved = 0;
+  while (n_resolved < M) {
+    int col = -1;
+
+    /* next row with a single unresolved parity bit → pivot */
+    while (head < tail && col < 0) {
+      i = queue[head++];
+      if (used[i] || cnt[i] != 1)
+        continue;
+      for (e = enc->row_ptr[i]; e < enc->row_ptr[i + 1]; e++)
+        if (enc->col_idx[e] < M && !resolved[enc->col_idx[e]]) {
+          col = enc->col_idx[e];
+          break;
+        }
+      used[i] = 1;
+      enc->piv_row[enc->n_piv] = i;
+      enc->piv_col[enc->n_piv] = col;
+      enc->n_piv++;
+    }
+
+    /* none → declare a bit of a minimum-weight open row a gap variable */
+    if (col < 0) {
+      int best = -1;
+      for (i = 0; i < M; i++)
+        if (!used[i] && cnt[i] >= 2 && (best < 0 || cnt[i] < cnt[best]))
+          best = i;
+      if (best >= 0) {
+        for (e = enc->row_ptr[best]; e < enc->row_ptr[best + 1]; e++)
+          if (enc->col_idx[e] < M && !resolved[enc->col_idx[e]]) {
+            col = enc->col_idx[e];
+            break;
+          }
+      } else {
+        /* bits in no open row at all (all-zero or fully covered column) */
+        for (j = 0; j < M; j++)
+          if (!resolved[j]) {
+            col = j;
+            break;
+          }
+      }
+      enc->gap_col[enc->n_gap++] = col;
+    }
+
+    resolved[col] = 1;
+    n_resolved++;
+    for (int s = pc_ptr[col]; s < pc_ptr[col + 1]; s++) {
+      i = pc_row[s];
+      /* cnt only decreases, so every row is queued at most once */
+      if (--cnt[i] == 1 && !used[i])
+        queue[tail++] = i;
+    }
+  }
+
+  for (i = 0; i < M; i++)
+    if (!used[i])
+      enc->res_row[enc->n_res++] = i;
+  rc = 0;
+
+done:
+  free(pc_ptr);
+  free(pc_row);
+  free(cnt);
+  free(queue);
+  free(resolved);
+  free(used);
+  return rc;
+}
+
+/* ========================================================================== */
+/* Dense Gap System                                                           */
+/* ========================================================================== */
+/**
+ * @brief Build T and the pivot columns of Φ by elimination of [Φ | I_r].
+ *
+ * Row r of the augmented matrix is packed as g Φ-bits followed by r
+ * identity bits.
+ */
+static int build_gap_solver(ldpc_sparse_encoder_t *enc) {
+  const int g = enc->n_gap;
+  const int r = enc->n_res;
+  const int gw = (g + 63) / 64;
+  const int rw = enc->res_words;
+  const int aw = gw + rw;
+  int rc = -1;
+
+  uint64_t *A = (uint64_t *)calloc((size_t)r * aw + 1, sizeof(uint64_t));
+  int *ecc = (int *)calloc(enc->N, sizeof(int));
+  uint64_t *col = (uint64_t *)malloc(((size_t)rw + 1) * sizeof(uint64_t));
+  if (!A || !ecc || !col)
+    goto done;
+
+  /* Φ column k: residual syndrome of the pivot solution for gap = e_k */
+  for (int k = 0; k < g; k++) {
+    memset(ecc, 0, (size_t)enc->N * sizeof(int));
+    ecc[enc->gap_col[k]] = 1;
+    back_substitute(enc, ecc);
+    residual_syndrome(enc, ecc, col);
+    for (int i = 0; i < r; i++)
+      if ((col[i / 64] >> (i % 64)) & 1)
+        A[(size_t)i * aw + k / 64] |= 1ULL << (k % 64);
+  }
+  for (int i = 0; i < r; i++)
+    A[(size_t)i * aw + gw + i / 64] |= 1ULL << (i % 64);
+
+  /* Gauss–Jordan over the Φ columns */
+  int rank = 0;
+  for (int k = 0; k < g && rank < r; k++) {
+    const int w = k / 64;
+    const uint64_t bit = 1ULL << (k % 64);
+    int p = -1;
+    for (int i = rank; i < r; i++)
+      if (A[(size_t)i * aw + w] & bit) {
+        p = i;
+        break;
+      }
+    if (p < 0)
+      continue;
+
+    if (p != rank)
+      for (int t = 0; t < aw; t++) {
+        uint64_t tmp = A[(size_t)p * aw + t];
+        A[(size_t)p * aw + t] = A[(size_t)rank * aw + t];
+        A[(size_t)rank * aw + t] = tmp;
+      }
+
+    const uint64_t *prow = A + (size_t)rank * aw;
+    for (int i = 0; i < r; i++)
+      if (i != rank && (A[(size_t)i * aw + w] & bit))
+        for (int t = 0; t < aw; t++)
+          A[(size_t)i * aw + t] ^= prow[t];
+
+    enc->solve_col[rank++] = k;
+  }
+  enc->rank = rank;
+
+  /* keep T (right block); rows ≥ rank are the consistency checks */
+  for (int i = 0; i < r; i++)
+    memcpy(enc->solve + (size_t)i * rw, A + (size_t)i * aw + gw,
+           (size_t)rw * sizeof(uint64_t));
+  rc = 0;
+
+done:
+  free(A);
+  free(ecc);
+  free(col);
+  return rc;
+}
+
+/* ========================================================================== */
+/* Create / Destroy                                                           */
+/* ========================================================================== */
+ldpc_sparse_encoder_t *ldpc_sparse_encoder_create(int **H, int M, int N,
+                                                  int K) {
+  int i, j;
+
+  if (!H || M <= 0 || K <= 0 || N != M + K)
+    return NULL;
+
+  ldpc_sparse_encoder_t *enc =
+      (ldpc_sparse_encoder_t *)calloc(1, sizeof(ldpc_sparse_encoder_t));
+  if (!enc)
+    return NULL;
+
+  enc->M = M;
+  enc->N = N;
+  enc->K = K;
+
+  enc->row_ptr = (int *)calloc(M + 1, sizeof(int));
+  if (!enc->row_ptr)
+    goto fail;
+  for (i = 0; i < M; i++)
+    for (j = 0; j < N; j++)
+      if (H[i][j])
+        enc->row_ptr[i + 1]++;
+  for (i = 0; i < M; i++)
+    enc->row_ptr[i + 1] += enc->row_ptr[i];
+
+  enc->col_idx = (int *)malloc(((size_t)enc->row_ptr[M] + 1) * sizeof(int));
+  enc->piv_row = (int *)malloc((M + 1) * sizeof(int));
+  enc->piv_col = (int *)malloc((M + 1) * sizeof(int));
+  enc->gap_col = (int *)malloc((M + 1) * sizeof(int));
+  enc->res_row = (int *)malloc((M + 1) * sizeof(int));
+  if (!enc->col_idx || !enc->piv_row || !enc->piv_col || !enc->gap_col ||
+      !enc->res_row)
+    goto fail;
+  for (i = 0; i < M; i++) {
+    int e = enc->row_ptr[i];
+    for (j = 0; j < N; j++)
+      if (H[i][j])
+        enc->col_idx[e++] = j;
+  }
+
+  if (triangulate(enc))
+    goto fail;
+
+  enc->res_words = (enc->n_res + 63) / 64;
+  enc->solve = (uint64_t *)calloc((size_t)enc->n_res * enc->res_words + 1,
+                                  sizeof(uint64_t));
+  enc->solve_col = (int *)malloc(((size_t)enc->n_gap + 1) * sizeof(int));
+  enc->syn = (uint64_t *)calloc((size_t)enc->res_words + 1, sizeof(uint64_t));
+  enc->x = (int *)calloc((size_t)enc->n_gap + 1, sizeof(int));
+  if (!enc->solve || !enc->solve_col || !enc->syn || !enc->x)
+    goto fail;
+
+  if (build_gap_solver(enc))
+    goto fail;
+
+  return enc;
+
+fail:
+  ldpc_sparse_encoder_destroy(enc);
+  return NULL;
+}
+
+void ldpc_sparse_encoder_destroy(ldpc_sparse_encoder_t *enc) {
+  if (!enc)
+    return;
+
+  free(enc->row_ptr);
+  free(enc->col_idx);
+  free(enc->piv_row);
+  free(enc->piv_col);
+  free(enc->gap_col);
+  free(enc->res_row);
+  free(enc->solve);
+  free(enc->solve_col);
+  free(enc->syn);
+  free(enc->x);
+  free(enc);
+}
+
+/* ========================================================================== */
+/* Encode                                                                     */
+/* ========================================================================== */
+int ldpc_sparse_encode(ldpc_sparse_encoder_t *enc, int *ecc, const int *inf) {
+  const int M = enc->M;
+  const int rw = enc->res_words;
+  int i, k;
+
+  memcpy(ecc + M, inf, (size_t)enc->K * sizeof(int));
+
+  /* 1) pivots with gap = 0 */
+  reset_parity(enc, ecc, NULL);
+  back_substitute(enc, ecc);
+  if (enc->n_res == 0)
+    return 0;
+  residual_syndrome(enc, ecc, enc->syn);
+
+  /* 2) x = RREF solve of Φ·x = s; rows beyond the rank must vanish */
+  for (i = enc->rank; i < enc->n_res; i++) {
+    uint64_t acc = 0;
+    for (k = 0; k < rw; k++)
+      acc ^= enc->solve[(size_t)i * rw + k] & enc->syn[k];
+    if (parity64(acc))
+      return -1;
+  }
+  if (enc->n_gap == 0)
+    return 0;
+
+  memset(enc->x, 0, (size_t)enc->n_gap * sizeof(int));
+  for (i = 0; i < enc->rank; i++) {
+    uint64_t acc = 0;
+    for (k = 0; k < rw; k++)
+      acc ^= enc->solve[(size_t)i * rw + k] & enc->syn[k];
+    enc->x[enc->solve_col[i]] = parity64(acc);
+  }
+
+  /* 3) pivots again with the solved gap bits */
+  reset_parity(enc, ecc, enc->x);
+  back_substitute(enc, ecc);
+  return 0;
+}
@@ -0,0 +1,182 @@
+/**
+ * @file ldpc_stats.c
+ * @brief Tick counter and aggregation of per-frame decoder statistics.
+ */
+
+#define _POSIX_C_SOURCE 200809L /* clock_gettime() under -std=c99 */
+
+#include "ldpc_stats.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
+/* ========================================================================== */
+/* Ticks                                                                      */
+/* ========================================================================== */
+static unsigned long long clock_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL +
+         (unsigned long long)ts.tv_nsec;
+}
+
+unsigned long long ldpc_ticks(void) {
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+  return (unsigned long long)__rdtsc();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+  unsigned long long v;
+  __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(v));
+  return v;
+#else
+  return clock_ns();
+#endif
+}
+
+static double ticks_per_sec;
+static pthread_once_t ticks_once = PTHREAD_ONCE_INIT;
+
+/* ~20 ms against the monotonic clock */
+static void ticks_calibrate(void) {
+  const unsigned long long n0 = clock_ns();
+  const unsigned long long t0 = ldpc_ticks();
+  unsigned long long n1;
+  do {
+    n1 = clock_ns();
+  } while (n1 - n0 < 20000000ULL);
+  const unsigned long long t1 = ldpc_ticks();
+  ticks_per_sec = (double)(t1 - t0) * 1e9 / (double)(n1 - n0);
+  if (ticks_per_sec <= 0.0)
+    ticks_per_sec = 1e9;
+}
+
+double ldpc_ticks_per_sec(void) {
+  pthread_once(&ticks_once, ticks_calibrate);
+  return ticks_per_sec;
+}
+
+/* ========================================================================== */
+/* Create / Destroy                                                           */
+/* ========================================================================== */
+ldpc_stats_t *ldpc_stats_create(int max_iter) {
+  if (max_iter < 0)
+    return NULL;
+
+  ldpc_stats_t *st = (ldpc_stats_t *)calloc(1, sizeof(ldpc_stats_t));
+  if (!st)
+    return NULL;
+  st->max_iter = max_iter;
+  st->iter_hist = (unsigned long long *)calloc(max_iter + 1,
+                                               sizeof(unsigned long long));
+  st->unsat_sum = (unsigned long long *)calloc(max_iter + 1,
+                                               sizeof(unsigned long long));
+  if (!st->iter_hist || !st->unsat_sum) {
+    ldpc_stats_destroy(st);
+    return NULL;
+  }
+  return st;
+}
+
+void ldpc_stats_destroy(ldpc_stats_t *st) {
+  if (!st)
+    return;
+  free(st->iter_hist);
+  free(st->unsat_sum);
+  free(st);
+}
+
+void ldpc_stats_reset(ldpc_stats_t *st) {
+  const size_t bins = (size_t)st->max_iter + 1;
+  st->frames = st->converged = st->stalled = st->iter_sum = 0;
+  st->traj_frames = 0;
+  st->ticks_check = st->ticks_var = st->ticks_syn = 0;
+  memset(st->iter_hist, 0, bins * sizeof(unsigned long long));
+  memset(st->unsat_sum, 0, bins * sizeof(unsigned long long));
+}
+
+/* ========================================================================== */
+/* Accumulation                                                               */
+/* ========================================================================== */
+void ldpc_stats_add(ldpc_stats_t *st, const ldpc_frame_stats_t *fs) {
+  int it = fs->iterations < 0 ? 0 : fs->iterations;
+  if (it > st->max_iter)
+    it = st->max_iter;
+
+  st->frames++;
+  st->converged += (fs->converged != 0);
+  st->stalled += (fs->status == LDPC_DECODE_STALLED);
+  st->iter_sum += (unsigned long long)it;
+  st->iter_hist[it]++;
+  st->ticks_check += fs->ticks_check;
+  st->ticks_var += fs->ticks_var;
+  st->ticks_syn += fs->ticks_syn;
+
+  /* trajectory: entries 0..it, then the final value held up to max_iter */
+  if (fs->unsat && fs->unsat_len >= it + 1) {
+    int t;
+    for (t = 0; t <= it; t++)
+      st->unsat_sum[t] += (unsigned long long)fs->unsat[t];
+    for (; t <= st->max_iter; t++)
+      st->unsat_sum[t] += (unsigned long long)fs->unsat[it];
+    st->traj_frames++;
+  }
+}
+
+int ldpc_stats_merge(ldpc_stats_t *dst, const ldpc_stats_t *src) {
+  if (dst->max_iter != src->max_iter)
+    return -1;
+
+  dst->frames += src->frames;
+  dst->converged += src->converged;
+  dst->stalled += src->stalled;
+  dst->iter_sum += src->iter_sum;
+  dst->traj_frames += src->traj_frames;
+  dst->ticks_check += src->ticks_check;
+  dst->ticks_var += src->ticks_var;
+  dst->ticks_syn += src->ticks_syn;
+  for (int t = 0; t <= dst->max_iter; t++) {
+    dst->iter_hist[t] += src->iter_hist[t];
+    dst->unsat_sum[t] += src->unsat_sum[t];
+  }
+  return 0;
+}
+
+/* ========================================================================== */
+/* Summaries                                                                  */
+/* ========================================================================== */
+double ldpc_stats_mean_iterations(const ldpc_stats_t *st) {
+  return st->frames ? (double)st->iter_sum / (double)st->frames : 0.0;
+}
+
+int ldpc_stats_iteration_quantile(const ldpc_stats_t *st, double q) {
+  if (!st->frames)
+    return 0;
+  const double need = q * (double)st->frames;
+  unsigned long long acc = 0;
+  for (int t = 0; t <= st->max_iter; t++) {
+    acc += st->iter_hist[t];
+    if ((double)acc >= need && acc > 0)
+      return t;
+  }
+  return st->max_iter;
+}
+
+double ldpc_stats_mean_unsat(const ldpc_stats_t *st, int t) {
+  if (!st->traj_frames || t < 0 || t > st->max_iter)
+    return 0.0;
+  return (double)st->unsat_sum[t] / (double)st->traj_frames;
+}
+
+void ldpc_stats_phase_ns(const ldpc_stats_t *st, double *check_ns,
+                         double *var_ns, double *syn_ns) {
+  const double scale =
+      st->frames ? 1e9 / (ldpc_ticks_per_sec() * (double)st->frames) : 0.0;
+  *check_ns = (double)st->ticks_check * scale;
+  *var_ns = (double)st->ticks_var * scale;
+  *syn_ns = (double)st->ticks_syn * scale;
+}
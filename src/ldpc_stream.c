@@ -0,0 +1,420 @@
+/**
+ * @file ldpc_stream.c
+ * @brief Streaming encode / decode over ring buffers.
+ *
+ * Transmitter: input bytes wait in a ring until a frame can be encoded.
+ * Their bits are shifted straight into the packed information words of
+ * the frame being assembled (a byte may straddle two frames). A completed
+ * frame is encoded with ldpc_encode_packed(), and its modulated samples
+ * are appended to the sample ring.
+ *
+ * Receiver: LLRs are copied frame-major into `batch` frame slots, which
+ * is the layout ldpc_batch_decode_float() expects. A full batch is decoded
+ * in one call, and its information bits are packed into the byte ring.
+ */
+
+#include "ldpc_stream.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ========================================================================== */
+/* Byte Ring Buffer                                                           */
+/* ========================================================================== */
+typedef struct {
+  unsigned char *buf;
+  size_t cap;  /* bytes             */
+  size_t head; /* read position     */
+  size_t len;  /* bytes stored      */
+} ring_t;
+
+static int ring_init(ring_t *r, size_t cap) {
+  r->buf = (unsigned char *)malloc(cap);
+  r->cap = cap;
+  r->head = r->len = 0;
+  return r->buf ? 0 : -1;
+}
+
+static size_t ring_space(const ring_t *r) { return r->cap - r->len; }
+
+/* append up to n bytes; returns bytes written */
+static size_t ring_write(ring_t *r, const void *src, size_t n) {
+  const unsigned char *s = (const unsigned char *)src;
+  if (n > ring_space(r))
+    n = ring_space(r);
+
+  size_t tail = (r->head + r->len) % r->cap;
+  size_t first = (n < r->cap - tail) ? n : r->cap - tail;
+  memcpy(r->buf + tail, s, first);
+  memcpy(r->buf, s + first, n - first);
+  r->len += n;
+  return n;
+}
+
+/* remove up to n bytes into dst; returns bytes read */
+static size_t ring_read(ring_t *r, void *dst, size_t n) {
+  unsigned char *d = (unsigned char *)dst;
+  if (n > r->len)
+    n = r->len;
+
+  size_t first = (n < r->cap - r->head) ? n : r->cap - r->head;
+  memcpy(d, r->buf + r->head, first);
+  memcpy(d + first, r->buf, n - first);
+  r->head = (r->head + n) % r->cap;
+  r->len -= n;
+  return n;
+}
+
+static int ring_get(ring_t *r) {
+  int c = r->buf[r->head];
+  r->head = (r->head + 1) % r->cap;
+  r->len--;
+  return c;
+}
+
+/* ========================================================================== */
+/* Transmitter                                                                */
+/* ========================================================================== */
+struct ldpc_stream_tx {
+  const ldpc_packed_encoder_t *enc;
+  const ldpc_demapper_t *mod; /* NULL: BPSK, one float per bit */
+  int N, K;
+  size_t frame_floats; /* samples per frame                    */
+
+  ring_t in;  /* input bytes                                      */
+  ring_t out; /* output samples (floats, stored as bytes)         */
+
+  uint64_t *inf;  /* [LDPC_WORDS(K)] frame being assembled       */
+  int fill;       /* information bits in inf                     */
+  unsigned carry; /* unconsumed bits of the last input byte      */
+  int carry_n;
+  uint64_t *ecc;  /* [LDPC_WORDS(N)] encoded frame               */
+  float *samples; /* [frame_floats] modulated frame              */
+
+  ldpc_stream_stats_t stats;
+};
+
+ldpc_stream_tx_t *ldpc_stream_tx_create(const ldpc_packed_encoder_t *enc,
+                                        const ldpc_demapper_t *mod,
+                                        int depth) {
+  if (!enc || depth < 1 || (mod && enc->N % mod->bits))
+    return NULL;
+
+  ldpc_stream_tx_t *tx = (ldpc_stream_tx_t *)calloc(1, sizeof(*tx));
+  if (!tx)
+    return NULL;
+
+  tx->enc = enc;
+  tx->mod = mod;
+  tx->N = enc->N;
+  tx->K = enc->K;
+  tx->frame_floats = mod ? (size_t)2 * (enc->N / mod->bits) : (size_t)enc->N;
+
+  tx->inf = (uint64_t *)calloc(LDPC_WORDS(tx->K), sizeof(uint64_t));
+  tx->ecc = (uint64_t *)calloc(LDPC_WORDS(tx->N), sizeof(uint64_t));
+  tx->samples = (float *)malloc(tx->frame_floats * sizeof(float));
+  int rc_in = ring_init(&tx->in, (size_t)depth * ((tx->K + 7) / 8) + 1);
+  int rc_out = ring_init(&tx->out, (size_t)depth * tx->frame_floats *
+                                       sizeof(float));
+  if (!tx->inf || !tx->ecc || !tx->samples || rc_in || rc_out) {
+    ldpc_stream_tx_destroy(tx);
+    return NULL;
+  }
+  return tx;
+}
+
+void ldpc_stream_tx_destroy(ldpc_stream_tx_t *tx) {
+  if (!tx)
+    return;
+  free(tx->in.buf);
+  free(tx->out.buf);
+  free(tx->inf);
+  free(tx->ecc);
+  free(tx->samples);
+  free(tx);
+}
+
+/* encode and modulate the assembled frame into the sample ring */
+static void tx_emit(ldpc_stream_tx_t *tx) {
+  const uint64_t *c = tx->ecc;
+  float *out = tx->samples;
+
+  ldpc_encode_packed(tx->enc, tx->ecc, tx->inf);
+
+  if (!tx->mod) {
+    for (int j = 0; j < tx->N; j++)
+      out[j] = ((c[j >> 6] >> (j & 63)) & 1) ? 1.0f : -1.0f;
+  } else {
+    /* symbol label: bits s·m .. s·m + m − 1, first bit most significant */
+    const int m = tx->mod->bits;
+    const float *pts = tx->mod->points;
+    for (int s = 0, j = 0; s < tx->N / m; s++) {
+      int v = 0;
+      for (int k = 0; k < m; k++, j++)
+        v = (v << 1) | (int)((c[j >> 6] >> (j & 63)) & 1);
+      out[2 * s] = pts[2 * v];
+      out[2 * s + 1] = pts[2 * v + 1];
+    }
+  }
+  ring_write(&tx->out, out, tx->frame_floats * sizeof(float));
+
+  memset(tx->inf, 0, LDPC_WORDS(tx->K) * sizeof(uint64_t));
+  tx->fill = 0;
+  tx->stats.frames++;
+}
+
+/* assemble and emit frames while input bits and sample space last */
+static void tx_process(ldpc_stream_tx_t *tx) {
+  const size_t frame_bytes = tx->frame_floats * sizeof(float);
+
+  while (ring_space(&tx->out) >= frame_bytes) {
+    while (tx->fill < tx->K) {
+      if (tx->carry_n == 0) {
+        if (tx->in.len == 0)
+          return;
+        tx->carry = (unsigned)ring_get(&tx->in);
+        tx->carry_n = 8;
+      }
+      const int take =
+          (tx->carry_n < tx->K - tx->fill) ? tx->carry_n : tx->K - tx->fill;
+      const uint64_t v = tx->carry & ((1u << take) - 1);
+      const int w = tx->fill >> 6, b = tx->fill & 63;
+      tx->inf[w] |= v << b;
+      if (b + take > 64)
+        tx->inf[w + 1] |= v >> (64 - b);
+      tx->carry >>= take;
+      tx->carry_n -= take;
+      tx->fill += take;
+    }
+    tx_emit(tx);
+  }
+}
+
+size_t ldpc_stream_tx_push(ldpc_stream_tx_t *tx, const void *data, size_t n) {
+  const unsigned char *p = (const unsigned char *)data;
+  size_t taken = 0;
+
+  /* alternate filling and draining so a large push streams through */
+  for (;;) {
+    taken += ring_write(&tx->in, p + taken, n - taken);
+    tx_process(tx);
+    if (taken == n || ring_space(&tx->in) == 0)
+      break;
+  }
+  tx->stats.bytes += taken;
+  return taken;
+}
+
+size_t ldpc_stream_tx_pull(ldpc_stream_tx_t *tx, float *samples, size_t n) {
+  size_t got = ring_read(&tx->out, samples, n * sizeof(float)) / sizeof(float);
+  tx_process(tx); /* space freed: encode frames still waiting */
+  return got;
+}
+
+int ldpc_stream_tx_flush(ldpc_stream_tx_t *tx) {
+  tx_process(tx);
+  if (tx->in.len || tx->carry_n)
+    return -1; /* stopped on a full sample ring */
+  if (tx->fill == 0)
+    return 0;
+  if (ring_space(&tx->out) < tx->frame_floats * sizeof(float))
+    return -1;
+
+  const int pad = tx->K - tx->fill;
+  tx_emit(tx);
+  return pad;
+}
+
+ldpc_stream_stats_t ldpc_stream_tx_stats(const ldpc_stream_tx_t *tx) {
+  return tx->stats;
+}
+
+/* ========================================================================== */
+/* Receiver                                                                   */
+/* ========================================================================== */
+struct ldpc_stream_rx {
+  ldpc_batch_t *dec;
+  ldpc_gpu_t *gpu; /* borrowed; replaces dec when set */
+  int N, K, batch, max_iter;
+
+  float *frames; /* [batch][N] LLR slots                  */
+  int slot;      /* complete frames in the slots          */
+  int fill;      /* LLRs in the current slot              */
+
+  int *ecc, *inf, *status; /* batch decoder outputs        */
+  unsigned char *bytes;    /* packed bits of one batch     */
+  unsigned acc;            /* output bits not yet a byte   */
+  int acc_n;
+  ring_t out; /* decoded bytes */
+
+  ldpc_stream_stats_t stats;
+};
+
+/* slot and output buffers for `batch` frames; dec / gpu set by the caller */
+static ldpc_stream_rx_t *rx_alloc(const ldpc_decoder_t *graph, int batch,
+                                  int depth, int max_iter) {
+  ldpc_stream_rx_t *rx = (ldpc_stream_rx_t *)calloc(1, sizeof(*rx));
+  if (!rx)
+    return NULL;
+
+  rx->N = graph->N;
+  rx->K = graph->K;
+  rx->batch = batch;
+  rx->max_iter = max_iter;
+
+  const size_t batch_bytes = ((size_t)batch * rx->K + 7) / 8 + 1;
+  rx->frames = (float *)malloc((size_t)batch * rx->N * sizeof(float));
+  rx->ecc = (int *)malloc((size_t)batch * rx->N * sizeof(int));
+  rx->inf = (int *)malloc((size_t)batch * rx->K * sizeof(int));
+  rx->status = (int *)malloc((size_t)batch * sizeof(int));
+  rx->bytes = (unsigned char *)malloc(batch_bytes);
+  int rc = ring_init(&rx->out, (size_t)depth * batch_bytes);
+  if (!rx->frames || !rx->ecc || !rx->inf || !rx->status || !rx->bytes ||
+      rc) {
+    ldpc_stream_rx_destroy(rx);
+    return NULL;
+  }
+  return rx;
+}
+
+ldpc_stream_rx_t *ldpc_stream_rx_create(const ldpc_decoder_t *graph,
+                                        int batch, int depth, int max_iter) {
+  if (!graph || depth < 1 || max_iter < 1)
+    return NULL;
+
+  ldpc_batch_t *dec = ldpc_batch_create(graph, batch);
+  if (!dec)
+    return NULL;
+
+  ldpc_stream_rx_t *rx = rx_alloc(graph, batch, depth, max_iter);
+  if (!rx) {
+    ldpc_batch_destroy(dec);
+    return NULL;
+  }
+  rx->dec = dec;
+  return rx;
+}
+
+ldpc_stream_rx_t *ldpc_stream_rx_create_gpu(const ldpc_decoder_t *graph,
+                                            ldpc_gpu_t *gpu, int depth,
+                                            int max_iter) {
+  if (!graph || !gpu || depth < 1 || max_iter < 1)
+    return NULL;
+
+  ldpc_stream_rx_t *rx =
+      rx_alloc(graph, ldpc_gpu_max_frames(gpu), depth, max_iter);
+  if (rx)
+    rx->gpu = gpu;
+  return rx;
+}
+
+void ldpc_stream_rx_destroy(ldpc_stream_rx_t *rx) {
+  if (!rx)
+    return;
+  ldpc_batch_destroy(rx->dec);
+  free(rx->frames);
+  free(rx->ecc);
+  free(rx->inf);
+  free(rx->status);
+  free(rx->bytes);
+  free(rx->out.buf);
+  free(rx);
+}
+
+ldpc_batch_t *ldpc_stream_rx_batch(ldpc_stream_rx_t *rx) { return rx->dec; }
+
+/* decode the first nframes slots; -1 if their bytes would not fit */
+static int rx_decode(ldpc_stream_rx_t *rx, int nframes) {
+  const size_t nbytes = ((size_t)nframes * rx->K + rx->acc_n) / 8;
+  if (ring_space(&rx->out) < nbytes)
+    return -1;
+
+  if (!rx->gpu) {
+    ldpc_batch_decode_float(rx->dec, rx->frames, nframes, rx->ecc, rx->inf,
+                            rx->status, rx->max_iter);
+  } else if (ldpc_gpu_decode(rx->gpu, rx->frames, nframes, NULL, rx->inf,
+                             rx->status, rx->max_iter) < 0) {
+    /* device failure: channel hard decision of the information bits */
+    for (int f = 0; f < nframes; f++) {
+      const float *L = rx->frames + (size_t)f * rx->N + (rx->N - rx->K);
+      for (int j = 0; j < rx->K; j++)
+        rx->inf[(size_t)f * rx->K + j] = (L[j] >= 0.0f);
+      rx->status[f] = LDPC_DECODE_MAX_ITER;
+    }
+  }
+
+  size_t nb = 0;
+  const int *bit = rx->inf;
+  for (size_t i = 0; i < (size_t)nframes * rx->K; i++) {
+    rx->acc |= (unsigned)(bit[i] & 1) << rx->acc_n;
+    if (++rx->acc_n == 8) {
+      rx->bytes[nb++] = (unsigned char)rx->acc;
+      rx->acc = 0;
+      rx->acc_n = 0;
+    }
+  }
+  ring_write(&rx->out, rx->bytes, nb);
+
+  for (int f = 0; f < nframes; f++)
+    rx->stats.failed += (rx->status[f] != LDPC_DECODE_OK);
+  rx->stats.frames += (unsigned long long)nframes;
+  rx->stats.bytes += nb;
+  rx->slot = 0;
+  return nframes;
+}
+
+size_t ldpc_stream_rx_push(ldpc_stream_rx_t *rx, const float *LLR, size_t n) {
+  size_t taken = 0;
+
+  while (taken < n) {
+    if (rx->slot == rx->batch && rx_decode(rx, rx->batch) < 0)
+      break; /* byte ring full */
+
+    size_t take = (size_t)(rx->N - rx->fill);
+    if (take > n - taken)
+      take = n - taken;
+    memcpy(rx->frames + (size_t)rx->slot * rx->N + rx->fill, LLR + taken,
+           take * sizeof(float));
+    rx->fill += (int)take;
+    taken += take;
+    if (rx->fill == rx->N) {
+      rx->slot++;
+      rx->fill = 0;
+    }
+  }
+  if (rx->slot == rx->batch)
+    rx_decode(rx, rx->batch);
+  return taken;
+}
+
+size_t ldpc_stream_rx_pull(ldpc_stream_rx_t *rx, void *data, size_t n) {
+  size_t got = ring_read(&rx->out, data, n);
+  if (rx->slot == rx->batch)
+    rx_decode(rx, rx->batch); /* space freed: decode a waiting batch */
+  return got;
+}
+
+int ldpc_stream_rx_flush(ldpc_stream_rx_t *rx) {
+  int nframes = rx->slot;
+  const size_t tail = (((size_t)nframes * rx->K + rx->acc_n) % 8) != 0;
+  if (ring_space(&rx->out) <
+      ((size_t)nframes * rx->K + rx->acc_n) / 8 + tail)
+    return -1;
+
+  if (nframes > 0)
+    rx_decode(rx, nframes);
+  if (rx->acc_n > 0) {
+    unsigned char last = (unsigned char)rx->acc;
+    ring_write(&rx->out, &last, 1);
+    rx->stats.bytes++;
+    rx->acc = 0;
+    rx->acc_n = 0;
+  }
+  rx->fill = 0;
+  return nframes;
+}
+
+ldpc_stream_stats_t ldpc_stream_rx_stats(const ldpc_stream_rx_t *rx) {
+  return rx->stats;
+}
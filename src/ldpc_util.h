@@ -0,0 +1,63 @@
+/**
+ * @file ldpc_util.h
+ * @brief Internal helpers shared by the library sources (not installed,
+ *        not part of the API): the SplitMix64 step, the forced-inline
+ *        qualifier and dense int matrix allocation.
+ */
+
+#ifndef LDPC_UTIL_H
+#define LDPC_UTIL_H
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define LDPC_ALWAYS_INLINE inline __attribute__((always_inline))
+#else
+#define LDPC_ALWAYS_INLINE inline
+#endif
+
+/**
+ * @brief SplitMix64: advance *s by the golden-ratio increment and return
+ *        the mixed value. Tie-break / construction RNG of PEG, QC and the
+ *        seeded Gallager fill, and the seeder of xoshiro256**.
+ */
+static inline uint64_t ldpc_splitmix64(uint64_t *s) {
+  uint64_t z = (*s += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/**
+ * @brief Zeroed rows × cols int matrix (array of row pointers), or NULL
+ *        on allocation failure. Release with ldpc_free_matrix_int().
+ */
+static inline int **ldpc_alloc_matrix_int(int rows, int cols) {
+  int **m = (int **)calloc(rows, sizeof(int *));
+  if (!m)
+    return NULL;
+  for (int i = 0; i < rows; i++) {
+    m[i] = (int *)calloc(cols, sizeof(int));
+    if (!m[i]) {
+      while (i--)
+        free(m[i]);
+      free(m);
+      return NULL;
+    }
+  }
+  return m;
+}
+
+/**
+ * @brief Release a matrix of ldpc_alloc_matrix_int(). NULL is a no-op.
+ */
+static inline void ldpc_free_matrix_int(int **m, int rows) {
+  if (!m)
+    return;
+  for (int i = 0; i < rows; i++)
+    free(m[i]);
+  free(m);
+}
+
+#endif /* LDPC_UTIL_H */
@@ -0,0 +1,172 @@
+/**
+ * @file test_rate_match.c
+ * @brief Rate matching identity: de-rate-matching the transmitted bits
+ *        of a frame gives back its codeword.
+ *
+ * For a seeded Gallager (96, 48) mother code and a range of (P, S) and
+ * k / n selections, a codeword is encoded from ldpc_rate_expand_info(),
+ * punctured to tx_length bits, mapped to LLRs (bit 1 ↔ LLR > 0) and
+ * depunctured. The N decoder LLRs must be 0 at exactly P parity bits
+ * (the P lowest puncturing ranks), −LDPC_RATE_LLR_KNOWN at the S
+ * shortened bits and ±1 with the codeword's sign everywhere else, in
+ * double and float; puncturing the hard decisions again gives back tx.
+ *
+ * Usage: test_rate_match   (exit status 0 on success)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ldpc_decoder.h"
+#include "ldpc_encoder.h"
+#include "ldpc_matrix.h"
+#include "ldpc_rate.h"
+
+#define N 96
+#define WC 3
+#define WR 6
+#define M (N * WC / WR)
+#define K (N - M)
+
+static int failures = 0;
+
+static void report(const char *name, int ok) {
+  printf("%-28s %s\n", name, ok ? "ok" : "FAIL");
+  failures += !ok;
+}
+
+static int **alloc_matrix(int rows, int cols) {
+  int **m = (int **)malloc(rows * sizeof(int *));
+  for (int i = 0; m && i < rows; i++)
+    m[i] = (int *)calloc(cols, sizeof(int));
+  return m;
+}
+
+static void free_matrix(int **m, int rows) {
+  for (int i = 0; m && i < rows; i++)
+    free(m[i]);
+  free(m);
+}
+
+/* encode, rate-match and de-rate-match one frame at the current rate */
+static int check_rate(const ldpc_rate_t *r, int **G, uint64_t *rng) {
+  const int P = r->n_punct, S = r->n_short;
+  const int k = ldpc_rate_info_length(r), n = ldpc_rate_tx_length(r);
+  int info[K], inf[K], code[N], tx[N], rx_hard[N], tx2[N];
+  double rx[N], LLR[N];
+  float rx_f[N], LLR_f[N];
+  int ok = (k == K - S) && (n == N - P - S);
+
+  for (int i = 0; i < k; i++) {
+    *rng = *rng * 6364136223846793005ULL + 1442695040888963407ULL;
+    info[i] = (int)(*rng >> 63);
+  }
+  ldpc_rate_expand_info(r, info, inf);
+  for (int i = 0; i < K; i++)
+    ok &= inf[i] == (i < k ? info[i] : 0);
+  ldpc_encode(code, inf, G, N, K);
+
+  ldpc_rate_puncture(r, code, tx);
+  for (int i = 0; i < n; i++) {
+    rx[i] = tx[i] ? +1.0 : -1.0;
+    rx_f[i] = (float)rx[i];
+  }
+  ldpc_rate_depuncture(r, rx, LLR);
+  ldpc_rate_depuncture_float(r, rx_f, LLR_f);
+
+  int n_punct = 0;
+  for (int j = 0; j < N; j++) {
+    const int punct = j < N - K && r->rank[j] < P;
+    const int shortened = j >= N - S;
+    n_punct += punct;
+    if (punct)
+      ok &= LLR[j] == 0.0;
+    else if (shortened)
+      ok &= LLR[j] == -LDPC_RATE_LLR_KNOWN && code[j] == 0;
+    else
+      ok &= LLR[j] == (code[j] ? +1.0 : -1.0);
+    ok &= LLR_f[j] == (float)LLR[j];
+    rx_hard[j] = LLR[j] > 0.0;
+  }
+  ok &= n_punct == P;
+
+  /* punctured and shortened positions carry no sign: take the codeword's */
+  for (int j = 0; j < N; j++)
+    if (LLR[j] == 0.0)
+      rx_hard[j] = code[j];
+  ldpc_rate_puncture(r, rx_hard, tx2);
+  for (int i = 0; i < n; i++)
+    ok &= tx2[i] == tx[i];
+  return ok;
+}
+
+int main(void) {
+  int **H = alloc_matrix(M, N);
+  int **G = alloc_matrix(K, N);
+  if (!H || !G) {
+    fprintf(stderr, "allocation failed\n");
+    return 1;
+  }
+
+  uint64_t rng = ldpc_candidate_seed(3, 0);
+  generate_Hmatrix_seeded(H, N, WC, WR, &rng);
+  generate_Gmatrix(H, G, N, WC, WR);
+
+  ldpc_decoder_t *dec = ldpc_decoder_create(H, M, N, K);
+  ldpc_rate_t *r = dec ? ldpc_rate_create(dec) : NULL;
+  if (!r) {
+    fprintf(stderr, "ldpc_rate_create failed\n");
+    return 1;
+  }
+
+  /* the puncturing ranks are a permutation of the parity bits */
+  int seen[N - K] = {0}, perm = 1;
+  for (int j = 0; j < N - K; j++) {
+    perm &= r->rank[j] >= 0 && r->rank[j] < N - K && !seen[r->rank[j]];
+    if (perm)
+      seen[r->rank[j]] = 1;
+  }
+  for (int j = N - K; j < N; j++)
+    perm &= r->rank[j] == N;
+  report("puncturing ranks", perm);
+
+  /* (P, S) at the edges of their ranges and in between */
+  const int ps[][2] = {{0, 0},      {1, 0},         {0, 1},
+                       {12, 8},     {M, 0},         {0, K - 1},
+                       {M, K - 1},  {r->n_safe, 0}, {r->n_safe + 1, 5}};
+  for (size_t t = 0; t < sizeof(ps) / sizeof(ps[0]); t++) {
+    char name[64];
+    snprintf(name, sizeof(name), "P %d, S %d", ps[t][0], ps[t][1]);
+    report(name, ldpc_rate_set(r, ps[t][0], ps[t][1]) == 0 &&
+                     check_rate(r, G, &rng));
+  }
+
+  /* k / n selections, including the mother rate and k = 1 */
+  const int kn[][2] = {{K, N}, {K, K + 1}, {40, 60}, {1, 1}, {1, M + 1}};
+  for (size_t t = 0; t < sizeof(kn) / sizeof(kn[0]); t++) {
+    char name[64];
+    snprintf(name, sizeof(name), "k %d, n %d", kn[t][0], kn[t][1]);
+    report(name, ldpc_rate_select(r, kn[t][0], kn[t][1]) == 0 &&
+                     ldpc_rate_info_length(r) == kn[t][0] &&
+                     ldpc_rate_tx_length(r) == kn[t][1] &&
+                     check_rate(r, G, &rng));
+  }
+
+  /* out-of-range selections are refused */
+  report("invalid rates",
+         ldpc_rate_set(r, M + 1, 0) && ldpc_rate_set(r, 0, K) &&
+             ldpc_rate_select(r, 0, 10) && ldpc_rate_select(r, 10, 9) &&
+             ldpc_rate_select(r, 10, M + 11));
+
+  ldpc_rate_destroy(r);
+  ldpc_decoder_destroy(dec);
+  free_matrix(H, M);
+  free_matrix(G, K);
+
+  if (failures) {
+    printf("%d check(s) failed\n", failures);
+    return 1;
+  }
+  printf("all checks passed\n");
+  return 0;
+}